@@ -0,0 +1,269 @@
+/**
+ *	OverRated Benchmark: update hot paths
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	This benchmark is released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Times UpdatedObjectList::addTime() over lists of every size from 1 to 10M values (in powers
+ *	of ten) for each combination of:
+ *
+ *		storage   UpdatedValueBasic or UpdatedValueRef
+ *		method    UpdateMethodLinear or UpdateMethodLooped
+ *		type      float or double
+ *		target    a value or a direction
+ *		finished  the fraction of values which are already at their target (value targets only)
+ *
+ *	Results are written as JSON, one object per run, with the time per value per tick and the
+ *	number of values updated per second. Usage:
+ *
+ *		overrated_bench [--min-size N] [--max-size N] [--work N] [--out FILE]
+ *
+ *	--work is roughly how many value updates to time for each run (default 20M); small lists
+ *	are ticked more often than large ones to make it up. --help prints the usage and exits.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include <OverRated.h>
+
+using namespace OverRated;
+
+static const double TICK = 1.0 / 60.0;
+static const unsigned MAX_TICKS = 10000;
+
+// Rates are low enough that no value reaches its target within MAX_TICKS
+static const double RATE = 0.01;
+
+enum MethodKind { MK_LINEAR, MK_LOOPED };
+enum TargetKind { TK_VALUE, TK_DIRECTION };
+
+struct Run
+{
+	const char * storage;
+	const char * method;
+	const char * type;
+	const char * target;
+	double finished;
+	unsigned size;
+	unsigned ticks;
+	unsigned active;
+	double seconds;
+};
+
+// Makes the method for a run. The looped range is 0 to 360, with the target in the middle.
+template <typename T>
+static UpdateMethod<T> * makeMethod( MethodKind method, TargetKind target )
+{
+	if( method == MK_LINEAR ) {
+		if( target == TK_VALUE )
+			return new UpdateMethodLinear<T>(T(RATE), T(1.0e6));
+		return new UpdateMethodLinear<T>(T(RATE), CD_INCREASING);
+	}
+
+	if( target == TK_VALUE )
+		return new UpdateMethodLooped<T>(T(RATE), T(180), T(0), T(360));
+	return new UpdateMethodLooped<T>(T(RATE), CD_INCREASING, T(0), T(360));
+}
+
+// Where value i starts: at the target for the finished fraction, well away from it otherwise
+template <typename T>
+static T startValue( unsigned i, unsigned finishedCount, MethodKind method )
+{
+	if( i < finishedCount )
+		return (method == MK_LINEAR) ? T(1.0e6) : T(180);
+
+	return T(i % 97);
+}
+
+template <typename T>
+struct StorageBasic
+{
+	static const char * name() { return "basic"; }
+
+	std::vector< UpdatedValueBasic<T> > values;
+
+	void build( unsigned size, unsigned finishedCount, MethodKind method )
+	{
+		values.reserve(size);
+
+		for( unsigned i = 0; i < size; i++ )
+			values.push_back(UpdatedValueBasic<T>(startValue<T>(i, finishedCount, method)));
+	}
+
+	UpdatedValue<T> * get( unsigned i ) { return &values[i]; }
+};
+
+template <typename T>
+struct StorageRef
+{
+	static const char * name() { return "ref"; }
+
+	std::vector<T> vars;
+	std::vector< UpdatedValueRef<T> > values;
+
+	void build( unsigned size, unsigned finishedCount, MethodKind method )
+	{
+		vars.resize(size);
+		values.reserve(size);
+
+		for( unsigned i = 0; i < size; i++ ) {
+			vars[i] = startValue<T>(i, finishedCount, method);
+			values.push_back(UpdatedValueRef<T>(vars[i]));
+		}
+	}
+
+	UpdatedValue<T> * get( unsigned i ) { return &values[i]; }
+};
+
+template <typename T> struct TypeName;
+template <> struct TypeName<float> { static const char * get() { return "float"; } };
+template <> struct TypeName<double> { static const char * get() { return "double"; } };
+
+template <typename T, template <typename> class Storage>
+static Run runOne( MethodKind methodKind, TargetKind targetKind, double finished,
+		unsigned size, unsigned long long work )
+{
+	Run run;
+	unsigned finished_count = unsigned(finished * size);
+	unsigned long long ticks = work / size;
+	UpdateMethod<T> * method = makeMethod<T>(methodKind, targetKind);
+	Storage<T> storage;
+	UpdatedObjectList< UpdatedValue<T> > list;
+
+	if( ticks < 3 )
+		ticks = 3;
+	if( ticks > MAX_TICKS )
+		ticks = MAX_TICKS;
+
+	storage.build(size, finished_count, methodKind);
+
+	for( unsigned i = 0; i < size; i++ ) {
+		storage.get(i)->setMethod(method);
+		list.add(storage.get(i));
+	}
+
+	// One untimed tick settles the finished values out of the active set
+	list.addTime(TICK);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for( unsigned long long i = 0; i < ticks; i++ )
+		list.addTime(TICK);
+
+	std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+
+	run.storage = Storage<T>::name();
+	run.method = (methodKind == MK_LINEAR) ? "linear" : "looped";
+	run.type = TypeName<T>::get();
+	run.target = (targetKind == TK_VALUE) ? "value" : "direction";
+	run.finished = finished;
+	run.size = size;
+	run.ticks = unsigned(ticks);
+	run.active = list.getActiveCount();
+	run.seconds = took.count();
+
+	list.clear();
+	delete method;
+	return run;
+}
+
+static void printRun( FILE * out, const Run & run, bool first )
+{
+	double updates = double(run.size) * run.ticks;
+
+	fprintf(out, "%s\n    {\"storage\": \"%s\", \"method\": \"%s\", \"type\": \"%s\", "
+			"\"target\": \"%s\", \"finished_fraction\": %.2f, \"size\": %u, \"ticks\": %u, "
+			"\"active\": %u, \"seconds\": %.9f, \"ns_per_value_tick\": %.4f, "
+			"\"values_per_second\": %.1f}",
+			first ? "" : ",", run.storage, run.method, run.type, run.target, run.finished,
+			run.size, run.ticks, run.active, run.seconds, run.seconds * 1e9 / updates,
+			updates / run.seconds);
+	fflush(out);
+}
+
+template <typename T, template <typename> class Storage>
+static void runSizes( FILE * out, bool & first, unsigned minSize, unsigned maxSize,
+		unsigned long long work )
+{
+	static const double FINISHED[] = { 0.0, 0.5, 0.9 };
+
+	for( int m = MK_LINEAR; m <= MK_LOOPED; m++ ) {
+		for( int t = TK_VALUE; t <= TK_DIRECTION; t++ ) {
+			for( unsigned f = 0; f < sizeof(FINISHED) / sizeof(FINISHED[0]); f++ ) {
+				// Values with a directional target never finish
+				if( t == TK_DIRECTION && f > 0 )
+					break;
+
+				for( unsigned long long size = 1; size <= maxSize; size *= 10 ) {
+					if( size < minSize )
+						continue;
+
+					printRun(out, runOne<T, Storage>(MethodKind(m), TargetKind(t), FINISHED[f],
+							unsigned(size), work), first);
+					first = false;
+				}
+			}
+		}
+	}
+}
+
+static void printUsage( FILE * out, const char * program )
+{
+	fprintf(out, "Usage: %s [--min-size N] [--max-size N] [--work N] [--out FILE]\n", program);
+}
+
+int main( int argc, char ** argv )
+{
+	unsigned min_size = 1;
+	unsigned max_size = 10000000;
+	unsigned long long work = 20000000;
+	FILE * out = stdout;
+
+	for( int i = 1; i < argc; i++ ) {
+		if( !strcmp(argv[i], "--help") || !strcmp(argv[i], "-h") ) {
+			printUsage(stdout, argv[0]);
+			return 0;
+		}
+		else if( !strcmp(argv[i], "--min-size") && i + 1 < argc )
+			min_size = unsigned(strtoul(argv[++i], 0, 10));
+		else if( !strcmp(argv[i], "--max-size") && i + 1 < argc )
+			max_size = unsigned(strtoul(argv[++i], 0, 10));
+		else if( !strcmp(argv[i], "--work") && i + 1 < argc )
+			work = strtoull(argv[++i], 0, 10);
+		else if( !strcmp(argv[i], "--out") && i + 1 < argc ) {
+			out = fopen(argv[++i], "w");
+
+			if( !out ) {
+				fprintf(stderr, "Can't open %s for writing\n", argv[i]);
+				return 1;
+			}
+		}
+		else {
+			printUsage(stderr, argv[0]);
+			return 1;
+		}
+	}
+
+	bool first = true;
+
+	fprintf(out, "{\n  \"benchmark\": \"overrated_update\",\n  \"tick_seconds\": %.9f,\n"
+			"  \"results\": [", TICK);
+
+	runSizes<float, StorageBasic>(out, first, min_size, max_size, work);
+	runSizes<double, StorageBasic>(out, first, min_size, max_size, work);
+	runSizes<float, StorageRef>(out, first, min_size, max_size, work);
+	runSizes<double, StorageRef>(out, first, min_size, max_size, work);
+
+	fprintf(out, "\n  ]\n}\n");
+
+	if( out != stdout )
+		fclose(out);
+
+	return 0;
+}
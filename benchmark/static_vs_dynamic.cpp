@@ -0,0 +1,97 @@
+/**
+ *	OverRated Benchmark: static vs. dynamic updated values
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	This benchmark is released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Times the same updates done by UpdatedValueBasic in an UpdatedObjectList (virtual calls
+ *	all the way down) and by StaticUpdatedValue in a plain vector (everything inlined). Build
+ *	with optimizations on, for example:
+ *
+ *		g++ -O2 -std=c++11 -Iinclude benchmark/static_vs_dynamic.cpp -o static_vs_dynamic -pthread
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <chrono>
+#include <OverRated.h>
+
+using namespace OverRated;
+
+typedef StaticUpdatedValue< float, StaticStorageBasic<float>, StaticMethodLinear<float> >
+		StaticLinear;
+typedef StaticUpdatedValue< float, StaticStorageBasic<float>, StaticMethodLooped<float> >
+		StaticLooped;
+
+static const double TICK = 1.0 / 60.0;
+
+// Seconds per tick per value, for the faster of a few runs
+template <typename Tick>
+static double timeTicks( Tick tick, unsigned count, unsigned ticks )
+{
+	double best = 0.0;
+
+	for( unsigned run = 0; run < 3; run++ ) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		for( unsigned i = 0; i < ticks; i++ )
+			tick();
+
+		std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+		double each = took.count() / (double(ticks) * count);
+
+		if( run == 0 || each < best )
+			best = each;
+	}
+	return best;
+}
+
+int main( int argc, char ** argv )
+{
+	unsigned count = (argc > 1) ? unsigned(atoi(argv[1])) : 10000;
+	unsigned ticks = (argc > 2) ? unsigned(atoi(argv[2])) : 1000;
+
+	// The targets are too far away to reach, so every value updates on every tick
+	UpdateMethodLinear<float> linear(1.0f, 1.0e9f);
+	UpdateMethodLooped<float> looped(1.0f, CD_INCREASING, 0.0f, 360.0f);
+
+	std::vector< UpdatedValueBasic<float> > dynamic_linear(count, UpdatedValueBasic<float>(0.0f));
+	std::vector< UpdatedValueBasic<float> > dynamic_looped(count, UpdatedValueBasic<float>(0.0f));
+	UpdatedObjectList< UpdatedValue<float> > linear_list;
+	UpdatedObjectList< UpdatedValue<float> > looped_list;
+
+	for( unsigned i = 0; i < count; i++ ) {
+		dynamic_linear[i].setMethod(&linear);
+		dynamic_looped[i].setMethod(&looped);
+		linear_list.add(&dynamic_linear[i]);
+		looped_list.add(&dynamic_looped[i]);
+	}
+
+	std::vector<StaticLinear> static_linear(count,
+			StaticLinear(0.0f, StaticMethodLinear<float>(1.0f, 1.0e9f)));
+	std::vector<StaticLooped> static_looped(count,
+			StaticLooped(0.0f, StaticMethodLooped<float>(1.0f, CD_INCREASING, 0.0f, 360.0f)));
+
+	double dl = timeTicks([&]() { linear_list.addTime(TICK); }, count, ticks);
+	double sl = timeTicks([&]() {
+		for( unsigned i = 0; i < count; i++ )
+			static_linear[i].addTime(TICK);
+	}, count, ticks);
+	double dp = timeTicks([&]() { looped_list.addTime(TICK); }, count, ticks);
+	double sp = timeTicks([&]() {
+		for( unsigned i = 0; i < count; i++ )
+			static_looped[i].addTime(TICK);
+	}, count, ticks);
+
+	printf( "%u values, %u ticks (ns per value per tick)\n", count, ticks );
+	printf( "linear:  dynamic %8.3f   static %8.3f   (%.1fx)\n", dl * 1e9, sl * 1e9, dl / sl );
+	printf( "looped:  dynamic %8.3f   static %8.3f   (%.1fx)\n", dp * 1e9, sp * 1e9, dp / sp );
+
+	// Keep the results alive
+	return (static_linear[0].getValue() == dynamic_linear[0].getValue() &&
+			static_looped[0].getValue() == dynamic_looped[0].getValue()) ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+/**
+ *	Batch Update Functions
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_BATCH_H_DEFINED__
+#define OVERRATED_BATCH_H_DEFINED__
+
+#include "OVRUpdateStep.h"
+#include "OVRSimd.h"
+
+// These functions update whole arrays of values at once. The general templates work on any
+// type with a plain loop over the step functions; the float and double overloads hand as much
+// of the array as they can to the vector kernels for the instruction set picked in OVRSimd.h
+// and finish the remainder with the same plain loop.
+
+namespace OverRated
+{
+	/**
+	 *  Updates an array of values the same way UpdateMethodLinear would for a value target,
+	 *  with each value having its own target and rate.
+	 *
+	 *  @param values        The values to update in place
+	 *  @param targets       The value target of each value
+	 *  @param rates         The rate of each value
+	 *  @param count         Number of values
+	 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+	 */
+	template <typename T>
+	void BatchLinearToValue( T * values, const T * targets, const T * rates, unsigned count,
+			double timeElapsed )
+	{
+		for( unsigned i = 0; i < count; i++ )
+			values[i] = OverRated::StepLinearToValue(values[i], targets[i],
+					T(rates[i] * timeElapsed));
+	}
+
+	/**
+	 *  Picks the kernel for the current instruction set
+	 *
+	 *  @return   Number of values processed by the vector kernel
+	 */
+	template <typename T>
+	unsigned _BatchLinearToValueSimd( T * values, const T * targets, const T * rates,
+			unsigned count, double timeElapsed )
+	{
+#ifdef OVERRATED_SIMD_X86
+		OVERRATED_SIMD_DISPATCH(BatchLinearToValue,
+				(values, targets, rates, count, timeElapsed))
+#endif
+		return 0;
+	}
+
+	/**
+	 *  Vectorized version for floats ( @see BatchLinearToValue() )
+	 */
+	inline void BatchLinearToValue( float * values, const float * targets, const float * rates,
+			unsigned count, double timeElapsed )
+	{
+		unsigned done = OverRated::_BatchLinearToValueSimd(values, targets, rates, count,
+				timeElapsed);
+
+		OverRated::BatchLinearToValue<float>(values + done, targets + done, rates + done,
+				count - done, timeElapsed);
+	}
+
+	/**
+	 *  Vectorized version for doubles ( @see BatchLinearToValue() )
+	 */
+	inline void BatchLinearToValue( double * values, const double * targets,
+			const double * rates, unsigned count, double timeElapsed )
+	{
+		unsigned done = OverRated::_BatchLinearToValueSimd(values, targets, rates, count,
+				timeElapsed);
+
+		OverRated::BatchLinearToValue<double>(values + done, targets + done, rates + done,
+				count - done, timeElapsed);
+	}
+
+	/**
+	 *  Updates an array of values in a looped range the same way an UpdatedValue using
+	 *  UpdateMethodLooped would for a value target, with each value having its own target and
+	 *  rate. Values which are already at their target are left alone.
+	 *
+	 *  @param values        The values to update in place
+	 *  @param targets       The value target of each value
+	 *  @param rates         The rate of each value
+	 *  @param count         Number of values
+	 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+	 *  @param min           Minimum of the looping range
+	 *  @param max           Maximum of the looping range
+	 */
+	template <typename T>
+	void BatchLoopedToValue( T * values, const T * targets, const T * rates, unsigned count,
+			double timeElapsed, const T & min, const T & max )
+	{
+		for( unsigned i = 0; i < count; i++ ) {
+			if( !(values[i] == targets[i]) )
+				values[i] = OverRated::StepLoopedToValue(values[i], targets[i],
+						T(rates[i] * timeElapsed), min, max);
+		}
+	}
+
+	/**
+	 *  As above, but always going in the given direction rather than the shortest one
+	 *
+	 *  @param directionOverride   The direction to force
+	 */
+	template <typename T>
+	void BatchLoopedToValue( T * values, const T * targets, const T * rates, unsigned count,
+			double timeElapsed, OverRated::ConstDirection directionOverride,
+			const T & min, const T & max )
+	{
+		for( unsigned i = 0; i < count; i++ ) {
+			if( !(values[i] == targets[i]) )
+				values[i] = OverRated::StepLoopedToValue(values[i], targets[i],
+						T(rates[i] * timeElapsed), min, max, directionOverride);
+		}
+	}
+
+	/**
+	 *  Updates an array of values in a looped range the same way UpdateMethodLooped would for
+	 *  a directional target, with each value having its own rate.
+	 *
+	 *  @param values        The values to update in place
+	 *  @param rates         The rate of each value
+	 *  @param count         Number of values
+	 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+	 *  @param dir           The constant direction to travel in
+	 *  @param min           Minimum of the looping range
+	 *  @param max           Maximum of the looping range
+	 */
+	template <typename T>
+	void BatchLoopedInDirection( T * values, const T * rates, unsigned count,
+			double timeElapsed, OverRated::ConstDirection dir, const T & min, const T & max )
+	{
+		for( unsigned i = 0; i < count; i++ )
+			values[i] = OverRated::StepLoopedInDirection(values[i], dir,
+					T(rates[i] * timeElapsed), min, max);
+	}
+
+	/**
+	 *  Picks the looped kernel for the current instruction set
+	 *
+	 *  @return   Number of values processed by the vector kernel
+	 */
+	template <typename T>
+	unsigned _BatchLoopedSimd( T * values, const T * targets, const T * rates, unsigned count,
+			double timeElapsed, const T & min, const T & max, bool hasTarget, bool forced,
+			OverRated::ConstDirection dir )
+	{
+#ifdef OVERRATED_SIMD_X86
+		OVERRATED_SIMD_DISPATCH(BatchLooped,
+				(values, targets, rates, count, timeElapsed, min, max, hasTarget, forced, dir))
+#endif
+		return 0;
+	}
+
+	/**
+	 *  Vectorized version for floats ( @see BatchLoopedToValue() )
+	 */
+	inline void BatchLoopedToValue( float * values, const float * targets, const float * rates,
+			unsigned count, double timeElapsed, const float & min, const float & max )
+	{
+		unsigned done = OverRated::_BatchLoopedSimd(values, targets, rates, count, timeElapsed,
+				min, max, true, false, OverRated::CD_INCREASING);
+
+		OverRated::BatchLoopedToValue<float>(values + done, targets + done, rates + done,
+				count - done, timeElapsed, min, max);
+	}
+
+	/**
+	 *  Vectorized version for doubles ( @see BatchLoopedToValue() )
+	 */
+	inline void BatchLoopedToValue( double * values, const double * targets,
+			const double * rates, unsigned count, double timeElapsed,
+			const double & min, const double & max )
+	{
+		unsigned done = OverRated::_BatchLoopedSimd(values, targets, rates, count, timeElapsed,
+				min, max, true, false, OverRated::CD_INCREASING);
+
+		OverRated::BatchLoopedToValue<double>(values + done, targets + done, rates + done,
+				count - done, timeElapsed, min, max);
+	}
+
+	/**
+	 *  Vectorized version for floats ( @see BatchLoopedToValue() )
+	 */
+	inline void BatchLoopedToValue( float * values, const float * targets, const float * rates,
+			unsigned count, double timeElapsed, OverRated::ConstDirection directionOverride,
+			const float & min, const float & max )
+	{
+		unsigned done = OverRated::_BatchLoopedSimd(values, targets, rates, count, timeElapsed,
+				min, max, true, true, directionOverride);
+
+		OverRated::BatchLoopedToValue<float>(values + done, targets + done, rates + done,
+				count - done, timeElapsed, directionOverride, min, max);
+	}
+
+	/**
+	 *  Vectorized version for doubles ( @see BatchLoopedToValue() )
+	 */
+	inline void BatchLoopedToValue( double * values, const double * targets,
+			const double * rates, unsigned count, double timeElapsed,
+			OverRated::ConstDirection directionOverride, const double & min, const double & max )
+	{
+		unsigned done = OverRated::_BatchLoopedSimd(values, targets, rates, count, timeElapsed,
+				min, max, true, true, directionOverride);
+
+		OverRated::BatchLoopedToValue<double>(values + done, targets + done, rates + done,
+				count - done, timeElapsed, directionOverride, min, max);
+	}
+
+	/**
+	 *  Vectorized version for floats ( @see BatchLoopedInDirection() )
+	 */
+	inline void BatchLoopedInDirection( float * values, const float * rates, unsigned count,
+			double timeElapsed, OverRated::ConstDirection dir, const float & min,
+			const float & max )
+	{
+		unsigned done = OverRated::_BatchLoopedSimd<float>(values, 0, rates, count, timeElapsed,
+				min, max, false, false, dir);
+
+		OverRated::BatchLoopedInDirection<float>(values + done, rates + done, count - done,
+				timeElapsed, dir, min, max);
+	}
+
+	/**
+	 *  Vectorized version for doubles ( @see BatchLoopedInDirection() )
+	 */
+	inline void BatchLoopedInDirection( double * values, const double * rates, unsigned count,
+			double timeElapsed, OverRated::ConstDirection dir, const double & min,
+			const double & max )
+	{
+		unsigned done = OverRated::_BatchLoopedSimd<double>(values, 0, rates, count,
+				timeElapsed, min, max, false, false, dir);
+
+		OverRated::BatchLoopedInDirection<double>(values + done, rates + done, count - done,
+				timeElapsed, dir, min, max);
+	}
+
+	/**
+	 *  Updates an array of vector values the same way UpdateMethodVector would, with each value
+	 *  having its own target and rate. Rather than an array of vectors, the values are held as
+	 *  one array per component, back to back, so that the vector kernels can update a whole
+	 *  register of values at once and decide once per value whether it has arrived.
+	 *
+	 *  @param values        The values to update in place; component c of value i is at
+	 *                       values[c * count + i]
+	 *  @param targets       The value target of each value, laid out the same way
+	 *  @param rates         The rate of each value
+	 *  @param size          Number of components of each value
+	 *  @param count         Number of values
+	 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+	 */
+	template <typename T>
+	void BatchVectorToValue( T * values, const T * targets, const T * rates, unsigned size,
+			unsigned count, double timeElapsed )
+	{
+		for( unsigned i = 0; i < count; i++ )
+			OverRated::StepVectorToValue(values + i, targets + i, size, count,
+					T(rates[i] * timeElapsed));
+	}
+
+	/**
+	 *  Picks the vector kernel for the current instruction set
+	 *
+	 *  @return   Number of values processed by the vector kernel
+	 */
+	template <typename T>
+	unsigned _BatchVectorToValueSimd( T * values, const T * targets, const T * rates,
+			unsigned size, unsigned count, double timeElapsed )
+	{
+#ifdef OVERRATED_SIMD_X86
+		OVERRATED_SIMD_DISPATCH(BatchVectorToValue,
+				(values, targets, rates, size, count, timeElapsed))
+#endif
+		return 0;
+	}
+
+	/**
+	 *  Finishes the values the vector kernel left over. They are still laid out in arrays of
+	 *  the full count, so this can't simply call the general template on the remainder.
+	 */
+	template <typename T>
+	void _BatchVectorToValueRemainder( T * values, const T * targets, const T * rates,
+			unsigned size, unsigned count, double timeElapsed, unsigned done )
+	{
+		for( unsigned i = done; i < count; i++ )
+			OverRated::StepVectorToValue(values + i, targets + i, size, count,
+					T(rates[i] * timeElapsed));
+	}
+
+	/**
+	 *  Vectorized version for floats ( @see BatchVectorToValue() )
+	 */
+	inline void BatchVectorToValue( float * values, const float * targets, const float * rates,
+			unsigned size, unsigned count, double timeElapsed )
+	{
+		unsigned done = OverRated::_BatchVectorToValueSimd(values, targets, rates, size, count,
+				timeElapsed);
+
+		OverRated::_BatchVectorToValueRemainder(values, targets, rates, size, count,
+				timeElapsed, done);
+	}
+
+	/**
+	 *  Vectorized version for doubles ( @see BatchVectorToValue() )
+	 */
+	inline void BatchVectorToValue( double * values, const double * targets,
+			const double * rates, unsigned size, unsigned count, double timeElapsed )
+	{
+		unsigned done = OverRated::_BatchVectorToValueSimd(values, targets, rates, size, count,
+				timeElapsed);
+
+		OverRated::_BatchVectorToValueRemainder(values, targets, rates, size, count,
+				timeElapsed, done);
+	}
+}
+
+#endif // OVERRATED_BATCH_H_DEFINED__
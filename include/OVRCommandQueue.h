@@ -0,0 +1,413 @@
+/**
+ *	CommandQueue Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_COMMANDQUEUE_H_DEFINED__
+#define OVERRATED_COMMANDQUEUE_H_DEFINED__
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "OVRHandle.h"
+#include "OVRUpdatedObject.h"
+#include "OVRUpdatedValue.h"
+#include "OVRUpdateMethod.h"
+
+namespace OverRated
+{
+	/**
+	 *  Lets any thread ask for changes to a list and its items which are only safe on the
+	 *  thread updating the list: adding, removing, pausing, setting methods, retargeting and
+	 *  changing rates. Each call queues a command and returns at once. A list the queue is
+	 *  attached to ( @see UpdatedObjectList::setCommandQueue() ) carries the commands out at
+	 *  the start of its next update, in the order they were queued.
+	 *
+	 *  The queue has a fixed capacity, a power of two. Queuing never waits and never allocates;
+	 *  if the queue is full the call returns false and nothing is queued. Applying never waits
+	 *  either: if a thread has taken a place in the queue but not yet filled it in, that
+	 *  command and everything after it are left for the next update, so the order is kept.
+	 *
+	 *  Any number of threads may queue commands, but only one list may apply them. Objects
+	 *  named in a command must still exist when it is applied.
+	 */
+	template <typename T>
+	class CommandQueue
+	{
+	public:
+		enum { PAYLOAD_SIZE = 64 };		// Most bytes of arguments a command can carry
+
+		/**
+		 *  Constructor
+		 *
+		 *  @param capacity   The most commands waiting at once; rounded up to a power of two
+		 */
+		explicit CommandQueue( unsigned capacity = 1024 )
+		: mCells(_roundUp(capacity)), mMask(mCells.size() - 1), mTail(0), mHead(0)
+		{
+			for( unsigned i = 0; i < mCells.size(); i++ )
+				mCells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/**
+		 *  @return   The most commands waiting at once
+		 */
+		unsigned getCapacity() const
+		{
+			return mCells.size();
+		}
+
+		/**
+		 *  Queues adding an item to the list
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		bool add( T * item )
+		{
+			return _push<ItemArgs>(&CommandQueue::_applyAdd, ItemArgs(item));
+		}
+
+		/**
+		 *  Queues removing an item from the list
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		bool remove( T * item )
+		{
+			return _push<ItemArgs>(&CommandQueue::_applyRemove, ItemArgs(item));
+		}
+
+		/**
+		 *  Queues removing an item from the list by handle; a handle which is stale by then is
+		 *  ignored
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		bool remove( const OverRated::Handle & handle )
+		{
+			return _push<OverRated::Handle>(&CommandQueue::_applyRemoveHandle, handle);
+		}
+
+		/**
+		 *  Queues pausing or unpausing an object
+		 *
+		 *  @param object   Any object, in the list or not
+		 *  @param paused   Whether to pause(true) or unpause(false)
+		 *  @return         Whether the command was queued
+		 */
+		bool setIsPaused( OverRated::UpdatedObject * object, bool paused )
+		{
+			return _push<PauseArgs>(&CommandQueue::_applyPause, PauseArgs(object, paused));
+		}
+
+		/**
+		 *  Queues giving a value a method ( @see UpdatedValue::setMethod() )
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		template <typename V>
+		bool setMethod( OverRated::UpdatedValue<V> * value, OverRated::UpdateMethod<V> * method )
+		{
+			return _push< MethodArgs<V> >(&CommandQueue::template _applySetMethod<V>,
+					MethodArgs<V>(value, method));
+		}
+
+		/**
+		 *  Queues retargeting a value ( @see UpdatedValue::setTargetValue() )
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		template <typename V>
+		bool setTargetValue( OverRated::UpdatedValue<V> * value, const V & target )
+		{
+			return _push< TargetArgs<V> >(&CommandQueue::template _applySetTarget<V>,
+					TargetArgs<V>(value, target));
+		}
+
+		/**
+		 *  Queues retargeting a value and changing its rate ( @see UpdatedValue::retarget() )
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		template <typename V>
+		bool retarget( OverRated::UpdatedValue<V> * value, const V & rate, const V & target )
+		{
+			return _push< RetargetArgs<V> >(&CommandQueue::template _applyRetarget<V>,
+					RetargetArgs<V>(value, rate, target));
+		}
+
+		/**
+		 *  Queues changing the rate of a method. Values using it which had stopped are at the
+		 *  target, where a new rate leaves them, so they stay stopped.
+		 *
+		 *  @return   Whether the command was queued
+		 */
+		template <typename V>
+		bool setRate( OverRated::UpdateMethod<V> * method, const V & rate )
+		{
+			return _push< RateArgs<V> >(&CommandQueue::template _applySetRate<V>,
+					RateArgs<V>(method, rate));
+		}
+
+		/**
+		 *  Carries out the commands waiting, in order. UpdatedObjectList calls this; only one
+		 *  thread may call it at a time.
+		 *
+		 *  @param list   The list to apply the commands to
+		 *  @return       Number of commands applied
+		 */
+		unsigned apply( OverRated::UpdatedObjectList<T> & list )
+		{
+			unsigned applied = 0;
+
+			// At most one lap, so threads queuing quickly can't hold up the update for ever
+			while( applied < mCells.size() ) {
+				Cell & cell = mCells[mHead & mMask];
+
+				if( cell.sequence.load(std::memory_order_acquire) != mHead + 1 )
+					break;
+
+				cell.apply(list, &cell.payload);
+				cell.sequence.store(mHead + mCells.size(), std::memory_order_release);
+				mHead++;
+				applied++;
+			}
+
+			return applied;
+		}
+
+	private:
+		typedef void (*ApplyFunction)( OverRated::UpdatedObjectList<T> & list, void * payload );
+
+		CommandQueue( const CommandQueue & );
+		CommandQueue & operator=( const CommandQueue & );
+
+		// One place in the queue. The sequence says whose turn it is: equal to a ticket, the
+		// cell is free for the thread holding that ticket; one more, it holds that command.
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			ApplyFunction apply;
+			typename std::aligned_storage<PAYLOAD_SIZE>::type payload;
+		};
+
+		// The arguments of each kind of command
+		struct ItemArgs
+		{
+			ItemArgs( T * item ) : item(item) {}
+			T * item;
+		};
+
+		struct PauseArgs
+		{
+			PauseArgs( OverRated::UpdatedObject * object, bool paused )
+			: object(object), paused(paused)
+			{}
+
+			OverRated::UpdatedObject * object;
+			bool paused;
+		};
+
+		template <typename V>
+		struct MethodArgs
+		{
+			MethodArgs( OverRated::UpdatedValue<V> * value, OverRated::UpdateMethod<V> * method )
+			: value(value), method(method)
+			{}
+
+			OverRated::UpdatedValue<V> * value;
+			OverRated::UpdateMethod<V> * method;
+		};
+
+		template <typename V>
+		struct TargetArgs
+		{
+			TargetArgs( OverRated::UpdatedValue<V> * value, const V & target )
+			: value(value), target(target)
+			{}
+
+			OverRated::UpdatedValue<V> * value;
+			V target;
+		};
+
+		template <typename V>
+		struct RetargetArgs
+		{
+			RetargetArgs( OverRated::UpdatedValue<V> * value, const V & rate, const V & target )
+			: value(value), rate(rate), target(target)
+			{}
+
+			OverRated::UpdatedValue<V> * value;
+			V rate;
+			V target;
+		};
+
+		template <typename V>
+		struct RateArgs
+		{
+			RateArgs( OverRated::UpdateMethod<V> * method, const V & rate )
+			: method(method), rate(rate)
+			{}
+
+			OverRated::UpdateMethod<V> * method;
+			V rate;
+		};
+
+		/**
+		 *  Takes the next place in the queue and fills it in
+		 *
+		 *  @param apply   What to do with the arguments
+		 *  @param args    The arguments, copied into the cell
+		 *  @return        Whether there was room
+		 */
+		template <typename Args>
+		bool _push( ApplyFunction apply, const Args & args )
+		{
+			static_assert(sizeof(Args) <= PAYLOAD_SIZE, "Command arguments are too large");
+
+			size_t ticket = mTail.load(std::memory_order_relaxed);
+			Cell * cell;
+
+			for( ;; ) {
+				cell = &mCells[ticket & mMask];
+
+				size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t lag = std::ptrdiff_t(sequence) - std::ptrdiff_t(ticket);
+
+				if( lag == 0 ) {
+					if( mTail.compare_exchange_weak(ticket, ticket + 1,
+							std::memory_order_relaxed) )
+						break;
+				}
+				else if( lag < 0 )
+					return false;
+				else
+					ticket = mTail.load(std::memory_order_relaxed);
+			}
+
+			new (&cell->payload) Args(args);
+			cell->apply = apply;
+			cell->sequence.store(ticket + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 *  @return   The arguments stored in a cell
+		 */
+		template <typename Args>
+		static Args & _args( void * payload )
+		{
+			return *static_cast<Args *>(payload);
+		}
+
+		/**
+		 *  Runs the destructor of the arguments once the command is done with them
+		 */
+		template <typename Args>
+		static void _destroy( void * payload )
+		{
+			static_cast<Args *>(payload)->~Args();
+		}
+
+		static void _applyAdd( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			list.add(_args<ItemArgs>(payload).item);
+		}
+
+		static void _applyRemove( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			list.remove(_args<ItemArgs>(payload).item);
+		}
+
+		static void _applyRemoveHandle( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			list.remove(_args<OverRated::Handle>(payload));
+		}
+
+		static void _applyPause( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			PauseArgs & args = _args<PauseArgs>(payload);
+
+			args.object->setIsPaused(args.paused);
+		}
+
+		template <typename V>
+		static void _applySetMethod( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			MethodArgs<V> & args = _args< MethodArgs<V> >(payload);
+
+			args.value->setMethod(args.method);
+		}
+
+		template <typename V>
+		static void _applySetTarget( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			TargetArgs<V> & args = _args< TargetArgs<V> >(payload);
+
+			args.value->setTargetValue(args.target);
+			_destroy< TargetArgs<V> >(payload);
+		}
+
+		template <typename V>
+		static void _applyRetarget( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			RetargetArgs<V> & args = _args< RetargetArgs<V> >(payload);
+
+			args.value->retarget(args.rate, args.target);
+			_destroy< RetargetArgs<V> >(payload);
+		}
+
+		template <typename V>
+		static void _applySetRate( OverRated::UpdatedObjectList<T> & list, void * payload )
+		{
+			RateArgs<V> & args = _args< RateArgs<V> >(payload);
+
+			args.method->setRate(args.rate);
+			_destroy< RateArgs<V> >(payload);
+		}
+
+		/**
+		 *  @return   The smallest power of two no less than value, and at least 2
+		 */
+		static unsigned _roundUp( unsigned value )
+		{
+			unsigned size = 2;
+
+			while( size < value )
+				size *= 2;
+
+			return size;
+		}
+
+		std::vector<Cell> mCells;		// The ring of places
+		const size_t mMask;				// Capacity - 1
+		std::atomic<size_t> mTail;		// Ticket for the next command queued
+		size_t mHead;					// Ticket of the next command to apply
+	};
+}
+
+#endif // OVERRATED_COMMANDQUEUE_H_DEFINED__
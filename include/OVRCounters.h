@@ -0,0 +1,307 @@
+/**
+ *	Counters Definitions
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_COUNTERS_H_DEFINED__
+#define OVERRATED_COUNTERS_H_DEFINED__
+
+/**
+ *  Instrumentation for the update paths of lists and methods. Nothing here is compiled in
+ *  unless OVERRATED_ENABLE_COUNTERS is defined before the OverRated headers are included; with
+ *  it undefined, OVERRATED_COUNT() expands to nothing and the classes carry no counters at all.
+ *
+ *  Counts are first gathered in plain totals kept by each thread for the few sets of counters
+ *  it used last, and only added to the shared counters when FlushCounters() is called, which
+ *  the lists do at the end of every update and every parallel task, so updating a value costs
+ *  an add rather than an atomic operation. The shared counters are split into shards, each
+ *  thread adding to its own with relaxed atomics, so that threads flushing at the same time
+ *  don't fight over one cache line. Reading a counter flushes the calling thread and adds up
+ *  the shards without taking any lock, so a monitoring thread can read them at any time; a
+ *  total read during an update is missing counts that other threads haven't flushed yet.
+ *  Threads which update values or methods outside of any list should call FlushCounters()
+ *  themselves, and before any counters they used are destroyed.
+ */
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+
+#include <atomic>
+
+// Number of shards in each set of counters. Threads beyond this many share shards.
+#ifndef OVERRATED_COUNTER_SHARDS
+#define OVERRATED_COUNTER_SHARDS 8
+#endif
+
+#define OVERRATED_COUNT(counters, counter, amount) (counters).add((counter), (amount))
+
+namespace OverRated
+{
+	/**
+	 *  What UpdatedObjectList counts ( @see UpdatedObjectList::getCounters() )
+	 */
+	enum ListCounter
+	{
+		LC_TICKS,				// Updates of the list
+		LC_VISITED,				// Items updated
+		LC_ACTIVE,				// Items still active after being updated
+		LC_FINISHED,			// Items which went idle when updated
+		LC_PAUSED,				// Items found paused when updated
+		LC_TICK_NANOSECONDS,	// Total time spent in updates of the list
+		LC_COUNT
+	};
+
+	/**
+	 *  What UpdateMethod counts ( @see UpdateMethod::getCounters() )
+	 */
+	enum MethodCounter
+	{
+		MC_UPDATES,		// Values updated
+		MC_SNAPS,		// Updates which stopped a value at its target
+		MC_WRAPS,		// Values looped around a range
+		MC_COUNT
+	};
+
+	// Most counters in any one set, and how many sets each thread gathers totals for at once
+	enum { MAX_COUNTERS = 8, PENDING_SETS = 4 };
+
+	/**
+	 *  Totals a thread has gathered for one set of counters and not yet added to it
+	 */
+	struct _PendingCounts
+	{
+		std::atomic<unsigned long long> * target;	// The set's shard for the thread, or NULL
+		unsigned size;								// Number of counters in the set
+		unsigned long long counts[MAX_COUNTERS];
+	};
+
+	/**
+	 *  The totals the calling thread is gathering
+	 */
+	struct _PendingCounters
+	{
+		_PendingCounts sets[PENDING_SETS];
+		unsigned next;								// The set to give up when another is needed
+
+		/**
+		 *  Adds a set's totals to its shard and forgets them
+		 *
+		 *  @param set   The set
+		 */
+		static void flush( _PendingCounts & set )
+		{
+			for( unsigned c = 0; c < set.size; c++ ) {
+				if( set.counts[c] )
+					set.target[c].fetch_add(set.counts[c], std::memory_order_relaxed);
+			}
+
+			set.target = 0;
+		}
+
+		/**
+		 *  Finds the totals for a shard, giving up the oldest set if it has none yet
+		 *
+		 *  @param target   The shard
+		 *  @param size     Number of counters in it
+		 *  @return         Its totals
+		 */
+		_PendingCounts & find( std::atomic<unsigned long long> * target, unsigned size )
+		{
+			for( unsigned i = 0; i < PENDING_SETS; i++ ) {
+				if( sets[i].target == target )
+					return sets[i];
+			}
+
+			_PendingCounts & set = sets[next];
+
+			next = (next + 1) % PENDING_SETS;
+
+			if( set.target )
+				flush(set);
+
+			set.target = target;
+			set.size = size;
+
+			for( unsigned c = 0; c < size; c++ )
+				set.counts[c] = 0;
+
+			return set;
+		}
+
+		/**
+		 *  Forgets any totals for a shard without adding them
+		 *
+		 *  @param target   The shard
+		 */
+		void drop( std::atomic<unsigned long long> * target )
+		{
+			for( unsigned i = 0; i < PENDING_SETS; i++ ) {
+				if( sets[i].target == target )
+					sets[i].target = 0;
+			}
+		}
+	};
+
+	/**
+	 *  @return   The totals the calling thread is gathering
+	 */
+	inline _PendingCounters & _CounterPending()
+	{
+		static thread_local _PendingCounters pending = _PendingCounters();
+
+		return pending;
+	}
+
+	/**
+	 *  Adds every total the calling thread has gathered to its counters
+	 */
+	inline void FlushCounters()
+	{
+		_PendingCounters & pending = OverRated::_CounterPending();
+
+		for( unsigned i = 0; i < OverRated::PENDING_SETS; i++ ) {
+			if( pending.sets[i].target )
+				_PendingCounters::flush(pending.sets[i]);
+		}
+	}
+
+	/**
+	 *  @return   The counter shard of the calling thread
+	 */
+	inline unsigned _CounterShard()
+	{
+		static std::atomic<unsigned> next_shard(0);
+		static thread_local unsigned shard =
+				next_shard.fetch_add(1, std::memory_order_relaxed) % OVERRATED_COUNTER_SHARDS;
+
+		return shard;
+	}
+
+	/**
+	 *  A set of counters, indexed by one of the enums above
+	 */
+	template <unsigned N>
+	class Counters
+	{
+	public:
+		Counters()
+		{
+			reset();
+		}
+
+		/**
+		 *  Counts start again from zero in a copy
+		 */
+		Counters( const Counters & )
+		{
+			reset();
+		}
+
+		Counters & operator=( const Counters & ) { return *this; }
+
+		/**
+		 *  The calling thread's totals can't outlive the counters
+		 */
+		~Counters()
+		{
+			_drop();
+		}
+
+		/**
+		 *  Adds to the calling thread's total for a counter, which reaches the thread's shard
+		 *  when it next flushes ( @see FlushCounters() )
+		 *
+		 *  @param counter   Which counter
+		 *  @param amount    How much to add
+		 */
+		void add( unsigned counter, unsigned long long amount ) const
+		{
+			OverRated::_CounterPending().find(mShards[_CounterShard()].counts, N)
+					.counts[counter] += amount;
+		}
+
+		/**
+		 *  @param counter   Which counter
+		 *  @return          The counter's total over every thread, as far as they've flushed
+		 */
+		unsigned long long get( unsigned counter ) const
+		{
+			unsigned long long total = 0;
+
+			OverRated::FlushCounters();
+
+			for( unsigned i = 0; i < OVERRATED_COUNTER_SHARDS; i++ )
+				total += mShards[i].counts[counter].load(std::memory_order_relaxed);
+
+			return total;
+		}
+
+		/**
+		 *  Sets every counter back to zero, forgetting the calling thread's totals. Counts other
+		 *  threads flush at the same time may be lost.
+		 */
+		void reset()
+		{
+			_drop();
+
+			for( unsigned i = 0; i < OVERRATED_COUNTER_SHARDS; i++ ) {
+				for( unsigned c = 0; c < N; c++ )
+					mShards[i].counts[c].store(0, std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		// The counts of one or more threads, aligned so that no two shards share a cache line.
+		// Before C++17, new only aligns to the platform's default, so counters inside objects
+		// created with new may still straddle lines.
+		struct alignas(64) Shard
+		{
+			std::atomic<unsigned long long> counts[N];
+		};
+
+		mutable Shard mShards[OVERRATED_COUNTER_SHARDS];
+
+		static_assert(N <= OverRated::MAX_COUNTERS, "Too many counters in a set");
+
+		/**
+		 *  Forgets the calling thread's totals for every shard
+		 */
+		void _drop()
+		{
+			for( unsigned i = 0; i < OVERRATED_COUNTER_SHARDS; i++ )
+				OverRated::_CounterPending().drop(mShards[i].counts);
+		}
+	};
+
+	typedef OverRated::Counters<OverRated::LC_COUNT> ListCounters;
+	typedef OverRated::Counters<OverRated::MC_COUNT> MethodCounters;
+}
+
+#else
+
+// The amount is named but never evaluated, so values kept only for counting aren't unused
+#define OVERRATED_COUNT(counters, counter, amount) ((void)sizeof(amount))
+
+#endif // OVERRATED_ENABLE_COUNTERS
+
+#endif // OVERRATED_COUNTERS_H_DEFINED__
@@ -0,0 +1,232 @@
+/**
+ *	Easing Curve Definitions
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_EASE_H_DEFINED__
+#define OVERRATED_EASE_H_DEFINED__
+
+#include <cmath>
+
+// Easing curves map progress through a transition, from 0 to 1, to how far along the value
+// should be, where 0 is the start and 1 is the target. They can be worked out exactly with the
+// formulas here, or read from lookup tables shared by everything in the program, which is much
+// cheaper for the curves that need pow() or sin() and accurate to within about 0.002 (the
+// elastic curves, which change fastest, are the least accurate).
+
+namespace OverRated
+{
+	/**
+	 *  The easing curves available. "In" curves start slowly, "out" curves end slowly and
+	 *  "in out" curves do both.
+	 */
+	enum EaseCurve
+	{
+		EC_LINEAR,
+		EC_QUAD_IN,
+		EC_QUAD_OUT,
+		EC_QUAD_IN_OUT,
+		EC_CUBIC_IN,
+		EC_CUBIC_OUT,
+		EC_CUBIC_IN_OUT,
+		EC_EXPO_IN,
+		EC_EXPO_OUT,
+		EC_EXPO_IN_OUT,
+		EC_ELASTIC_IN,
+		EC_ELASTIC_OUT,
+		EC_ELASTIC_IN_OUT,
+		EC_BOUNCE_IN,
+		EC_BOUNCE_OUT,
+		EC_BOUNCE_IN_OUT,
+		EC_COUNT
+	};
+
+	/**
+	 *  How an easing curve is worked out
+	 */
+	enum EaseMode
+	{
+		EM_TABLE,	// Interpolated from a shared lookup table
+		EM_EXACT	// From the formula every time
+	};
+
+	/**
+	 *  Number of segments in each lookup table. Each table holds one more entry than this.
+	 */
+	static const unsigned EASE_TABLE_SEGMENTS = 1024;
+
+	/**
+	 *  @param progress   Progress from 0 to 1
+	 *  @return           Where the bounce out curve is at that point
+	 */
+	inline double EaseBounceOut( double progress )
+	{
+		const double n1 = 7.5625;
+		const double d1 = 2.75;
+
+		if( progress < 1.0 / d1 )
+			return n1 * progress * progress;
+		if( progress < 2.0 / d1 ) {
+			progress -= 1.5 / d1;
+			return n1 * progress * progress + 0.75;
+		}
+		if( progress < 2.5 / d1 ) {
+			progress -= 2.25 / d1;
+			return n1 * progress * progress + 0.9375;
+		}
+		progress -= 2.625 / d1;
+		return n1 * progress * progress + 0.984375;
+	}
+
+	/**
+	 *  Works out an easing curve from its formula
+	 *
+	 *  @param curve      The curve
+	 *  @param progress   Progress from 0 to 1
+	 *  @return           How far along the value should be, 0 at the start and 1 at the end
+	 */
+	inline double EaseExact( OverRated::EaseCurve curve, double progress )
+	{
+		const double p = progress;
+		const double elastic = 2.0 * 3.14159265358979323846 / 3.0;
+		const double elastic_in_out = 2.0 * 3.14159265358979323846 / 4.5;
+
+		if( p <= 0.0 )
+			return 0.0;
+		if( p >= 1.0 )
+			return 1.0;
+
+		switch( curve )
+		{
+		case OverRated::EC_QUAD_IN:
+			return p * p;
+		case OverRated::EC_QUAD_OUT:
+			return 1.0 - (1.0 - p) * (1.0 - p);
+		case OverRated::EC_QUAD_IN_OUT:
+			return (p < 0.5) ? 2.0 * p * p : 1.0 - (2.0 - 2.0 * p) * (2.0 - 2.0 * p) / 2.0;
+		case OverRated::EC_CUBIC_IN:
+			return p * p * p;
+		case OverRated::EC_CUBIC_OUT:
+			return 1.0 - (1.0 - p) * (1.0 - p) * (1.0 - p);
+		case OverRated::EC_CUBIC_IN_OUT:
+			return (p < 0.5) ? 4.0 * p * p * p :
+					1.0 - (2.0 - 2.0 * p) * (2.0 - 2.0 * p) * (2.0 - 2.0 * p) / 2.0;
+		case OverRated::EC_EXPO_IN:
+			return std::pow(2.0, 10.0 * p - 10.0);
+		case OverRated::EC_EXPO_OUT:
+			return 1.0 - std::pow(2.0, -10.0 * p);
+		case OverRated::EC_EXPO_IN_OUT:
+			return (p < 0.5) ? std::pow(2.0, 20.0 * p - 10.0) / 2.0 :
+					(2.0 - std::pow(2.0, -20.0 * p + 10.0)) / 2.0;
+		case OverRated::EC_ELASTIC_IN:
+			return -std::pow(2.0, 10.0 * p - 10.0) * std::sin((10.0 * p - 10.75) * elastic);
+		case OverRated::EC_ELASTIC_OUT:
+			return std::pow(2.0, -10.0 * p) * std::sin((10.0 * p - 0.75) * elastic) + 1.0;
+		case OverRated::EC_ELASTIC_IN_OUT:
+			return (p < 0.5) ?
+					-(std::pow(2.0, 20.0 * p - 10.0) *
+						std::sin((20.0 * p - 11.125) * elastic_in_out)) / 2.0 :
+					(std::pow(2.0, -20.0 * p + 10.0) *
+						std::sin((20.0 * p - 11.125) * elastic_in_out)) / 2.0 + 1.0;
+		case OverRated::EC_BOUNCE_IN:
+			return 1.0 - OverRated::EaseBounceOut(1.0 - p);
+		case OverRated::EC_BOUNCE_OUT:
+			return OverRated::EaseBounceOut(p);
+		case OverRated::EC_BOUNCE_IN_OUT:
+			return (p < 0.5) ? (1.0 - OverRated::EaseBounceOut(1.0 - 2.0 * p)) / 2.0 :
+					(1.0 + OverRated::EaseBounceOut(2.0 * p - 1.0)) / 2.0;
+		default:
+			return p;
+		}
+	}
+
+	/**
+	 *  The lookup table of a curve, filled in the first time it is asked for. Tables are shared
+	 *  by everything in the program and never change once filled, so they may be read from
+	 *  any thread.
+	 *
+	 *  @param curve   The curve
+	 *  @return        EASE_TABLE_SEGMENTS + 1 samples, evenly spaced from 0 to 1
+	 */
+	inline const float * EaseTable( OverRated::EaseCurve curve )
+	{
+		// Filling every table at once means the statics are only initialized once
+		struct Tables
+		{
+			Tables()
+			{
+				for( unsigned c = 0; c < OverRated::EC_COUNT; c++ ) {
+					for( unsigned i = 0; i <= OverRated::EASE_TABLE_SEGMENTS; i++ )
+						samples[c][i] = float(OverRated::EaseExact(OverRated::EaseCurve(c),
+								double(i) / OverRated::EASE_TABLE_SEGMENTS));
+				}
+			}
+
+			float samples[OverRated::EC_COUNT][OverRated::EASE_TABLE_SEGMENTS + 1];
+		};
+
+		static const Tables tables;
+
+		return tables.samples[(curve < OverRated::EC_COUNT) ? curve : OverRated::EC_LINEAR];
+	}
+
+	/**
+	 *  Reads a curve from its lookup table, interpolating between samples
+	 *
+	 *  @param table      The curve's table ( @see EaseTable() )
+	 *  @param progress   Progress from 0 to 1
+	 *  @return           How far along the value should be, 0 at the start and 1 at the end
+	 */
+	inline double EaseLookup( const float * table, double progress )
+	{
+		if( progress <= 0.0 )
+			return 0.0;
+		if( progress >= 1.0 )
+			return 1.0;
+
+		double position = progress * OverRated::EASE_TABLE_SEGMENTS;
+		unsigned index = unsigned(position);
+		double fraction = position - index;
+
+		return table[index] + (table[index + 1] - table[index]) * fraction;
+	}
+
+	/**
+	 *  Works out an easing curve either way
+	 *
+	 *  @param curve      The curve
+	 *  @param progress   Progress from 0 to 1
+	 *  @param mode       Whether to use the formula or the lookup table
+	 *  @return           How far along the value should be, 0 at the start and 1 at the end
+	 */
+	inline double EaseValue( OverRated::EaseCurve curve, double progress, OverRated::EaseMode mode )
+	{
+		if( mode == OverRated::EM_EXACT )
+			return OverRated::EaseExact(curve, progress);
+
+		return OverRated::EaseLookup(OverRated::EaseTable(curve), progress);
+	}
+}
+
+#endif // OVERRATED_EASE_H_DEFINED__
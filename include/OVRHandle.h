@@ -0,0 +1,71 @@
+/**
+ *	Handle Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_HANDLE_H_DEFINED__
+#define OVERRATED_HANDLE_H_DEFINED__
+
+namespace OverRated
+{
+	/**
+	 *  A stable reference to something stored in an OverRated container. It names a slot and
+	 *  the generation of that slot; once the thing is removed the slot's generation moves on,
+	 *  so the container can tell that an old handle is stale instead of handing back whatever
+	 *  took its place. A default constructed handle refers to nothing.
+	 */
+	struct Handle
+	{
+		Handle()
+		: slot(~0u), generation(0)
+		{}
+
+		Handle( unsigned slot, unsigned generation )
+		: slot(slot), generation(generation)
+		{}
+
+		/**
+		 *  @return   Whether this handle was never assigned to anything
+		 */
+		bool getIsNull() const
+		{
+			return slot == ~0u;
+		}
+
+		bool operator==( const Handle & other ) const
+		{
+			return slot == other.slot && generation == other.generation;
+		}
+
+		bool operator!=( const Handle & other ) const
+		{
+			return !(*this == other);
+		}
+
+		unsigned slot;			// Which slot of the container is referred to
+		unsigned generation;	// Which occupant of that slot is referred to
+	};
+}
+
+#endif // OVERRATED_HANDLE_H_DEFINED__
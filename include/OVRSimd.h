@@ -0,0 +1,150 @@
+/**
+ *	SIMD Support
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_SIMD_H_DEFINED__
+#define OVERRATED_SIMD_H_DEFINED__
+
+// This header decides which vector instruction sets the batch functions may use. Everything here
+// is optional; when OVERRATED_SIMD_X86 is not defined, the batch functions fall back to plain
+// loops which give exactly the same results. Define OVERRATED_NO_SIMD before including any
+// OverRated header to force that fallback.
+//
+// The vector code is compiled with per-function target attributes, so no special compiler flags
+// are needed. The instruction set is chosen at runtime from what the processor reports.
+//
+// The vector and scalar paths match bit for bit as long as the compiler doesn't fuse multiplies
+// and adds into FMA instructions, in either path. GCC does so by default outside of strict ISO
+// modes (-ffp-contract=fast), whenever FMA is available. The OverRated CMake target adds
+// -ffp-contract=off to everything that links it; builds which don't use it need the same flag.
+
+#if !defined(OVERRATED_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+	(defined(__x86_64__) || defined(__i386__))
+#define OVERRATED_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace OverRated
+{
+	// The vector instruction sets the batch functions know how to use
+	enum SimdLevel
+	{
+		SL_SCALAR,		// Plain loops only
+		SL_SSE2,		// 128 bit vectors
+		SL_AVX2,		// 256 bit vectors
+		SL_AVX512		// 512 bit vectors
+	};
+
+	/**
+	 *  Asks the processor which instruction sets it supports
+	 *
+	 *  @return   The best level available on this machine
+	 */
+	inline OverRated::SimdLevel SimdDetectLevel()
+	{
+#ifdef OVERRATED_SIMD_X86
+		__builtin_cpu_init();
+
+		if( __builtin_cpu_supports("avx512f") )
+			return OverRated::SL_AVX512;
+		if( __builtin_cpu_supports("avx2") )
+			return OverRated::SL_AVX2;
+		if( __builtin_cpu_supports("sse2") )
+			return OverRated::SL_SSE2;
+#endif
+		return OverRated::SL_SCALAR;
+	}
+
+	/**
+	 *  Storage for the level in use. Detection happens once, the first time it's needed.
+	 */
+	inline OverRated::SimdLevel & _SimdLevel()
+	{
+		static OverRated::SimdLevel level = OverRated::SimdDetectLevel();
+		return level;
+	}
+
+	/**
+	 *  @return   The instruction set currently used by the batch functions
+	 */
+	inline OverRated::SimdLevel SimdGetLevel()
+	{
+		return OverRated::_SimdLevel();
+	}
+
+	/**
+	 *  Restricts the batch functions to a lower instruction set, which is mostly useful for
+	 *  comparing them. Asking for more than the processor supports gives the best it has.
+	 *
+	 *  @param level   The highest level to use
+	 */
+	inline void SimdSetLevel( OverRated::SimdLevel level )
+	{
+		OverRated::SimdLevel detected = OverRated::SimdDetectLevel();
+
+		OverRated::_SimdLevel() = (level < detected) ? level : detected;
+	}
+}
+
+#ifdef OVERRATED_SIMD_X86
+
+// Target regions; everything defined between a push and a pop may use that instruction set.
+#if defined(__clang__)
+#define OVERRATED_SIMD_PUSH_SSE2 \
+	_Pragma("clang attribute push (__attribute__((target(\"sse2\"))), apply_to = function)")
+#define OVERRATED_SIMD_PUSH_AVX2 \
+	_Pragma("clang attribute push (__attribute__((target(\"avx2\"))), apply_to = function)")
+#define OVERRATED_SIMD_PUSH_AVX512 \
+	_Pragma("clang attribute push (__attribute__((target(\"avx512f\"))), apply_to = function)")
+#define OVERRATED_SIMD_POP _Pragma("clang attribute pop")
+#else
+#define OVERRATED_SIMD_PUSH_SSE2 \
+	_Pragma("GCC push_options") _Pragma("GCC target(\"sse2\")")
+#define OVERRATED_SIMD_PUSH_AVX2 \
+	_Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define OVERRATED_SIMD_PUSH_AVX512 \
+	_Pragma("GCC push_options") _Pragma("GCC target(\"avx512f\")")
+#define OVERRATED_SIMD_POP _Pragma("GCC pop_options")
+#endif
+
+#define OVERRATED_SIMD_INLINE inline __attribute__((always_inline))
+
+// Returns the result of calling a kernel for the current instruction set, if there is one
+#define OVERRATED_SIMD_DISPATCH(kernel, args) \
+	switch( OverRated::SimdGetLevel() ) \
+	{ \
+	case OverRated::SL_AVX512: return OverRated::SimdAvx512::kernel args; \
+	case OverRated::SL_AVX2: return OverRated::SimdAvx2::kernel args; \
+	case OverRated::SL_SSE2: return OverRated::SimdSse2::kernel args; \
+	default: break; \
+	}
+
+#include "OVRSimdSse2.h"
+#include "OVRSimdAvx2.h"
+#include "OVRSimdAvx512.h"
+
+#endif // OVERRATED_SIMD_X86
+
+#endif // OVERRATED_SIMD_H_DEFINED__
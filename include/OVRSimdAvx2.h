@@ -0,0 +1,125 @@
+/**
+ *	AVX2 Batch Kernels
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_SIMDAVX2_H_DEFINED__
+#define OVERRATED_SIMDAVX2_H_DEFINED__
+
+// Vector operations on 256 bit registers. Only meant to be included by OVRSimd.h.
+
+OVERRATED_SIMD_PUSH_AVX2
+
+namespace OverRated
+{
+	namespace SimdAvx2
+	{
+		template <typename T> struct Ops;
+
+		// Eight floats per register
+		template <> struct Ops<float>
+		{
+			typedef __m256 V;
+			typedef __m256 M;
+			enum { WIDTH = 8 };
+
+			static OVERRATED_SIMD_INLINE V load( const float * p ) { return _mm256_loadu_ps(p); }
+			static OVERRATED_SIMD_INLINE void store( float * p, V v ) { _mm256_storeu_ps(p, v); }
+			static OVERRATED_SIMD_INLINE V set1( float s ) { return _mm256_set1_ps(s); }
+			static OVERRATED_SIMD_INLINE V add( V a, V b ) { return _mm256_add_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V sub( V a, V b ) { return _mm256_sub_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V mul( V a, V b ) { return _mm256_mul_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V div( V a, V b ) { return _mm256_div_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V sqrt( V a ) { return _mm256_sqrt_ps(a); }
+			static OVERRATED_SIMD_INLINE M gt( V a, V b ) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+			static OVERRATED_SIMD_INLINE M ge( V a, V b ) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+			static OVERRATED_SIMD_INLINE M lt( V a, V b ) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			static OVERRATED_SIMD_INLINE M le( V a, V b ) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+			static OVERRATED_SIMD_INLINE M eq( V a, V b ) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+			static OVERRATED_SIMD_INLINE M mand( M a, M b ) { return _mm256_and_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M mor( M a, M b ) { return _mm256_or_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M mnot( M a )
+			{
+				return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+			}
+			static OVERRATED_SIMD_INLINE V select( M m, V a, V b )
+			{
+				return _mm256_blendv_ps(b, a, m);
+			}
+
+			// rate * time is worked out in double precision and then rounded, as T(rate * time)
+			static OVERRATED_SIMD_INLINE V scale( const float * p, double timeElapsed )
+			{
+				__m256d t = _mm256_set1_pd(timeElapsed);
+				__m256d lo = _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(p)), t);
+				__m256d hi = _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(p + 4)), t);
+
+				return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)),
+						_mm256_cvtpd_ps(hi), 1);
+			}
+		};
+
+		// Four doubles per register
+		template <> struct Ops<double>
+		{
+			typedef __m256d V;
+			typedef __m256d M;
+			enum { WIDTH = 4 };
+
+			static OVERRATED_SIMD_INLINE V load( const double * p ) { return _mm256_loadu_pd(p); }
+			static OVERRATED_SIMD_INLINE void store( double * p, V v ) { _mm256_storeu_pd(p, v); }
+			static OVERRATED_SIMD_INLINE V set1( double s ) { return _mm256_set1_pd(s); }
+			static OVERRATED_SIMD_INLINE V add( V a, V b ) { return _mm256_add_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V sub( V a, V b ) { return _mm256_sub_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V mul( V a, V b ) { return _mm256_mul_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V div( V a, V b ) { return _mm256_div_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V sqrt( V a ) { return _mm256_sqrt_pd(a); }
+			static OVERRATED_SIMD_INLINE M gt( V a, V b ) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+			static OVERRATED_SIMD_INLINE M ge( V a, V b ) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+			static OVERRATED_SIMD_INLINE M lt( V a, V b ) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+			static OVERRATED_SIMD_INLINE M le( V a, V b ) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+			static OVERRATED_SIMD_INLINE M eq( V a, V b ) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+			static OVERRATED_SIMD_INLINE M mand( M a, M b ) { return _mm256_and_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M mor( M a, M b ) { return _mm256_or_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M mnot( M a )
+			{
+				return _mm256_xor_pd(a, _mm256_castsi256_pd(_mm256_set1_epi32(-1)));
+			}
+			static OVERRATED_SIMD_INLINE V select( M m, V a, V b )
+			{
+				return _mm256_blendv_pd(b, a, m);
+			}
+			static OVERRATED_SIMD_INLINE V scale( const double * p, double timeElapsed )
+			{
+				return _mm256_mul_pd(_mm256_loadu_pd(p), _mm256_set1_pd(timeElapsed));
+			}
+		};
+
+#include "OVRSimdKernels.h"
+	}
+}
+
+OVERRATED_SIMD_POP
+
+#endif // OVERRATED_SIMDAVX2_H_DEFINED__
@@ -0,0 +1,172 @@
+/**
+ *	AVX-512 Batch Kernels
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_SIMDAVX512_H_DEFINED__
+#define OVERRATED_SIMDAVX512_H_DEFINED__
+
+// Vector operations on 512 bit registers. Only meant to be included by OVRSimd.h.
+//
+// Arithmetic uses the explicitly rounded forms of the instructions. They round exactly like the
+// plain ones, but the compiler will never fuse them into multiply-adds, which would change the
+// results compared to the scalar code. The zero-masked forms with every lane enabled are used
+// where the plain ones trip spurious uninitialized warnings in some GCC versions.
+
+OVERRATED_SIMD_PUSH_AVX512
+
+#define OVERRATED_SIMD_ROUND (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+#define OVERRATED_SIMD_ALL16 static_cast<__mmask16>(0xFFFF)
+#define OVERRATED_SIMD_ALL8 static_cast<__mmask8>(0xFF)
+
+namespace OverRated
+{
+	namespace SimdAvx512
+	{
+		template <typename T> struct Ops;
+
+		// Eight doubles per register
+		template <> struct Ops<double>
+		{
+			typedef __m512d V;
+			typedef __mmask8 M;
+			enum { WIDTH = 8 };
+
+			static OVERRATED_SIMD_INLINE V load( const double * p ) { return _mm512_loadu_pd(p); }
+			static OVERRATED_SIMD_INLINE void store( double * p, V v ) { _mm512_storeu_pd(p, v); }
+			static OVERRATED_SIMD_INLINE V set1( double s ) { return _mm512_set1_pd(s); }
+			static OVERRATED_SIMD_INLINE V add( V a, V b )
+			{
+				return _mm512_maskz_add_round_pd(OVERRATED_SIMD_ALL8, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V sub( V a, V b )
+			{
+				return _mm512_maskz_sub_round_pd(OVERRATED_SIMD_ALL8, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V mul( V a, V b )
+			{
+				return _mm512_maskz_mul_round_pd(OVERRATED_SIMD_ALL8, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V div( V a, V b )
+			{
+				return _mm512_maskz_div_round_pd(OVERRATED_SIMD_ALL8, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V sqrt( V a )
+			{
+				return _mm512_maskz_sqrt_round_pd(OVERRATED_SIMD_ALL8, a, OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE M gt( V a, V b ) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+			static OVERRATED_SIMD_INLINE M ge( V a, V b ) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+			static OVERRATED_SIMD_INLINE M lt( V a, V b ) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+			static OVERRATED_SIMD_INLINE M le( V a, V b ) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+			static OVERRATED_SIMD_INLINE M eq( V a, V b ) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+			static OVERRATED_SIMD_INLINE M mand( M a, M b ) { return a & b; }
+			static OVERRATED_SIMD_INLINE M mor( M a, M b ) { return a | b; }
+			static OVERRATED_SIMD_INLINE M mnot( M a ) { return static_cast<M>(~a); }
+			static OVERRATED_SIMD_INLINE V select( M m, V a, V b )
+			{
+				return _mm512_mask_blend_pd(m, b, a);
+			}
+			static OVERRATED_SIMD_INLINE V scale( const double * p, double timeElapsed )
+			{
+				return mul(_mm512_loadu_pd(p), _mm512_set1_pd(timeElapsed));
+			}
+		};
+
+		// Sixteen floats per register
+		template <> struct Ops<float>
+		{
+			typedef __m512 V;
+			typedef __mmask16 M;
+			enum { WIDTH = 16 };
+
+			static OVERRATED_SIMD_INLINE V load( const float * p ) { return _mm512_loadu_ps(p); }
+			static OVERRATED_SIMD_INLINE void store( float * p, V v ) { _mm512_storeu_ps(p, v); }
+			static OVERRATED_SIMD_INLINE V set1( float s ) { return _mm512_set1_ps(s); }
+			static OVERRATED_SIMD_INLINE V add( V a, V b )
+			{
+				return _mm512_maskz_add_round_ps(OVERRATED_SIMD_ALL16, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V sub( V a, V b )
+			{
+				return _mm512_maskz_sub_round_ps(OVERRATED_SIMD_ALL16, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V mul( V a, V b )
+			{
+				return _mm512_maskz_mul_round_ps(OVERRATED_SIMD_ALL16, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V div( V a, V b )
+			{
+				return _mm512_maskz_div_round_ps(OVERRATED_SIMD_ALL16, a, b,
+						OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE V sqrt( V a )
+			{
+				return _mm512_maskz_sqrt_round_ps(OVERRATED_SIMD_ALL16, a, OVERRATED_SIMD_ROUND);
+			}
+			static OVERRATED_SIMD_INLINE M gt( V a, V b ) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+			static OVERRATED_SIMD_INLINE M ge( V a, V b ) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+			static OVERRATED_SIMD_INLINE M lt( V a, V b ) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+			static OVERRATED_SIMD_INLINE M le( V a, V b ) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+			static OVERRATED_SIMD_INLINE M eq( V a, V b ) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+			static OVERRATED_SIMD_INLINE M mand( M a, M b ) { return a & b; }
+			static OVERRATED_SIMD_INLINE M mor( M a, M b ) { return a | b; }
+			static OVERRATED_SIMD_INLINE M mnot( M a ) { return static_cast<M>(~a); }
+			static OVERRATED_SIMD_INLINE V select( M m, V a, V b )
+			{
+				return _mm512_mask_blend_ps(m, b, a);
+			}
+
+			// rate * time is worked out in double precision and then rounded, as T(rate * time)
+			static OVERRATED_SIMD_INLINE V scale( const float * p, double timeElapsed )
+			{
+				__m512d t = _mm512_set1_pd(timeElapsed);
+				__m256 lo = _mm512_maskz_cvtpd_ps(OVERRATED_SIMD_ALL8, Ops<double>::mul(
+						_mm512_maskz_cvtps_pd(OVERRATED_SIMD_ALL8, _mm256_loadu_ps(p)), t));
+				__m256 hi = _mm512_maskz_cvtpd_ps(OVERRATED_SIMD_ALL8, Ops<double>::mul(
+						_mm512_maskz_cvtps_pd(OVERRATED_SIMD_ALL8, _mm256_loadu_ps(p + 8)), t));
+
+				return _mm512_castpd_ps(_mm512_maskz_insertf64x4(OVERRATED_SIMD_ALL8,
+						_mm512_castps_pd(_mm512_castps256_ps512(lo)), _mm256_castps_pd(hi), 1));
+			}
+		};
+
+#include "OVRSimdKernels.h"
+	}
+}
+
+#undef OVERRATED_SIMD_ROUND
+#undef OVERRATED_SIMD_ALL16
+#undef OVERRATED_SIMD_ALL8
+
+OVERRATED_SIMD_POP
+
+#endif // OVERRATED_SIMDAVX512_H_DEFINED__
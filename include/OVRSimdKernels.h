@@ -0,0 +1,231 @@
+/**
+ *	Batch Kernel Bodies
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+// This file has no include guard on purpose. It is included once inside the namespace of each
+// instruction set (see OVRSimdSse2.h and friends), where Ops<float> and Ops<double> describe
+// the registers of that instruction set. Each kernel handles whole registers only and returns how
+// many values it processed; the caller finishes the remainder with the scalar step functions.
+//
+// Every operation mirrors its scalar counterpart in OVRUpdateStep.h exactly, including the
+// argument order of each comparison, so the results are identical bit for bit.
+
+/**
+ *  Vector form of StepLinearToValue() over arrays
+ *
+ *  @param values        The values to update in place
+ *  @param targets       The value target of each value
+ *  @param rates         The rate of each value
+ *  @param count         Number of values
+ *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+ *  @return              Number of values processed
+ */
+template <typename T>
+unsigned BatchLinearToValue( T * values, const T * targets, const T * rates, unsigned count,
+		double timeElapsed )
+{
+	typedef Ops<T> O;
+	typedef typename O::V V;
+	typedef typename O::M M;
+
+	unsigned i = 0;
+
+	for( ; i + O::WIDTH <= count; i += O::WIDTH ) {
+		V value = O::load(values + i);
+		V target = O::load(targets + i);
+		V magnitude = O::scale(rates + i, timeElapsed);
+
+		// StepLinearDirection() and StepApplyDirection()
+		V result = O::select(O::gt(target, value),
+				O::add(value, magnitude), O::sub(value, magnitude));
+
+		// StepLinearSnap(), with UtilMax() and UtilMin() spelled out
+		V high = O::select(O::gt(value, result), value, result);
+		V low = O::select(O::le(value, result), value, result);
+		M passed = O::mand(O::le(target, high), O::ge(target, low));
+
+		O::store(values + i, O::select(passed, target, result));
+	}
+
+	return i;
+}
+
+/**
+ *  Vector form of StepLoopedWrap()
+ */
+template <typename O>
+OVERRATED_SIMD_INLINE typename O::V BatchLoopedWrap( typename O::V value, typename O::V min,
+		typename O::V max )
+{
+	typedef typename O::V V;
+
+	V looped = O::select(O::gt(value, max), O::add(min, O::sub(value, max)),
+			O::select(O::lt(value, min), O::add(max, O::sub(value, min)), value));
+
+	// UtilBindValueToRange()
+	return O::select(O::gt(looped, max), max, O::select(O::lt(looped, min), min, looped));
+}
+
+/**
+ *  Vector form of StepLoopedToValue() and StepLoopedInDirection() over arrays. Values which are
+ *  already at their target are left alone, as UpdatedValue would.
+ *
+ *  @param values        The values to update in place
+ *  @param targets       The value target of each value; unused for directional targets
+ *  @param rates         The rate of each value
+ *  @param count         Number of values
+ *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+ *  @param minimum       Minimum of the looping range
+ *  @param maximum       Maximum of the looping range
+ *  @param hasTarget     Whether the values have value targets
+ *  @param forced        Whether the direction is forced rather than the shortest one
+ *  @param dir           The forced direction, or the directional target
+ *  @return              Number of values processed
+ */
+template <typename T>
+unsigned BatchLooped( T * values, const T * targets, const T * rates, unsigned count,
+		double timeElapsed, T minimum, T maximum, bool hasTarget, bool forced,
+		OverRated::ConstDirection dir )
+{
+	typedef Ops<T> O;
+	typedef typename O::V V;
+	typedef typename O::M M;
+
+	V min = O::set1(minimum);
+	V max = O::set1(maximum);
+	V zero = O::set1(T(0));
+	M forced_inc = O::eq(zero, zero);
+
+	if( dir != OverRated::CD_INCREASING )
+		forced_inc = O::mnot(forced_inc);
+
+	unsigned i = 0;
+
+	for( ; i + O::WIDTH <= count; i += O::WIDTH ) {
+		V value = O::load(values + i);
+		V magnitude = O::scale(rates + i, timeElapsed);
+		V original = BatchLoopedWrap<O>(value, min, max);
+
+		if( !hasTarget ) {
+			V result = O::select(forced_inc,
+					O::add(original, magnitude), O::sub(original, magnitude));
+
+			O::store(values + i, BatchLoopedWrap<O>(result, min, max));
+			continue;
+		}
+
+		V target = O::load(targets + i);
+		M inc = forced_inc;
+
+		// StepLoopedDirection(), with UtilMax(), UtilMin() and UtilDist() spelled out. This uses
+		// the value as it was given, before it was looped into the range.
+		if( !forced ) {
+			V high = O::select(O::gt(value, target), value, target);
+			V low = O::select(O::le(value, target), value, target);
+			V forward = O::sub(high, low);
+			V backward = O::add(
+					O::sub(O::select(O::gt(low, min), low, min),
+							O::select(O::le(low, min), low, min)),
+					O::sub(O::select(O::gt(high, max), high, max),
+							O::select(O::le(high, max), high, max)));
+			M shorter = O::le(forward, backward);
+			M ascending = O::le(value, target);
+
+			inc = O::mor(O::mand(shorter, ascending),
+					O::mand(O::mnot(shorter), O::mnot(ascending)));
+		}
+
+		V result = O::select(inc, O::add(original, magnitude), O::sub(original, magnitude));
+
+		// StepLoopedSnap(). Looping a result that is still in the range leaves it alone, so
+		// both of its cases can share the looped result and differ only in the snap test.
+		M in_range = O::mand(O::le(result, max), O::ge(result, min));
+		V looped = BatchLoopedWrap<O>(result, min, max);
+		V from = O::select(in_range, original, looped);
+		V to = O::select(in_range, result, O::select(O::gt(result, max), min, max));
+		V high = O::select(O::gt(from, to), from, to);
+		V low = O::select(O::le(from, to), from, to);
+		M passed = O::mand(O::le(target, high), O::ge(target, low));
+
+		result = O::select(passed, target, looped);
+
+		// Values already at their target don't update at all
+		O::store(values + i, O::select(O::eq(value, target), value, result));
+	}
+
+	return i;
+}
+
+/**
+ *  Vector form of StepVectorToValue() over arrays holding each component in turn. Each lane
+ *  holds a whole vector, so the arrival test is made once per vector and applies to all of its
+ *  components.
+ *
+ *  @param values        The values to update in place; component c of value i is at
+ *                       values[c * count + i]
+ *  @param targets       The value target of each value, laid out the same way
+ *  @param rates         The rate of each value
+ *  @param size          Number of components
+ *  @param count         Number of values
+ *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+ *  @return              Number of values processed
+ */
+template <typename T>
+unsigned BatchVectorToValue( T * values, const T * targets, const T * rates, unsigned size,
+		unsigned count, double timeElapsed )
+{
+	typedef Ops<T> O;
+	typedef typename O::V V;
+	typedef typename O::M M;
+
+	unsigned i = 0;
+
+	for( ; i + O::WIDTH <= count; i += O::WIDTH ) {
+		V distanceSquared = O::set1(T(0));
+
+		for( unsigned c = 0; c < size; c++ ) {
+			V offset = O::sub(O::load(targets + c * count + i), O::load(values + c * count + i));
+
+			distanceSquared = O::add(distanceSquared, O::mul(offset, offset));
+		}
+
+		V distance = O::sqrt(distanceSquared);
+		V magnitude = O::scale(rates + i, timeElapsed);
+		M arrived = O::le(distance, magnitude);
+
+		// Arrived lanes may divide by zero here, but their result is thrown away
+		V fraction = O::div(magnitude, distance);
+
+		for( unsigned c = 0; c < size; c++ ) {
+			V value = O::load(values + c * count + i);
+			V target = O::load(targets + c * count + i);
+
+			O::store(values + c * count + i, O::select(arrived, target,
+					O::add(value, O::mul(O::sub(target, value), fraction))));
+		}
+	}
+
+	return i;
+}
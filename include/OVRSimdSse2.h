@@ -0,0 +1,125 @@
+/**
+ *	SSE2 Batch Kernels
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_SIMDSSE2_H_DEFINED__
+#define OVERRATED_SIMDSSE2_H_DEFINED__
+
+// Vector operations on 128 bit registers. Only meant to be included by OVRSimd.h.
+
+OVERRATED_SIMD_PUSH_SSE2
+
+namespace OverRated
+{
+	namespace SimdSse2
+	{
+		template <typename T> struct Ops;
+
+		// Four floats per register
+		template <> struct Ops<float>
+		{
+			typedef __m128 V;
+			typedef __m128 M;
+			enum { WIDTH = 4 };
+
+			static OVERRATED_SIMD_INLINE V load( const float * p ) { return _mm_loadu_ps(p); }
+			static OVERRATED_SIMD_INLINE void store( float * p, V v ) { _mm_storeu_ps(p, v); }
+			static OVERRATED_SIMD_INLINE V set1( float s ) { return _mm_set1_ps(s); }
+			static OVERRATED_SIMD_INLINE V add( V a, V b ) { return _mm_add_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V sub( V a, V b ) { return _mm_sub_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V mul( V a, V b ) { return _mm_mul_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V div( V a, V b ) { return _mm_div_ps(a, b); }
+			static OVERRATED_SIMD_INLINE V sqrt( V a ) { return _mm_sqrt_ps(a); }
+			static OVERRATED_SIMD_INLINE M gt( V a, V b ) { return _mm_cmpgt_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M ge( V a, V b ) { return _mm_cmpge_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M lt( V a, V b ) { return _mm_cmplt_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M le( V a, V b ) { return _mm_cmple_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M eq( V a, V b ) { return _mm_cmpeq_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M mand( M a, M b ) { return _mm_and_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M mor( M a, M b ) { return _mm_or_ps(a, b); }
+			static OVERRATED_SIMD_INLINE M mnot( M a )
+			{
+				return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+			}
+			static OVERRATED_SIMD_INLINE V select( M m, V a, V b )
+			{
+				return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+			}
+
+			// rate * time is worked out in double precision and then rounded, as T(rate * time)
+			static OVERRATED_SIMD_INLINE V scale( const float * p, double timeElapsed )
+			{
+				__m128 rates = _mm_loadu_ps(p);
+				__m128d t = _mm_set1_pd(timeElapsed);
+				__m128d lo = _mm_mul_pd(_mm_cvtps_pd(rates), t);
+				__m128d hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(rates, rates)), t);
+
+				return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+			}
+		};
+
+		// Two doubles per register
+		template <> struct Ops<double>
+		{
+			typedef __m128d V;
+			typedef __m128d M;
+			enum { WIDTH = 2 };
+
+			static OVERRATED_SIMD_INLINE V load( const double * p ) { return _mm_loadu_pd(p); }
+			static OVERRATED_SIMD_INLINE void store( double * p, V v ) { _mm_storeu_pd(p, v); }
+			static OVERRATED_SIMD_INLINE V set1( double s ) { return _mm_set1_pd(s); }
+			static OVERRATED_SIMD_INLINE V add( V a, V b ) { return _mm_add_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V sub( V a, V b ) { return _mm_sub_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V mul( V a, V b ) { return _mm_mul_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V div( V a, V b ) { return _mm_div_pd(a, b); }
+			static OVERRATED_SIMD_INLINE V sqrt( V a ) { return _mm_sqrt_pd(a); }
+			static OVERRATED_SIMD_INLINE M gt( V a, V b ) { return _mm_cmpgt_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M ge( V a, V b ) { return _mm_cmpge_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M lt( V a, V b ) { return _mm_cmplt_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M le( V a, V b ) { return _mm_cmple_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M eq( V a, V b ) { return _mm_cmpeq_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M mand( M a, M b ) { return _mm_and_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M mor( M a, M b ) { return _mm_or_pd(a, b); }
+			static OVERRATED_SIMD_INLINE M mnot( M a )
+			{
+				return _mm_xor_pd(a, _mm_castsi128_pd(_mm_set1_epi32(-1)));
+			}
+			static OVERRATED_SIMD_INLINE V select( M m, V a, V b )
+			{
+				return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+			}
+			static OVERRATED_SIMD_INLINE V scale( const double * p, double timeElapsed )
+			{
+				return _mm_mul_pd(_mm_loadu_pd(p), _mm_set1_pd(timeElapsed));
+			}
+		};
+
+#include "OVRSimdKernels.h"
+	}
+}
+
+OVERRATED_SIMD_POP
+
+#endif // OVERRATED_SIMDSSE2_H_DEFINED__
@@ -0,0 +1,226 @@
+/**
+ *	Snapshot Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_SNAPSHOT_H_DEFINED__
+#define OVERRATED_SNAPSHOT_H_DEFINED__
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "assert.h"
+
+namespace OverRated
+{
+	/**
+	 *  Hands a consistent copy of an array of values from the thread updating them to any
+	 *  number of threads reading them, such as rendering and networking. The writer publishes
+	 *  a whole frame of values at a time, typically straight after adding time; readers copy
+	 *  out the latest frame. Neither side ever takes a lock or waits for the other.
+	 *
+	 *  There are two buffers. The writer fills the one readers aren't being pointed at and then
+	 *  publishes it. A reader copies the latest buffer and checks that the writer didn't start
+	 *  overwriting it in the meantime, which only happens if two more frames are published
+	 *  during a single read; in that case it simply reads again. A read never returns a mix of
+	 *  two frames.
+	 *
+	 *  Only one thread may publish at a time. The values are stored as atomic words, so T must
+	 *  be trivially copyable (plain numbers, Vector and the like).
+	 */
+	template <typename T>
+	class Snapshot
+	{
+	public:
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Snapshot needs a trivially copyable type");
+
+		/**
+		 *  Constructor
+		 *
+		 *  @param capacity   The most values a frame can hold
+		 */
+		explicit Snapshot( unsigned capacity )
+		: mCapacity(capacity), mWords(2 * capacity * WORDS), mPublished(0), mWriting(0)
+		{
+			mCounts[0].store(0, std::memory_order_relaxed);
+			mCounts[1].store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 *  @return   The most values a frame can hold
+		 */
+		unsigned getCapacity() const
+		{
+			return mCapacity;
+		}
+
+		/**
+		 *  @return   How many frames have been published; 0 before the first
+		 */
+		unsigned long long getFrame() const
+		{
+			return mPublished.load(std::memory_order_acquire);
+		}
+
+		/**
+		 *  Publishes a new frame copied from an array. Only the writing thread may call this.
+		 *
+		 *  @param values   The values of the frame
+		 *  @param count    Number of values, no more than the capacity
+		 */
+		void publish( const T * values, unsigned count )
+		{
+			unsigned buffer = _beginFrame(count);
+
+			for( unsigned i = 0; i < count; i++ )
+				_store(buffer, i, values[i]);
+
+			_endFrame(buffer, count);
+		}
+
+		/**
+		 *  Publishes a new frame with each value asked for in turn, for values which aren't in
+		 *  an array; for example, a list of UpdatedValue's:
+		 *
+		 *      snapshot.publish(count, [&]( unsigned i ) { return values[i]->getValue(); });
+		 *
+		 *  Only the writing thread may call this.
+		 *
+		 *  @param count    Number of values, no more than the capacity
+		 *  @param source   Called with each index from 0 to count - 1 for the value there
+		 */
+		template <typename Source>
+		void publish( unsigned count, Source source )
+		{
+			unsigned buffer = _beginFrame(count);
+
+			for( unsigned i = 0; i < count; i++ )
+				_store(buffer, i, source(i));
+
+			_endFrame(buffer, count);
+		}
+
+		/**
+		 *  Copies out the latest frame. Any thread may call this at any time.
+		 *
+		 *  @param values     Receives the values of the frame
+		 *  @param maxCount   Room in values; any more values in the frame are left out
+		 *  @param frame      If given, receives the number of the frame that was read
+		 *  @return           Number of values copied
+		 */
+		unsigned read( T * values, unsigned maxCount, unsigned long long * frame = 0 ) const
+		{
+			for( ;; ) {
+				unsigned long long published = mPublished.load(std::memory_order_acquire);
+				unsigned buffer = unsigned(published & 1);
+				unsigned count = mCounts[buffer].load(std::memory_order_acquire);
+
+				if( count > maxCount )
+					count = maxCount;
+
+				for( unsigned i = 0; i < count; i++ )
+					values[i] = _load(buffer, i);
+
+				// Seeing anything from the frame after next means seeing that it was started
+				if( mWriting.load(std::memory_order_relaxed) < published + 2 ) {
+					if( frame )
+						*frame = published;
+
+					return count;
+				}
+			}
+		}
+
+	private:
+		// Atomic words per value
+		enum { WORDS = (sizeof(T) + sizeof(unsigned) - 1) / sizeof(unsigned) };
+
+		Snapshot( const Snapshot & );
+		Snapshot & operator=( const Snapshot & );
+
+		/**
+		 *  Marks the next frame as being written
+		 *
+		 *  @return   The buffer to write it into
+		 */
+		unsigned _beginFrame( unsigned count )
+		{
+			unsigned long long frame = mPublished.load(std::memory_order_relaxed) + 1;
+
+			assert( count <= mCapacity );
+
+			mWriting.store(frame, std::memory_order_relaxed);
+			return unsigned(frame & 1);
+		}
+
+		/**
+		 *  Makes the frame just written the latest
+		 */
+		void _endFrame( unsigned buffer, unsigned count )
+		{
+			mCounts[buffer].store(count, std::memory_order_release);
+			mPublished.store(mPublished.load(std::memory_order_relaxed) + 1,
+					std::memory_order_release);
+		}
+
+		/**
+		 *  Stores a value. The stores release, so a reader which sees any part of it also sees
+		 *  that the frame was started.
+		 */
+		void _store( unsigned buffer, unsigned index, const T & value )
+		{
+			unsigned words[WORDS] = {};
+			std::atomic<unsigned> * to = &mWords[(buffer * mCapacity + index) * WORDS];
+
+			std::memcpy(words, &value, sizeof(T));
+
+			for( unsigned i = 0; i < WORDS; i++ )
+				to[i].store(words[i], std::memory_order_release);
+		}
+
+		T _load( unsigned buffer, unsigned index ) const
+		{
+			unsigned words[WORDS];
+			const std::atomic<unsigned> * from = &mWords[(buffer * mCapacity + index) * WORDS];
+			T value;
+
+			for( unsigned i = 0; i < WORDS; i++ )
+				words[i] = from[i].load(std::memory_order_acquire);
+
+			std::memcpy(&value, words, sizeof(T));
+			return value;
+		}
+
+		const unsigned mCapacity;							// Most values in a frame
+		std::vector< std::atomic<unsigned> > mWords;		// Both buffers, one after the other
+		std::atomic<unsigned> mCounts[2];					// Values in each buffer
+		std::atomic<unsigned long long> mPublished;			// Latest frame, in buffer frame & 1
+		std::atomic<unsigned long long> mWriting;			// Latest frame started
+	};
+}
+
+#endif // OVERRATED_SNAPSHOT_H_DEFINED__
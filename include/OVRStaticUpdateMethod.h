@@ -0,0 +1,411 @@
+/**
+ *	Static UpdateMethod Policy Definitions
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_STATICUPDATEMETHOD_H_DEFINED__
+#define OVERRATED_STATICUPDATEMETHOD_H_DEFINED__
+
+#include "OVRUpdateMethod.h"
+#include "OVRUpdateStep.h"
+#include "OVRUtils.h"
+
+namespace OverRated
+{
+	/**
+	 *  Linear method policy for StaticUpdatedValue. This behaves exactly as UpdateMethodLinear
+	 *  does, but nothing is virtual, so a whole update can be inlined into the caller. It is
+	 *  held by value; each StaticUpdatedValue has its own copy.
+	 */
+	template <typename T>
+	class StaticMethodLinear
+	{
+	public:
+		/**
+		 *  Constructor for a directional target
+		 *
+		 *  @param rate     The rate of change
+		 *  @param target   The constant direction to travel in
+		 */
+		StaticMethodLinear( const T & rate, OverRated::ConstDirection target )
+		: mRate(rate), mTargetValue(0), mTargetDir(target), mHasTargetValue(false)
+		{}
+
+		/**
+		 *  Constructor for a value target
+		 *
+		 *  @param rate     The rate of change
+		 *  @param target   The value to try and reach
+		 */
+		StaticMethodLinear( const T & rate, const T & target )
+		: mRate(rate), mTargetValue(target), mTargetDir(OverRated::CD_INCREASING),
+		  mHasTargetValue(true)
+		{}
+
+		/**
+		 *  @param rate  The new rate (magnitude is used)
+		 */
+		void setRate( const T & rate ) { mRate = OverRated::UtilAbs(rate); }
+
+		/**
+		 *  @return   The set rate
+		 */
+		T getRate() const { return mRate; }
+
+		/**
+		 *  @return   Whether the target of this method is a value
+		 */
+		bool getHasTargetValue() const { return mHasTargetValue; }
+
+		/**
+		 *  @return   Whether the target of this method is a direction
+		 */
+		bool getHasTargetDirection() const { return !mHasTargetValue; }
+
+		/**
+		 *  @return   The value target. This is undefined if the target is directional.
+		 */
+		T getTargetValue() const { return mTargetValue; }
+
+		/**
+		 *  @return   The directional target. This is undefined if the target is value-based.
+		 */
+		OverRated::ConstDirection getTargetDirection() const { return mTargetDir; }
+
+		/**
+		 *  @param target   The new value to try and reach, in place of any target
+		 */
+		void setTargetValue( const T & target )
+		{
+			mTargetValue = target;
+			mHasTargetValue = true;
+		}
+
+		/**
+		 *  @param target   The new constant direction to travel in, in place of any target
+		 */
+		void setTargetDirection( OverRated::ConstDirection target )
+		{
+			mTargetDir = target;
+			mHasTargetValue = false;
+		}
+
+		/**
+		 *  Changes the rate and the value target together
+		 *
+		 *  @param rate     The new rate (magnitude is used)
+		 *  @param target   The value to try and reach
+		 */
+		void retarget( const T & rate, const T & target )
+		{
+			setRate(rate);
+			setTargetValue(target);
+		}
+
+		/**
+		 *  @return  Whether this is method has a target value AND has reached it.
+		 */
+		bool getIsFinished( const T & value ) const
+		{
+			return mHasTargetValue && value == mTargetValue;
+		}
+
+		/**
+		 *  @see UpdateMethod::updateValue()
+		 */
+		T updateValue( const T & value, const double & timeElapsed ) const
+		{
+			T magnitude( mRate * timeElapsed );
+
+			if( mHasTargetValue )
+				return OverRated::StepLinearToValue(value, mTargetValue, magnitude);
+
+			return OverRated::StepApplyDirection(value, mTargetDir, magnitude);
+		}
+
+		/**
+		 *  @see UpdateMethodLinear::evaluateAt()
+		 */
+		T evaluateAt( const T & startValue, double time ) const
+		{
+			if( getIsFinished(startValue) )
+				return startValue;
+
+			return updateValue(startValue, time);
+		}
+
+		/**
+		 *  @see UpdateMethodLinear::timeToFinish()
+		 */
+		double timeToFinish( const T & startValue ) const
+		{
+			if( !mHasTargetValue )
+				return -1.0;
+
+			if( getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(mRate > 0) )
+				return -1.0;
+
+			return double(OverRated::UtilDist(startValue, mTargetValue)) / double(mRate);
+		}
+
+	private:
+		T mRate;								// Rate of change, per second
+		T mTargetValue;							// Value target, if mHasTargetValue
+		OverRated::ConstDirection mTargetDir;	// Directional target, if not mHasTargetValue
+		bool mHasTargetValue;					// Which kind of target this is
+	};
+
+	/**
+	 *  Looped method policy for StaticUpdatedValue. This behaves exactly as UpdateMethodLooped
+	 *  does, but nothing is virtual, so a whole update can be inlined into the caller. It is
+	 *  held by value; each StaticUpdatedValue has its own copy.
+	 */
+	template <typename T>
+	class StaticMethodLooped
+	{
+	public:
+		/**
+		 *  Constructor for a directional target
+		 *
+		 *  @param rate     The rate of change
+		 *  @param target   The constant direction to travel in
+		 *  @param min      The minimum of the looping range
+		 *  @param max      The maximum of the looping range
+		 */
+		StaticMethodLooped( const T & rate, OverRated::ConstDirection target,
+				const T & min, const T & max )
+		: mRate(rate), mTargetValue(0), mMin(min), mMax(max), mTargetDir(target),
+		  mHasTargetValue(false), mIsOverrideEnabled(false)
+		{}
+
+		/**
+		 *  Constructor for a value target, taking the shortest way around
+		 *
+		 *  @param rate     The rate of change
+		 *  @param target   The value to try and reach
+		 *  @param min      The minimum of the looping range
+		 *  @param max      The maximum of the looping range
+		 */
+		StaticMethodLooped( const T & rate, const T & target, const T & min, const T & max )
+		: mRate(rate), mTargetValue(target), mMin(min), mMax(max),
+		  mTargetDir(OverRated::CD_INCREASING), mHasTargetValue(true), mIsOverrideEnabled(false)
+		{}
+
+		/**
+		 *  Constructor for a value target, always going the same way around
+		 *
+		 *  @param rate                The rate of change
+		 *  @param target              The value to try and reach
+		 *  @param directionOverride   The direction to always travel in
+		 *  @param min                 The minimum of the looping range
+		 *  @param max                 The maximum of the looping range
+		 */
+		StaticMethodLooped( const T & rate, const T & target,
+				OverRated::ConstDirection directionOverride, const T & min, const T & max )
+		: mRate(rate), mTargetValue(target), mMin(min), mMax(max), mTargetDir(directionOverride),
+		  mHasTargetValue(true), mIsOverrideEnabled(true)
+		{}
+
+		/**
+		 *  @param rate  The new rate (magnitude is used)
+		 */
+		void setRate( const T & rate ) { mRate = OverRated::UtilAbs(rate); }
+
+		/**
+		 *  @return   The set rate
+		 */
+		T getRate() const { return mRate; }
+
+		/**
+		 *  @return   The minimum of the looping range
+		 */
+		T getMin() const { return mMin; }
+
+		/**
+		 *  @return   The maximum of the looping range
+		 */
+		T getMax() const { return mMax; }
+
+		/**
+		 *  @return   Whether the target of this method is a value
+		 */
+		bool getHasTargetValue() const { return mHasTargetValue; }
+
+		/**
+		 *  @return   Whether the target of this method is a direction
+		 */
+		bool getHasTargetDirection() const { return !mHasTargetValue; }
+
+		/**
+		 *  @return   The value target. This is undefined if the target is directional.
+		 */
+		T getTargetValue() const { return mTargetValue; }
+
+		/**
+		 *  @return   The directional target. This is undefined if the target is value-based.
+		 */
+		OverRated::ConstDirection getTargetDirection() const { return mTargetDir; }
+
+		/**
+		 *  @param target   The new value to try and reach, in place of any target. An override
+		 *                  direction stays in force.
+		 */
+		void setTargetValue( const T & target )
+		{
+			mTargetValue = target;
+			mHasTargetValue = true;
+		}
+
+		/**
+		 *  Replaces the target with a direction. This also turns off any override direction,
+		 *  so a value target set afterwards is approached the shortest way.
+		 *
+		 *  @param target   The new constant direction to travel in
+		 */
+		void setTargetDirection( OverRated::ConstDirection target )
+		{
+			mTargetDir = target;
+			mHasTargetValue = false;
+			mIsOverrideEnabled = false;
+		}
+
+		/**
+		 *  Changes the rate and the value target together
+		 *
+		 *  @param rate     The new rate (magnitude is used)
+		 *  @param target   The value to try and reach
+		 */
+		void retarget( const T & rate, const T & target )
+		{
+			setRate(rate);
+			setTargetValue(target);
+		}
+
+		/**
+		 *  @return   Whether a value target is always approached from one direction
+		 */
+		bool getIsOverrideEnabled() const { return mHasTargetValue && mIsOverrideEnabled; }
+
+		/**
+		 *  @return  Whether this is method has a target value AND has reached it.
+		 */
+		bool getIsFinished( const T & value ) const
+		{
+			return mHasTargetValue && value == mTargetValue;
+		}
+
+		/**
+		 *  @see UpdateMethod::updateValue()
+		 */
+		T updateValue( const T & value, const double & timeElapsed ) const
+		{
+			T magnitude( mRate * timeElapsed );
+
+			if( !mHasTargetValue )
+				return OverRated::StepLoopedInDirection(value, mTargetDir, magnitude, mMin, mMax);
+
+			if( mIsOverrideEnabled )
+				return OverRated::StepLoopedToValue(value, mTargetValue, magnitude, mMin, mMax,
+						mTargetDir);
+
+			return OverRated::StepLoopedToValue(value, mTargetValue, magnitude, mMin, mMax);
+		}
+
+		/**
+		 *  @see UpdateMethodLooped::evaluateAt()
+		 */
+		T evaluateAt( const T & startValue, double time ) const
+		{
+			T magnitude( mRate * time );
+			T original( startValue );
+
+			OverRated::StepLoopedWrap(original, mMin, mMax);
+
+			if( !mHasTargetValue )
+				return OverRated::StepLoopedWrapLaps(
+						OverRated::StepApplyDirection(original, mTargetDir, magnitude), mMin, mMax);
+
+			if( getIsFinished(startValue) )
+				return startValue;
+
+			OverRated::ConstDirection dir = _getBestDirection(original);
+
+			if( !(magnitude < OverRated::StepLoopedDistance(original, mTargetValue, dir,
+					mMin, mMax)) )
+				return mTargetValue;
+
+			return OverRated::StepLoopedWrapLaps(
+					OverRated::StepApplyDirection(original, dir, magnitude), mMin, mMax);
+		}
+
+		/**
+		 *  @see UpdateMethodLooped::timeToFinish()
+		 */
+		double timeToFinish( const T & startValue ) const
+		{
+			T original( startValue );
+
+			if( !mHasTargetValue )
+				return -1.0;
+
+			if( getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(mRate > 0) )
+				return -1.0;
+
+			OverRated::StepLoopedWrap(original, mMin, mMax);
+
+			return double(OverRated::StepLoopedDistance(original, mTargetValue,
+					_getBestDirection(original), mMin, mMax)) / double(mRate);
+		}
+
+	private:
+		/**
+		 *  @param value   The value to move
+		 *  @return        The direction the value would be moved towards the target in
+		 */
+		OverRated::ConstDirection _getBestDirection( const T & value ) const
+		{
+			if( mIsOverrideEnabled )
+				return mTargetDir;
+
+			return OverRated::StepLoopedDirection(value, mTargetValue, mMin, mMax);
+		}
+
+	private:
+		T mRate;								// Rate of change, per second
+		T mTargetValue;							// Value target, if mHasTargetValue
+		T mMin;									// Minimum of the looping range
+		T mMax;									// Maximum of the looping range
+		OverRated::ConstDirection mTargetDir;	// Directional target, or the override
+		bool mHasTargetValue;					// Which kind of target this is
+		bool mIsOverrideEnabled;				// Whether mTargetDir overrides a value target
+	};
+}
+
+#endif // OVERRATED_STATICUPDATEMETHOD_H_DEFINED__
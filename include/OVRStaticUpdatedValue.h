@@ -0,0 +1,202 @@
+/**
+ *	StaticUpdatedValue Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_STATICUPDATEDVALUE_H_DEFINED__
+#define OVERRATED_STATICUPDATEDVALUE_H_DEFINED__
+
+#include "OVRStaticUpdateMethod.h"
+
+namespace OverRated
+{
+	/**
+	 *  Storage policy for StaticUpdatedValue which keeps its own copy of the value, in the way
+	 *  UpdatedValueBasic does.
+	 */
+	template <typename T>
+	class StaticStorageBasic
+	{
+	public:
+		/**
+		 *  @param initValue   Initializes the stored value
+		 */
+		StaticStorageBasic( const T & initValue ) : mVar(initValue) {}
+
+		T get() const { return mVar; }
+		void set( const T & value ) { mVar = value; }
+
+	private:
+		T mVar;	// The contained, updated value
+	};
+
+	/**
+	 *  Storage policy for StaticUpdatedValue which updates a variable kept somewhere else, in
+	 *  the way UpdatedValueRef does. The variable must outlive the value.
+	 */
+	template <typename T>
+	class StaticStorageRef
+	{
+	public:
+		/**
+		 *  @param var   The variable to update
+		 */
+		StaticStorageRef( T & var ) : mVar(&var) {}
+
+		T get() const { return *mVar; }
+		void set( const T & value ) { *mVar = value; }
+
+	private:
+		T * mVar;	// The referenced, updated value
+	};
+
+	/**
+	 *  A value updated over time like UpdatedValue, but with where the value lives (Storage) and
+	 *  how it changes (Method) chosen at compile time rather than through virtual calls, so an
+	 *  update can be inlined completely into the loop that drives it. The cost is that these
+	 *  can't be mixed in an UpdatedObjectList with other kinds of object; keep them in a plain
+	 *  array of one type and call addTime() on each.
+	 *
+	 *  Storage is StaticStorageBasic or StaticStorageRef, or anything with the same get() and
+	 *  set(). Method is StaticMethodLinear or StaticMethodLooped, or anything with the same
+	 *  getIsFinished() and updateValue(). For example:
+	 *
+	 *      StaticUpdatedValue< float, StaticStorageBasic<float>, StaticMethodLinear<float> >
+	 *          value(0.0f, StaticMethodLinear<float>(2.0f, 10.0f));
+	 */
+	template <typename T, class Storage, class Method>
+	class StaticUpdatedValue
+	{
+	public:
+		/**
+		 *  Constructor
+		 *
+		 *  @param storage   Initializes the storage, such as with a value or a variable
+		 *  @param method    The method to update with. A copy is kept.
+		 */
+		StaticUpdatedValue( const Storage & storage, const Method & method )
+		: mStorage(storage), mMethod(method), mIsPaused(false)
+		{
+			// Adjust any invalid initial setting
+			_addTime(0.0);
+		}
+
+		/**
+		 *  If unpaused, add the elapsed time in seconds
+		 *
+		 *  @param timeElapsed   Amount of time that has passed in seconds (1.0 = 1 sec)
+		 */
+		void addTime( double timeElapsed )
+		{
+			if( !mIsPaused )
+				_addTime(timeElapsed);
+		}
+
+		/**
+		 *  @return   The value being updated, at its current state
+		 */
+		T getValue() const
+		{
+			return mStorage.get();
+		}
+
+		/**
+		 *  @param value   The value to apply
+		 */
+		void setValue( const T & value )
+		{
+			mStorage.set(value);
+		}
+
+		/**
+		 *  Replaces the method with a copy of another
+		 *
+		 *  @param method   The method to use from now on
+		 */
+		void setMethod( const Method & method )
+		{
+			mMethod = method;
+			_addTime(0.0);
+		}
+
+		/**
+		 *  @return   The method in use. Changes to it apply from the next update.
+		 */
+		Method & getMethod()
+		{
+			return mMethod;
+		}
+
+		/**
+		 *  @return   The method in use
+		 */
+		const Method & getMethod() const
+		{
+			return mMethod;
+		}
+
+		/**
+		 *  @returns   Whether or not this is currently updating a value
+		 */
+		bool getIsUpdating() const
+		{
+			return !mMethod.getIsFinished(mStorage.get());
+		}
+
+		/**
+		 *  @return   The pause state
+		 */
+		bool getIsPaused() const
+		{
+			return mIsPaused;
+		}
+
+		/**
+		 *  @param paused   Whether to pause(true) or unpause(false)
+		 */
+		void setIsPaused( bool paused )
+		{
+			mIsPaused = paused;
+		}
+
+	private:
+		/**
+		 *  @param timeElapsed   Amount of time that has passed in seconds (1.0 = 1 sec)
+		 */
+		void _addTime( const double & timeElapsed )
+		{
+			T value = mStorage.get();
+
+			if( !mMethod.getIsFinished(value) )
+				mStorage.set(mMethod.updateValue(value, timeElapsed));
+		}
+
+	private:
+		Storage mStorage;	// Where the value lives
+		Method mMethod;		// How the value changes
+		bool mIsPaused;		// Whether updates are ignored
+	};
+}
+
+#endif // OVERRATED_STATICUPDATEDVALUE_H_DEFINED__
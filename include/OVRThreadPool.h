@@ -0,0 +1,299 @@
+/**
+ *	ThreadPool Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_THREADPOOL_H_DEFINED__
+#define OVERRATED_THREADPOOL_H_DEFINED__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OverRated
+{
+	/**
+	 *  A set of worker threads for splitting an update across cores. Work is handed out as
+	 *  ranges of indices; each worker keeps its own queue of ranges and steals from the others
+	 *  once its own runs dry, so uneven ranges still keep every thread busy.
+	 *
+	 *  The pool is meant to be created once and reused for every update. The thread which calls
+	 *  parallelFor() works on the ranges too, and so does any worker waiting on a nested
+	 *  parallelFor(), which means lists of lists can share one pool without deadlocking.
+	 */
+	class ThreadPool
+	{
+	public:
+		/**
+		 *  Constructor. Starts the worker threads, which sleep until there is work.
+		 *
+		 *  @param workerCount   Number of threads to start in addition to the caller's. By
+		 *                       default, one less than the number of hardware threads.
+		 */
+		explicit ThreadPool( unsigned workerCount = _getDefaultWorkerCount() )
+		: mPending(0), mStopping(false)
+		{
+			// Queue 0 is shared by threads outside the pool; each worker has its own after that
+			for( unsigned i = 0; i <= workerCount; i++ )
+				mQueues.push_back(new Queue());
+
+			for( unsigned i = 0; i < workerCount; i++ )
+				mWorkers.push_back(std::thread(&ThreadPool::_work, this, i + 1));
+		}
+
+		/**
+		 *  Stops and joins the worker threads. There must be no parallelFor() in progress.
+		 */
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mSleepMutex);
+				mStopping = true;
+			}
+			mWake.notify_all();
+
+			for( unsigned i = 0; i < mWorkers.size(); i++ )
+				mWorkers[i].join();
+
+			for( unsigned i = 0; i < mQueues.size(); i++ )
+				delete mQueues[i];
+		}
+
+		/**
+		 *  @return   Number of worker threads, not counting callers
+		 */
+		unsigned getWorkerCount() const
+		{
+			return mWorkers.size();
+		}
+
+		/**
+		 *  Calls function(begin, end) over consecutive ranges covering 0 to count, spread across
+		 *  the pool, and returns once every range has been processed. Ranges are 'grain' indices
+		 *  long, apart from possibly the last.
+		 *
+		 *  @param count      Number of indices to cover
+		 *  @param grain      Number of indices in each range
+		 *  @param function   Anything callable as function(unsigned begin, unsigned end)
+		 */
+		template <typename F>
+		void parallelFor( unsigned count, unsigned grain, const F & function )
+		{
+			if( count == 0 )
+				return;
+
+			if( grain == 0 )
+				grain = 1;
+
+			unsigned chunks = (count + grain - 1) / grain;
+
+			if( chunks == 1 || mWorkers.empty() ) {
+				function(0u, count);
+				return;
+			}
+
+			Job job;
+			job.run = &ThreadPool::_runFunction<F>;
+			job.context = &function;
+			job.remaining.store(chunks);
+
+			{
+				std::lock_guard<std::mutex> lock(mSleepMutex);
+				mPending.fetch_add(chunks);
+			}
+
+			// Deal the ranges out across every queue so that most of them are found without
+			// stealing
+			unsigned first = _getQueueIndex();
+
+			for( unsigned q = 0; q < mQueues.size(); q++ ) {
+				Queue & queue = *mQueues[(first + q) % mQueues.size()];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				for( unsigned c = q; c < chunks; c += mQueues.size() ) {
+					unsigned begin = c * grain;
+					unsigned end = (count - begin > grain) ? begin + grain : count;
+
+					queue.tasks.push_back(Task(&job, begin, end));
+				}
+			}
+
+			mWake.notify_all();
+
+			// Help out until our own job is done
+			while( job.remaining.load(std::memory_order_acquire) != 0 ) {
+				if( !_runOne(first) )
+					std::this_thread::yield();
+			}
+		}
+
+	private:
+		// One call to parallelFor()
+		struct Job
+		{
+			void (*run)( const void * context, unsigned begin, unsigned end );
+			const void * context;
+			std::atomic<unsigned> remaining;	// Ranges not yet finished
+		};
+
+		// One range of a job
+		struct Task
+		{
+			Task( Job * job, unsigned begin, unsigned end )
+			: job(job), begin(begin), end(end)
+			{}
+
+			Job * job;
+			unsigned begin;
+			unsigned end;
+		};
+
+		// A queue of ranges, padded so that neighbouring queues don't share a cache line
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+			char padding[64];
+		};
+
+		static unsigned _getDefaultWorkerCount()
+		{
+			unsigned hardware = std::thread::hardware_concurrency();
+
+			return (hardware > 1) ? hardware - 1 : 0;
+		}
+
+		template <typename F>
+		static void _runFunction( const void * context, unsigned begin, unsigned end )
+		{
+			(*static_cast<const F *>(context))(begin, end);
+		}
+
+		/**
+		 *  The queue the calling thread should use. Workers have their own; anyone else shares
+		 *  queue 0.
+		 */
+		unsigned _getQueueIndex() const
+		{
+			const ThreadPool * pool = _currentPool();
+
+			return (pool == this) ? _currentQueue() : 0;
+		}
+
+		static const ThreadPool * & _currentPool()
+		{
+			static thread_local const ThreadPool * pool = 0;
+			return pool;
+		}
+
+		static unsigned & _currentQueue()
+		{
+			static thread_local unsigned queue = 0;
+			return queue;
+		}
+
+		/**
+		 *  Runs a single range, taking it from the back of our own queue if there is one there
+		 *  and stealing from the front of another queue if not.
+		 *
+		 *  @param own   Index of the calling thread's queue
+		 *  @return      Whether anything was run
+		 */
+		bool _runOne( unsigned own )
+		{
+			Task task(0, 0, 0);
+			bool found = false;
+
+			{
+				Queue & queue = *mQueues[own];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if( !queue.tasks.empty() ) {
+					task = queue.tasks.back();
+					queue.tasks.pop_back();
+					found = true;
+				}
+			}
+
+			for( unsigned q = 1; !found && q < mQueues.size(); q++ ) {
+				Queue & queue = *mQueues[(own + q) % mQueues.size()];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if( !queue.tasks.empty() ) {
+					task = queue.tasks.front();
+					queue.tasks.pop_front();
+					found = true;
+				}
+			}
+
+			if( !found )
+				return false;
+
+			mPending.fetch_sub(1);
+			task.job->run(task.job->context, task.begin, task.end);
+			task.job->remaining.fetch_sub(1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 *  Worker thread body; runs ranges until there are none, then sleeps.
+		 *
+		 *  @param queue   Index of this worker's queue
+		 */
+		void _work( unsigned queue )
+		{
+			_currentPool() = this;
+			_currentQueue() = queue;
+
+			for( ;; ) {
+				if( _runOne(queue) )
+					continue;
+
+				std::unique_lock<std::mutex> lock(mSleepMutex);
+
+				while( mPending.load() == 0 && !mStopping )
+					mWake.wait(lock);
+
+				if( mStopping )
+					return;
+			}
+		}
+
+	private:
+		ThreadPool( const ThreadPool & );
+		ThreadPool & operator=( const ThreadPool & );
+
+		std::vector<Queue*> mQueues;			// Queue 0 for outsiders, then one per worker
+		std::vector<std::thread> mWorkers;		// The worker threads
+		std::atomic<unsigned> mPending;			// Ranges queued but not yet started
+		bool mStopping;							// Set when the pool is being destroyed
+		std::mutex mSleepMutex;					// Guards sleeping and waking
+		std::condition_variable mWake;			// Signalled when work is queued or on stop
+	};
+}
+
+#endif // OVERRATED_THREADPOOL_H_DEFINED__
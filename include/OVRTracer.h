@@ -0,0 +1,270 @@
+/**
+ *	Tracer Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_TRACER_H_DEFINED__
+#define OVERRATED_TRACER_H_DEFINED__
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace OverRated
+{
+	/**
+	 *  Records how long each update of each UpdatedObjectList takes, so that the time spent in
+	 *  lists of lists can be looked at afterwards. While a tracer is installed
+	 *  ( @see TraceSetTracer() ), every list update adds a span with the list's name, size and
+	 *  number of active items. Spans go into a fixed-size ring buffer which any number of
+	 *  threads can add to without locking; once it is full, the oldest spans are overwritten.
+	 *  writeJson() dumps the buffer in the Chrome trace event format, which chrome://tracing and
+	 *  Perfetto can open.
+	 *
+	 *  With no tracer installed, a list update costs one extra branch.
+	 */
+	class Tracer
+	{
+	public:
+		/**
+		 *  Constructor
+		 *
+		 *  @param capacity   Number of spans to keep, rounded up to a power of two
+		 */
+		explicit Tracer( unsigned capacity = 65536 )
+		: mStart(std::chrono::steady_clock::now()), mSpans(_roundUp(capacity)), mNext(0)
+		{}
+
+		/**
+		 *  @return   Nanoseconds since the tracer was made
+		 */
+		unsigned long long now() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - mStart).count();
+		}
+
+		/**
+		 *  Adds a span to the buffer. Safe to call from any thread.
+		 *
+		 *  @param name     What the span is of. Only the pointer is kept, so the string must
+		 *                  last until the buffer has been written.
+		 *  @param begin    When the span began ( @see now() )
+		 *  @param size     Number of items in the list
+		 *  @param active   Number of them which were active
+		 */
+		void record( const char * name, unsigned long long begin, unsigned size, unsigned active )
+		{
+			unsigned long long end = now();
+			unsigned long long position = mNext.fetch_add(1, std::memory_order_relaxed);
+			Span & span = mSpans[position & (mSpans.size() - 1)];
+
+			// Readers ignore a span whose sequence changes while they copy it. Each field is
+			// released so that none of them can be seen before the sequence is cleared.
+			span.sequence.store(0, std::memory_order_relaxed);
+			span.name.store(name, std::memory_order_release);
+			span.begin.store(begin, std::memory_order_release);
+			span.duration.store(end - begin, std::memory_order_release);
+			span.size.store(size, std::memory_order_release);
+			span.active.store(active, std::memory_order_release);
+			span.thread.store(_TraceThreadId(), std::memory_order_release);
+
+			span.sequence.store(position + 1, std::memory_order_release);
+		}
+
+		/**
+		 *  Forgets every span recorded so far. Spans being recorded at the same time may be
+		 *  kept or lost.
+		 */
+		void clear()
+		{
+			for( unsigned i = 0; i < mSpans.size(); i++ )
+				mSpans[i].sequence.store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 *  Writes the spans in the buffer, oldest first, as a Chrome trace event JSON document.
+		 *  This may be called while spans are still being recorded; any which are caught half
+		 *  written are left out.
+		 *
+		 *  @param out   Where to write
+		 */
+		void writeJson( std::ostream & out ) const
+		{
+			unsigned long long next = mNext.load(std::memory_order_acquire);
+			unsigned long long first = (next > mSpans.size()) ? next - mSpans.size() : 0;
+			bool comma = false;
+
+			out << "{\"traceEvents\":[";
+
+			for( unsigned long long position = first; position < next; position++ ) {
+				const Span & span = mSpans[position & (mSpans.size() - 1)];
+
+				if( span.sequence.load(std::memory_order_acquire) != position + 1 )
+					continue;
+
+				// Acquiring each field keeps the second look at the sequence after them all
+				const char * name = span.name.load(std::memory_order_acquire);
+				unsigned long long begin = span.begin.load(std::memory_order_acquire);
+				unsigned long long duration = span.duration.load(std::memory_order_acquire);
+				unsigned size = span.size.load(std::memory_order_acquire);
+				unsigned active = span.active.load(std::memory_order_acquire);
+				unsigned thread = span.thread.load(std::memory_order_acquire);
+
+				if( span.sequence.load(std::memory_order_relaxed) != position + 1 )
+					continue;
+
+				out << (comma ? ",\n" : "\n") << "{\"name\":\"";
+				_writeEscaped(out, name);
+				out << "\",\"cat\":\"OverRated\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+					<< ",\"ts\":";
+				_writeMicroseconds(out, begin);
+				out << ",\"dur\":";
+				_writeMicroseconds(out, duration);
+				out << ",\"args\":{\"size\":" << size << ",\"active\":" << active << "}}";
+				comma = true;
+			}
+
+			out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+		}
+
+	private:
+		// One recorded span. Every field is atomic so that writing the buffer while spans are
+		// being recorded is well defined; a span is only used if its sequence is its position
+		// in the buffer plus one, both before and after it is read.
+		struct Span
+		{
+			Span()
+			: sequence(0), name(0), begin(0), duration(0), size(0), active(0), thread(0)
+			{}
+
+			Span( const Span & )
+			: sequence(0), name(0), begin(0), duration(0), size(0), active(0), thread(0)
+			{}
+
+			std::atomic<unsigned long long> sequence;
+			std::atomic<const char *> name;
+			std::atomic<unsigned long long> begin;
+			std::atomic<unsigned long long> duration;
+			std::atomic<unsigned> size;
+			std::atomic<unsigned> active;
+			std::atomic<unsigned> thread;
+		};
+
+		/**
+		 *  @return   The smallest power of two no less than a number
+		 */
+		static unsigned _roundUp( unsigned number )
+		{
+			unsigned size = 1;
+
+			while( size < number )
+				size *= 2;
+
+			return size;
+		}
+
+		/**
+		 *  @return   A small number which identifies the calling thread
+		 */
+		static unsigned _TraceThreadId()
+		{
+			static std::atomic<unsigned> next_id(0);
+			static thread_local unsigned id = next_id.fetch_add(1, std::memory_order_relaxed);
+
+			return id;
+		}
+
+		/**
+		 *  Writes a number of nanoseconds as microseconds, with three decimal places
+		 */
+		static void _writeMicroseconds( std::ostream & out, unsigned long long nanoseconds )
+		{
+			char fill = out.fill('0');
+
+			out << (nanoseconds / 1000) << '.' << std::setw(3) << (nanoseconds % 1000);
+			out.fill(fill);
+		}
+
+		/**
+		 *  Writes a string with anything JSON can't hold as it is escaped
+		 */
+		static void _writeEscaped( std::ostream & out, const char * text )
+		{
+			static const char hex[] = "0123456789abcdef";
+
+			for( ; text && *text; text++ ) {
+				unsigned char c = static_cast<unsigned char>(*text);
+
+				if( c == '"' || c == '\\' )
+					out << '\\' << *text;
+				else if( c < 0x20 )
+					out << "\\u00" << hex[c >> 4] << hex[c & 15];
+				else
+					out << *text;
+			}
+		}
+
+	private:
+		std::chrono::steady_clock::time_point mStart;	// Time zero for spans
+		std::vector<Span> mSpans;						// The ring buffer
+		std::atomic<unsigned long long> mNext;			// Position of the next span recorded
+
+		Tracer( const Tracer & );
+		Tracer & operator=( const Tracer & );
+	};
+
+	/**
+	 *  Storage for the tracer in use
+	 */
+	inline std::atomic<OverRated::Tracer *> & _TraceTracer()
+	{
+		static std::atomic<OverRated::Tracer *> tracer(0);
+		return tracer;
+	}
+
+	/**
+	 *  @return   The tracer list updates are recorded to (warning: can be NULL!)
+	 */
+	inline OverRated::Tracer * TraceGetTracer()
+	{
+		return OverRated::_TraceTracer().load(std::memory_order_acquire);
+	}
+
+	/**
+	 *  Starts or stops recording list updates. Lists already part way through an update when
+	 *  this is called may still record to the previous tracer, so don't destroy a tracer until
+	 *  updates have finished after removing it.
+	 *
+	 *  @param tracer   The tracer to record to, or NULL to stop recording
+	 */
+	inline void TraceSetTracer( OverRated::Tracer * tracer )
+	{
+		OverRated::_TraceTracer().store(tracer, std::memory_order_release);
+	}
+}
+
+#endif // OVERRATED_TRACER_H_DEFINED__
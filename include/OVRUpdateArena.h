@@ -0,0 +1,378 @@
+/**
+ *	UpdateArena Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEARENA_H_DEFINED__
+#define OVERRATED_UPDATEARENA_H_DEFINED__
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "OVRHandle.h"
+
+namespace OverRated
+{
+	/**
+	 *  A handle to an object of type T in an UpdateArena. It's an ordinary Handle which only
+	 *  the arena's pool of T's will accept, so it can't be used to look up the wrong type.
+	 */
+	template <typename T>
+	struct ArenaHandle : public OverRated::Handle
+	{
+		ArenaHandle() {}
+
+		ArenaHandle( unsigned slot, unsigned generation )
+		: OverRated::Handle(slot, generation)
+		{}
+	};
+
+	/**
+	 *  Owns values, methods, lists and anything else that's short-lived and made in numbers, so
+	 *  the caller doesn't have to new and delete each one. Each type gets its own pool, which
+	 *  hands out the next unused slot in blocks of BLOCK_SIZE objects, so objects of a type made
+	 *  one after the other sit next to each other in memory and a list of them is walked in
+	 *  order. Objects never move once made, so pointers to them, as held by lists and values,
+	 *  stay good until they are destroyed.
+	 *
+	 *  Destroyed slots are reused. Every object made by a pool gets a new generation, so a
+	 *  handle to something destroyed is stale rather than referring to whatever replaced it.
+	 *
+	 *  reset() destroys everything at once, as at the end of a level. The pools simply start
+	 *  handing out slots from the beginning again, so for types with nothing to destroy (plain
+	 *  structs, for instance) it's O(1) however many objects there were. Types with destructors
+	 *  still have them run, because an UpdatedValue must take itself out of any lists it was
+	 *  added to.
+	 *
+	 *  An arena is not thread safe, and it can't be copied.
+	 */
+	class UpdateArena
+	{
+	public:
+		enum { BLOCK_SIZE = 64 };	// Objects per block of a pool
+
+		UpdateArena() {}
+
+		/**
+		 *  Destroys everything still in the arena
+		 */
+		~UpdateArena()
+		{
+			reset();
+
+			for( unsigned i = 0; i < mPools.size(); i++ )
+				delete mPools[i];
+		}
+
+		/**
+		 *  Makes a new object, passing any arguments to its constructor
+		 *
+		 *  @param args   The constructor arguments
+		 *  @return       A handle to the new object
+		 */
+		template <typename T, typename... Args>
+		OverRated::ArenaHandle<T> create( Args &&... args )
+		{
+			return _getPool<T>().create(std::forward<Args>(args)...);
+		}
+
+		/**
+		 *  @param handle   Handle of the object
+		 *  @return         The object, or 0 if the handle is stale
+		 */
+		template <typename T>
+		T * get( const OverRated::ArenaHandle<T> & handle ) const
+		{
+			const Pool<T> * pool = _findPool<T>();
+
+			return pool ? pool->get(handle) : 0;
+		}
+
+		/**
+		 *  @param handle   Handle of the object
+		 *  @return         Whether the object still exists
+		 */
+		template <typename T>
+		bool contains( const OverRated::ArenaHandle<T> & handle ) const
+		{
+			return get(handle) != 0;
+		}
+
+		/**
+		 *  Destroys a single object and frees its slot. Stale handles are ignored.
+		 *
+		 *  @param handle   Handle of the object
+		 */
+		template <typename T>
+		void destroy( const OverRated::ArenaHandle<T> & handle )
+		{
+			Pool<T> * pool = _findPool<T>();
+
+			if( pool )
+				pool->destroy(handle);
+		}
+
+		/**
+		 *  Pre-allocates room for a number of objects of a type
+		 *
+		 *  @param capacity   The number of objects to make room for
+		 */
+		template <typename T>
+		void reserve( unsigned capacity )
+		{
+			_getPool<T>().reserve(capacity);
+		}
+
+		/**
+		 *  @return   How many objects of a type exist
+		 */
+		template <typename T>
+		unsigned getCount() const
+		{
+			const Pool<T> * pool = _findPool<T>();
+
+			return pool ? pool->getCount() : 0;
+		}
+
+		/**
+		 *  Destroys every object in the arena, keeping the memory for reuse. Handles to them
+		 *  all become stale. Types are destroyed in the reverse of the order they were first
+		 *  made in, and objects of a type in the reverse of the order of their slots.
+		 */
+		void reset()
+		{
+			for( unsigned i = mOrder.size(); i > 0; i-- )
+				mOrder[i - 1]->reset();
+		}
+
+	private:
+		UpdateArena( const UpdateArena & );
+		UpdateArena & operator=( const UpdateArena & );
+
+		// What reset() and the destructor need from a pool of any type
+		class PoolBase
+		{
+		public:
+			virtual ~PoolBase() {}
+			virtual void reset() = 0;
+		};
+
+		// The objects of one type, in blocks which never move
+		template <typename T>
+		class Pool : public PoolBase
+		{
+		public:
+			Pool()
+			: mUsed(0), mFree(NO_SLOT), mCount(0), mNextGeneration(0)
+			{}
+
+			~Pool()
+			{
+				for( unsigned i = 0; i < mBlocks.size(); i++ )
+					delete mBlocks[i];
+			}
+
+			template <typename... Args>
+			OverRated::ArenaHandle<T> create( Args &&... args )
+			{
+				unsigned slot;
+
+				// Reuse a destroyed slot first, otherwise take the next one never used
+				if( mFree != NO_SLOT )
+					slot = mFree;
+				else {
+					slot = mUsed;
+
+					if( slot == mBlocks.size() * BLOCK_SIZE )
+						mBlocks.push_back(new Block);
+				}
+
+				Block & block = _getBlock(slot);
+				unsigned offset = slot % BLOCK_SIZE;
+
+				new (&block.objects[offset]) T(std::forward<Args>(args)...);
+
+				if( slot == mFree )
+					mFree = block.nextFree[offset];
+				else
+					mUsed++;
+
+				// Generation 0 marks a free slot
+				if( ++mNextGeneration == 0 )
+					mNextGeneration = 1;
+
+				block.generations[offset] = mNextGeneration;
+				mCount++;
+
+				return OverRated::ArenaHandle<T>(slot, mNextGeneration);
+			}
+
+			T * get( const OverRated::ArenaHandle<T> & handle ) const
+			{
+				if( handle.slot >= mUsed || handle.generation == 0 )
+					return 0;
+
+				Block & block = _getBlock(handle.slot);
+				unsigned offset = handle.slot % BLOCK_SIZE;
+
+				if( block.generations[offset] != handle.generation )
+					return 0;
+
+				return block.getObject(offset);
+			}
+
+			void destroy( const OverRated::ArenaHandle<T> & handle )
+			{
+				T * object = get(handle);
+
+				if( !object )
+					return;
+
+				Block & block = _getBlock(handle.slot);
+				unsigned offset = handle.slot % BLOCK_SIZE;
+
+				object->~T();
+				block.generations[offset] = 0;
+				block.nextFree[offset] = mFree;
+				mFree = handle.slot;
+				mCount--;
+			}
+
+			void reserve( unsigned capacity )
+			{
+				while( mBlocks.size() * BLOCK_SIZE < capacity )
+					mBlocks.push_back(new Block);
+			}
+
+			unsigned getCount() const
+			{
+				return mCount;
+			}
+
+			void reset()
+			{
+				// Slots past mUsed count as unused whatever they hold, so for a type with
+				// nothing to destroy, forgetting them is enough
+				if( !std::is_trivially_destructible<T>::value ) {
+					for( unsigned i = mUsed; i > 0; i-- ) {
+						Block & block = _getBlock(i - 1);
+						unsigned offset = (i - 1) % BLOCK_SIZE;
+
+						if( block.generations[offset] != 0 ) {
+							block.getObject(offset)->~T();
+							block.generations[offset] = 0;
+						}
+					}
+				}
+
+				mUsed = 0;
+				mFree = NO_SLOT;
+				mCount = 0;
+			}
+
+		private:
+			enum { NO_SLOT = ~0u };
+
+			// Room for BLOCK_SIZE objects, packed together with the bookkeeping kept apart. A
+			// live slot has a generation; a free one is on the free list.
+			struct Block
+			{
+				typename std::aligned_storage<sizeof(T), alignof(T)>::type objects[BLOCK_SIZE];
+				unsigned generations[BLOCK_SIZE];
+				unsigned nextFree[BLOCK_SIZE];
+
+				T * getObject( unsigned offset )
+				{
+					return reinterpret_cast<T *>(&objects[offset]);
+				}
+			};
+
+			Block & _getBlock( unsigned slot ) const
+			{
+				return *mBlocks[slot / BLOCK_SIZE];
+			}
+
+			std::vector<Block *> mBlocks;	// Blocks of BLOCK_SIZE slots
+			unsigned mUsed;					// Slots handed out since the last reset
+			unsigned mFree;					// First destroyed slot to reuse, or NO_SLOT
+			unsigned mCount;				// Live objects
+			unsigned mNextGeneration;		// Generation of the last object made
+		};
+
+		/**
+		 *  Every type used with any arena gets a small number, so that finding its pool is
+		 *  just an index
+		 */
+		static unsigned _newTypeIndex()
+		{
+			static std::atomic<unsigned> next(0);
+			return next++;
+		}
+
+		template <typename T>
+		static unsigned _getTypeIndex()
+		{
+			static const unsigned index = _newTypeIndex();
+			return index;
+		}
+
+		/**
+		 *  @return   The pool for a type, or 0 if nothing of that type was ever made
+		 */
+		template <typename T>
+		Pool<T> * _findPool() const
+		{
+			unsigned index = _getTypeIndex<T>();
+
+			return (index < mPools.size()) ? static_cast<Pool<T> *>(mPools[index]) : 0;
+		}
+
+		/**
+		 *  @return   The pool for a type, made if necessary
+		 */
+		template <typename T>
+		Pool<T> & _getPool()
+		{
+			unsigned index = _getTypeIndex<T>();
+
+			if( index >= mPools.size() )
+				mPools.resize(index + 1, 0);
+
+			if( !mPools[index] ) {
+				mPools[index] = new Pool<T>();
+				mOrder.push_back(mPools[index]);
+			}
+
+			return *static_cast<Pool<T> *>(mPools[index]);
+		}
+
+		std::vector<PoolBase *> mPools;		// Pool of each type, by type index; may be 0
+		std::vector<PoolBase *> mOrder;		// Pools in the order they were made
+	};
+}
+
+#endif // OVERRATED_UPDATEARENA_H_DEFINED__
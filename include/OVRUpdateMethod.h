@@ -27,11 +27,16 @@
 #ifndef OVERRATED_UPDATEMETHOD_H_DEFINED__
 #define OVERRATED_UPDATEMETHOD_H_DEFINED__
 
+#include <vector>
+
 #include "OVRUtils.h"
+#include "OVRCounters.h"
 #include "assert.h"
 
 namespace OverRated
 {
+	template <typename T> class UpdatedValue;
+
 	// Used to specify the two possible directions of change for a value
 	enum ConstDirection
 	{
@@ -43,6 +48,15 @@ namespace OverRated
 	 *  Used by UpdatedValue's to decide how a value should respond to each update. Based on a
 	 *  given rate, they move the value gradually on each update in the direction (+ or -) of a
 	 *  given target, which is either a specific value or an infinite constant direction.
+	 *
+	 *  Updating a value only reads the method, so one method may be shared by values that are
+	 *  updated on different threads, as long as nothing changes it (setRate() and so on) while
+	 *  they are being updated. Subclasses which keep state of their own must say otherwise.
+	 *
+	 *  A method keeps track of the UpdatedValue's using it, so that giving it a new target
+	 *  wakes every one of them, and so that destroying it leaves them with no method rather than
+	 *  a dangling one. Because of this, values sharing a method must not be given methods
+	 *  ( @see UpdatedValue::setMethod() ) on different threads at the same time.
 	 */
 	template <typename T>
 	class UpdateMethod
@@ -63,7 +77,8 @@ namespace OverRated
 		 *  @param target   The constant direction to travel in
 		 */
 		UpdateMethod( const T & rate, OverRated::ConstDirection target )
-		: mTargetType(T_DIRECTION), mTargetValue(0), mTargetDir(target), mRate(rate)
+		: mTargetType(T_DIRECTION), mTargetValue(0), mTargetDir(target), mRate(rate),
+		  mHasOwnStep(false)
 		{}
 
 		/**
@@ -73,13 +88,45 @@ namespace OverRated
 		 *  @param target   The value to try and reach
 		 */
 		UpdateMethod( const T & rate, const T & target )
-		: mTargetType(T_VALUE), mTargetValue(target), mRate(rate)
+		: mTargetType(T_VALUE), mTargetValue(target), mTargetDir(OverRated::CD_INCREASING),
+		  mRate(rate), mHasOwnStep(false)
+		{}
+
+		/**
+		 *  Copies the target and rate. The copy starts out with no values using it.
+		 */
+		UpdateMethod( const UpdateMethod & other )
+		: mTargetType(other.mTargetType), mTargetValue(other.mTargetValue),
+		  mTargetDir(other.mTargetDir), mRate(other.mRate), mHasOwnStep(other.mHasOwnStep)
 		{}
 
-		virtual ~UpdateMethod() {}
+		/**
+		 *  Destruction leaves any values still using this method with no method
+		 */
+		virtual ~UpdateMethod()
+		{
+			for( unsigned i = 0; i < mUsers.size(); i++ )
+				mUsers[i]->mUpdateMethod = 0;
+		}
 
 		/**
-		 *  The rate may be changed at any time using this setter
+		 *  Copies the target and rate, and wakes the values using this method. Values using the
+		 *  other method are not affected.
+		 */
+		UpdateMethod & operator=( const UpdateMethod & other )
+		{
+			mTargetType = other.mTargetType;
+			mTargetValue = other.mTargetValue;
+			mTargetDir = other.mTargetDir;
+			mRate = other.mRate;
+			_wakeUsers();
+			return *this;
+		}
+
+		/**
+		 *  The rate may be changed at any time using this setter. Values using this method are
+		 *  not woken, as any which had stopped are at the target, where the rate doesn't move
+		 *  them.
 		 *
 		 *  @param rate  The new rate
 		 */
@@ -122,9 +169,70 @@ namespace OverRated
 			return mTargetDir;
 		}
 
+		/**
+		 *  Gives this method a new value target in place of whatever target it had, and wakes
+		 *  every value using it so that any which had stopped carry on towards the new target.
+		 *
+		 *  @param target   The value to try and reach
+		 */
+		void setTargetValue( const T & target )
+		{
+			mTargetType = T_VALUE;
+			mTargetValue = target;
+			_onRetarget();
+			_wakeUsers();
+		}
+
+		/**
+		 *  Gives this method a directional target in place of whatever target it had, and wakes
+		 *  every value using it. Only methods which can have a directional target to begin with
+		 *  support this ( @see _getCanTargetDirection() ); for the others it asserts, or does
+		 *  nothing if asserts are off.
+		 *
+		 *  @param target   The constant direction to travel in
+		 */
+		void setTargetDirection( OverRated::ConstDirection target )
+		{
+			assert( _getCanTargetDirection() );
+
+			if( !_getCanTargetDirection() )
+				return;
+
+			mTargetType = T_DIRECTION;
+			mTargetDir = target;
+			_onRetarget();
+			_wakeUsers();
+		}
+
+		/**
+		 *  Changes the rate and the value target together
+		 *
+		 *  @param rate     The new rate (magnitude is used)
+		 *  @param target   The value to try and reach
+		 */
+		void retarget( const T & rate, const T & target )
+		{
+			setRate(rate);
+			setTargetValue(target);
+		}
+
+		/**
+		 *  Changes the rate and the directional target together
+		 *
+		 *  @param rate     The new rate (magnitude is used)
+		 *  @param target   The constant direction to travel in
+		 */
+		void retarget( const T & rate, OverRated::ConstDirection target )
+		{
+			setRate(rate);
+			setTargetDirection(target);
+		}
+
 		/**
 		 *  Call with regular updates with a value to find out what it should be for the time
-		 *  elapsed.
+		 *  elapsed. This isn't virtual, so that the methods which move at a constant rate cost
+		 *  no more than their hooks below; subclasses which move some other way give their own
+		 *  step instead ( @see _step() ).
 		 *
 		 *  @param value        The value to update
 		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
@@ -132,53 +240,155 @@ namespace OverRated
 		 */
 		T updateValue( const T & value, const double & timeElapsed )
 		{
-			T original( value );					// Copy of the original value
-			OverRated::ConstDirection dir;			// Direction we'll change the value this time
-			T result( 0.0 );						// The result to return
-			T magnitude(getRate() * timeElapsed);	// The amount of change to apply (pos only)
+			if( mHasOwnStep )
+				return _step(value, timeElapsed);
 
-			assert( getHasTargetDirection() || getHasTargetValue() );
+			return _stepAtRate(value, timeElapsed);
+		}
 
-			// Make the value legal
-			_checkValue( original );
+		/**
+		 *  Works out where a value would be after a length of time without stepping through it.
+		 *  This default takes the whole time as a single update, which is only right for methods
+		 *  whose result doesn't depend on how the time is split up; subclasses that can do better
+		 *  should overload it.
+		 *
+		 *  @param startValue   The value at the start
+		 *  @param time         How much time passes, in seconds
+		 *  @return             The value after that time
+		 */
+		virtual T evaluateAt( const T & startValue, double time )
+		{
+			if( getIsFinished(startValue) )
+				return startValue;
 
-			result = original;
+			return updateValue(startValue, time);
+		}
 
-			// Get the target direction
-			if( getHasTargetValue() )
-				dir = _getBestDirection(value);
-			else
-				dir = getTargetDirection();
+		/**
+		 *  Works out where a value this method is updating will be after more time, carrying on
+		 *  with any transition the method has in progress for it. Methods which keep no such
+		 *  state give the same as evaluateAt(), which is this default.
+		 *
+		 *  @param value   The value as it is now
+		 *  @param time    How much more time passes, in seconds
+		 *  @return        The value after that time
+		 */
+		virtual T continueAt( const T & value, double time )
+		{
+			return evaluateAt(value, time);
+		}
 
-			// Apply the target direction
-			if( dir == OverRated::CD_INCREASING )
-				result += magnitude;
-			else
-				result -= magnitude;
+		/**
+		 *  Works out how long a value would take to reach the target. This default can't tell.
+		 *
+		 *  @param startValue   The value at the start
+		 *  @return             Time in seconds, or a negative number if the value never gets
+		 *                      there or it can't be told ( @see getIsPredictable() )
+		 */
+		virtual double timeToFinish( const T & startValue )
+		{
+			return getIsFinished(startValue) ? 0.0 : -1.0;
+		}
 
-			// Process the result
-			if( getHasTargetValue() )
-				_processResultForValueTarget(result, original, dir);
-			else
-				_processResultForDirectionalTarget( result, original, dir );
+		/**
+		 *  @return   Whether evaluateAt() and timeToFinish() are exact for this method. When they
+		 *            are, a negative timeToFinish() means the value will never finish.
+		 */
+		virtual bool getIsPredictable() const
+		{
+			return false;
+		}
 
-			return result;
+#ifdef OVERRATED_ENABLE_COUNTERS
+		/**
+		 *  Counts of what this method has done ( @see MethodCounter ). Only available when built
+		 *  with OVERRATED_ENABLE_COUNTERS.
+		 *
+		 *  @return   The counters, which may be read from any thread
+		 */
+		const OverRated::MethodCounters & getCounters() const
+		{
+			return mCounters;
 		}
+#endif
 
 		/**
-		 *  @return  Whether this is method has a target value AND has reached it.
+		 *  @return  Whether this is method has a target value AND has reached it. Methods with
+		 *           their own step may also need the value to have settled there.
 		 */
 		bool getIsFinished( const T & value ) const
 		{
 			assert( getHasTargetDirection() || getHasTargetValue() );
 
-			if( getHasTargetDirection() )
+			if( getHasTargetDirection() || !(value == getTargetValue()) )
 				return false;
-			else
-				return value == getTargetValue();
+
+			return !mHasOwnStep || _getIsSettled(value);
 		}
 
 	protected:
+		/**
+		 *  Sets the rate exactly as given, for subclasses whose values can't be made positive
+		 *  with UtilAbs() ( @see setRate() )
+		 *
+		 *  @param rate   The new rate
+		 */
+		void _setRate( const T & rate )
+		{
+			mRate = rate;
+		}
+
+		/**
+		 *  Subclasses which don't move at a constant rate turn this on from their constructors,
+		 *  and updates then go through _step() and _getIsSettled() rather than the hooks below.
+		 *
+		 *  @param hasOwnStep   Whether the subclass gives its own step
+		 */
+		void _setHasOwnStep( bool hasOwnStep )
+		{
+			mHasOwnStep = hasOwnStep;
+		}
+
+		/**
+		 *  The update of a subclass which has said it gives its own step ( @see _setHasOwnStep() )
+		 *
+		 *  @param value        The value to update
+		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
+		 *  @return             The value after updating
+		 */
+		virtual T _step( const T & value, const double & timeElapsed )
+		{
+			return _stepAtRate(value, timeElapsed);
+		}
+
+		/**
+		 *  For subclasses which give their own step, whether a value at the target has stopped
+		 *  there rather than passing through it. Only asked once the value is on the target.
+		 *
+		 *  @param value   The value, which is at the target
+		 *  @return        Whether the value is done moving
+		 */
+		virtual bool _getIsSettled( const T & value ) const
+		{
+			return true;
+		}
+
+		/**
+		 *  Overload this to bring any state the method keeps up to date when the target has
+		 *  been changed ( @see setTargetValue(), setTargetDirection() ).
+		 */
+		virtual void _onRetarget() {}
+
+		/**
+		 *  Overload this to return false for methods which only work towards a value target
+		 *
+		 *  @return   Whether setTargetDirection() is supported
+		 */
+		virtual bool _getCanTargetDirection() const
+		{
+			return true;
+		}
+
 		/**
 		 *  Overload this if special checks are needed to see that the value is legal, and make
 		 *  it legal directly if it isn't.
@@ -202,9 +412,13 @@ namespace OverRated
 		 *  @param result          The result to check, passed by reference so it can be changed
 		 *  @param originalValue   The value prior to the update which created the result
 		 *  @param dir             The direction that was used in the update
+		 *  @return                Whether the result was stopped at the target
 		 */
-		virtual void _processResultForValueTarget( T & result, const T & originalValue,
-				const OverRated::ConstDirection & dir ) {}
+		virtual bool _processResultForValueTarget( T & result, const T & originalValue,
+				const OverRated::ConstDirection & dir )
+		{
+			return false;
+		}
 
 		/**
 		 *  Overload this if special checks are needed to see that the result is legal, and make
@@ -213,16 +427,88 @@ namespace OverRated
 		 *  @param result          The result to check, passed by reference so it can be changed
 		 *  @param originalValue   The value prior to the update which created the result
 		 *  @param dir             The direction that was used in the update
+		 *  @return                Whether the result was stopped at the target
 		 */
-		virtual void _processResultForDirectionalTarget( T & result, const T & originalValue,
-				const OverRated::ConstDirection & dir ) {}
+		virtual bool _processResultForDirectionalTarget( T & result, const T & originalValue,
+				const OverRated::ConstDirection & dir )
+		{
+			return false;
+		}
 
 	private:
-		const TargetType mTargetType;	// The type of target to use
+		friend class OverRated::UpdatedValue<T>;
+
+		/**
+		 *  Moves the value at the rate towards the target, through the hooks above
+		 *
+		 *  @param value        The value to update
+		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
+		 *  @return             The value after updating
+		 */
+		T _stepAtRate( const T & value, const double & timeElapsed )
+		{
+			T original( value );					// Copy of the original value
+			OverRated::ConstDirection dir;			// Direction we'll change the value this time
+			T result( 0.0 );						// The result to return
+			T magnitude(getRate() * timeElapsed);	// The amount of change to apply (pos only)
+
+			assert( getHasTargetDirection() || getHasTargetValue() );
+
+			// Make the value legal
+			_checkValue( original );
+
+			result = original;
+
+			// Get the target direction
+			if( getHasTargetValue() )
+				dir = _getBestDirection(value);
+			else
+				dir = getTargetDirection();
+
+			// Apply the target direction
+			if( dir == OverRated::CD_INCREASING )
+				result += magnitude;
+			else
+				result -= magnitude;
+
+			// Process the result
+			bool snapped;
+
+			if( getHasTargetValue() )
+				snapped = _processResultForValueTarget(result, original, dir);
+			else
+				snapped = _processResultForDirectionalTarget( result, original, dir );
+
+			OVERRATED_COUNT(mCounters, OverRated::MC_UPDATES, 1);
+			OVERRATED_COUNT(mCounters, OverRated::MC_SNAPS, snapped ? 1 : 0);
+
+			return result;
+		}
+
+		/**
+		 *  Wakes every value using this method, after its target has changed
+		 */
+		void _wakeUsers()
+		{
+			for( unsigned i = 0; i < mUsers.size(); i++ )
+				mUsers[i]->wake();
+		}
+
+	private:
+		TargetType mTargetType;			// The type of target to use
 		T mTargetValue;  				// If the target is a value, this is it
 		ConstDirection mTargetDir;		// If the target is a direction, this is it
 		T mRate;						// The rate of change
+		bool mHasOwnStep;				// Whether updates go through _step()
+		std::vector<OverRated::UpdatedValue<T>*> mUsers;	// Values using this method
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+		OverRated::MethodCounters mCounters;	// What this method has done
+#endif
 	};
 }
 
+// Methods reach into the values using them, so the values must be defined too
+#include "OVRUpdatedValue.h"
+
 #endif // OVERRATED_UPDATEMETHOD_H_DEFINED__
@@ -0,0 +1,379 @@
+/**
+ *	UpdateMethodEased Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEMETHODEASED_H_DEFINED__
+#define OVERRATED_UPDATEMETHODEASED_H_DEFINED__
+
+#include "OVRUpdateMethod.h"
+#include "OVREase.h"
+
+namespace OverRated
+{
+	/**
+	 *  Moves a value to a target value over a set length of time, following an easing curve
+	 *  ( @see EaseCurve ) rather than a constant rate. The rate of the method is how much of the
+	 *  transition passes per second, so it is 1 / duration, and setRate() changes the duration.
+	 *  Only floating point types make sense here.
+	 *
+	 *  A transition starts from whatever the value is the first time it is updated, and starts
+	 *  again from the current value whenever the value it is given isn't the one it last
+	 *  produced, such as after setValue(). Because of this, each instance of this method keeps
+	 *  track of one transition and must only be used by one value at a time.
+	 *
+	 *  Curves come from shared lookup tables by default, or from their formulas with EM_EXACT.
+	 *  Many values on the same curve can also be eased at once ( @see updateBatch() ).
+	 */
+	template <typename T>
+	class UpdateMethodEased : public OverRated::UpdateMethod<T>
+	{
+	public:
+		/**
+		 *  Constructor
+		 *
+		 *  @param curve      The easing curve to follow
+		 *  @param duration   How long the transition takes, in seconds (more than 0)
+		 *  @param target     The value to reach
+		 *  @param mode       Whether to use the lookup tables or the formulas
+		 */
+		UpdateMethodEased( OverRated::EaseCurve curve, double duration, const T & target,
+				OverRated::EaseMode mode = OverRated::EM_TABLE )
+		: OverRated::UpdateMethod<T>(T(1.0 / duration), target), mCurve(curve), mMode(mode),
+		  mStart(target), mLast(target), mProgress(0.0), mIsStarted(false)
+		{
+			OverRated::UpdateMethod<T>::_setHasOwnStep(true);
+		}
+
+		/**
+		 *  @return   The easing curve followed
+		 */
+		OverRated::EaseCurve getCurve() const
+		{
+			return mCurve;
+		}
+
+		/**
+		 *  @param curve   The easing curve to follow; this applies from the next update
+		 */
+		void setCurve( OverRated::EaseCurve curve )
+		{
+			mCurve = curve;
+		}
+
+		/**
+		 *  @return   Whether the curve is read from a lookup table or worked out exactly
+		 */
+		OverRated::EaseMode getMode() const
+		{
+			return mMode;
+		}
+
+		/**
+		 *  @param mode   Whether to read the curve from a lookup table or work it out exactly
+		 */
+		void setMode( OverRated::EaseMode mode )
+		{
+			mMode = mode;
+		}
+
+		/**
+		 *  @return   How long a transition takes, in seconds
+		 */
+		double getDuration() const
+		{
+			return 1.0 / double(OverRated::UpdateMethod<T>::getRate());
+		}
+
+		/**
+		 *  @return   Progress through the current transition, from 0 to 1
+		 */
+		double getProgress() const
+		{
+			return mProgress;
+		}
+
+		/**
+		 *  Has the next update start a new transition from whatever the value is then
+		 */
+		void restart()
+		{
+			mIsStarted = false;
+			mProgress = 0.0;
+		}
+
+		/**
+		 *  Where a transition from startValue would be after some time. This doesn't use or
+		 *  change the transition in progress, so it is exact for any start.
+		 *
+		 *  @param startValue   The value at the start of the transition
+		 *  @param time         How much time passes, in seconds
+		 *  @return             The value after that time
+		 */
+		T evaluateAt( const T & startValue, double time )
+		{
+			double progress = double(OverRated::UpdateMethod<T>::getRate()) * time;
+
+			if( progress >= 1.0 )
+				return OverRated::UpdateMethod<T>::getTargetValue();
+
+			return _evaluate(startValue, progress);
+		}
+
+		/**
+		 *  If value is where the transition in progress has got to, where it will be further
+		 *  along that transition. Any other value starts a new transition, as its next update
+		 *  would.
+		 *
+		 *  @param value   The value as it is now
+		 *  @param time    How much more time passes, in seconds
+		 *  @return        The value after that time
+		 */
+		T continueAt( const T & value, double time )
+		{
+			if( !mIsStarted || !(value == mLast) )
+				return evaluateAt(value, time);
+
+			double progress = mProgress + double(OverRated::UpdateMethod<T>::getRate()) * time;
+
+			if( progress >= 1.0 )
+				return OverRated::UpdateMethod<T>::getTargetValue();
+
+			return _evaluate(mStart, progress);
+		}
+
+		/**
+		 *  The rest of the transition in progress, if startValue is where it has got to, or a
+		 *  whole transition otherwise
+		 *
+		 *  @param startValue   The value at the start
+		 *  @return             Time in seconds, or a negative number if there is no rate
+		 */
+		double timeToFinish( const T & startValue )
+		{
+			double rate = double(OverRated::UpdateMethod<T>::getRate());
+
+			if( OverRated::UpdateMethod<T>::getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(rate > 0.0) )
+				return -1.0;
+
+			if( mIsStarted && startValue == mLast )
+				return (1.0 - mProgress) / rate;
+
+			return 1.0 / rate;
+		}
+
+		/**
+		 *  @return   Always true; the curves are known in advance
+		 */
+		bool getIsPredictable() const
+		{
+			return true;
+		}
+
+		/**
+		 *  Eases a whole array of values along the same curve in one call. Each value has its own
+		 *  start, target, rate (1 / duration) and progress, which is kept in the progress array
+		 *  rather than in a method. The curve is chosen once for the whole array, so neither
+		 *  loop branches on it.
+		 *
+		 *  The loops are otherwise scalar. With the tables the loop is a gather and a blend, which
+		 *  GCC only vectorizes at -O3 for double; for float it can't rule out the values
+		 *  overlapping the table. Of the formulas, only the linear curve and the quad and cubic
+		 *  in and out curves vectorize, and only with -fno-trapping-math as well, which lets
+		 *  GCC turn their clamps into selects.
+		 *
+		 *  @param values        The values to update
+		 *  @param starts        Where each value started
+		 *  @param targets       Where each value is going
+		 *  @param progress      Progress of each value from 0 to 1, updated in place
+		 *  @param rates         The rate of each value
+		 *  @param count         Number of values
+		 *  @param timeElapsed   How much time has elapsed since last time, in seconds
+		 *  @param curve         The easing curve to follow
+		 *  @param mode          Whether to use the lookup tables or the formulas
+		 */
+		static void updateBatch( T * values, const T * starts, const T * targets, T * progress,
+				const T * rates, unsigned count, double timeElapsed, OverRated::EaseCurve curve,
+				OverRated::EaseMode mode = OverRated::EM_TABLE )
+		{
+			if( mode == OverRated::EM_EXACT ) {
+				// In the order of EaseCurve
+				static const BatchExact batches[OverRated::EC_COUNT] = {
+					&_updateBatchExact<OverRated::EC_LINEAR>,
+					&_updateBatchExact<OverRated::EC_QUAD_IN>,
+					&_updateBatchExact<OverRated::EC_QUAD_OUT>,
+					&_updateBatchExact<OverRated::EC_QUAD_IN_OUT>,
+					&_updateBatchExact<OverRated::EC_CUBIC_IN>,
+					&_updateBatchExact<OverRated::EC_CUBIC_OUT>,
+					&_updateBatchExact<OverRated::EC_CUBIC_IN_OUT>,
+					&_updateBatchExact<OverRated::EC_EXPO_IN>,
+					&_updateBatchExact<OverRated::EC_EXPO_OUT>,
+					&_updateBatchExact<OverRated::EC_EXPO_IN_OUT>,
+					&_updateBatchExact<OverRated::EC_ELASTIC_IN>,
+					&_updateBatchExact<OverRated::EC_ELASTIC_OUT>,
+					&_updateBatchExact<OverRated::EC_ELASTIC_IN_OUT>,
+					&_updateBatchExact<OverRated::EC_BOUNCE_IN>,
+					&_updateBatchExact<OverRated::EC_BOUNCE_OUT>,
+					&_updateBatchExact<OverRated::EC_BOUNCE_IN_OUT>
+				};
+
+				batches[(curve < OverRated::EC_COUNT) ? curve : OverRated::EC_LINEAR](values,
+						starts, targets, progress, rates, count, timeElapsed);
+				return;
+			}
+
+			const float * table = OverRated::EaseTable(curve);
+			const int last = int(OverRated::EASE_TABLE_SEGMENTS) - 1;
+
+			for( unsigned i = 0; i < count; i++ )
+				progress[i] = _advance(progress[i], rates[i], timeElapsed);
+
+			for( unsigned i = 0; i < count; i++ ) {
+				T position = progress[i] * T(OverRated::EASE_TABLE_SEGMENTS);
+				int index = int(position);	// Signed, so that the gather can vectorize
+
+				// Only a finished value lands on the last sample; it uses the last segment
+				index = (index < last) ? index : last;
+
+				T fraction = position - T(index);
+				T eased = T(table[index]) + (T(table[index + 1]) - T(table[index])) * fraction;
+
+				values[i] = starts[i] + (targets[i] - starts[i]) * eased;
+			}
+		}
+
+	private:
+		/**
+		 *  A new target starts a new transition, from wherever the value has got to
+		 */
+		void _onRetarget()
+		{
+			restart();
+		}
+
+		/**
+		 *  @param start      Where the transition started
+		 *  @param progress   Progress from 0 to 1
+		 *  @return           The value at that point of the transition
+		 */
+		T _evaluate( const T & start, double progress ) const
+		{
+			T target = OverRated::UpdateMethod<T>::getTargetValue();
+
+			return start + (target - start) * T(OverRated::EaseValue(mCurve, progress, mMode));
+		}
+
+		// The exact part of updateBatch() for each curve
+		typedef void (*BatchExact)( T *, const T *, const T *, T *, const T *, unsigned, double );
+
+		/**
+		 *  The exact part of updateBatch() for one curve, which is fixed here so that the
+		 *  formula needs no switch for each value
+		 */
+		template <OverRated::EaseCurve C>
+		static void _updateBatchExact( T * values, const T * starts, const T * targets,
+				T * progress, const T * rates, unsigned count, double timeElapsed )
+		{
+			for( unsigned i = 0; i < count; i++ ) {
+				progress[i] = _advance(progress[i], rates[i], timeElapsed);
+				values[i] = starts[i] + (targets[i] - starts[i]) *
+						T(OverRated::EaseExact(C, double(progress[i])));
+			}
+		}
+
+		/**
+		 *  @return   Progress moved on by the time elapsed, stopping at 1
+		 */
+		static T _advance( T progress, T rate, double timeElapsed )
+		{
+			T next = progress + T(rate * timeElapsed);
+
+			return (next < T(1)) ? next : T(1);
+		}
+
+		/**
+		 *  Moves the transition on and finds where the value should be on the curve
+		 *
+		 *  @param value        The value to update
+		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
+		 *  @return             The value after updating
+		 */
+		T _step( const T & value, const double & timeElapsed )
+		{
+			if( !mIsStarted || !(value == mLast) ) {
+				mStart = value;
+				mProgress = 0.0;
+				mIsStarted = true;
+			}
+
+			mProgress += double(OverRated::UpdateMethod<T>::getRate()) * timeElapsed;
+
+			if( mProgress >= 1.0 ) {
+				mProgress = 1.0;
+				mLast = OverRated::UpdateMethod<T>::getTargetValue();
+			}
+			else
+				mLast = _evaluate(mStart, mProgress);
+
+			return mLast;
+		}
+
+		/**
+		 *  Some curves pass through the target on the way, so reaching it only counts once the
+		 *  transition is over
+		 *
+		 *  @param value   The value, which is at the target
+		 *  @return        Whether the value is done moving
+		 */
+		bool _getIsSettled( const T & value ) const
+		{
+			return !mIsStarted || !(value == mLast) || mProgress >= 1.0;
+		}
+
+		// Not needed, as _step() is overloaded
+		OverRated::ConstDirection _getBestDirection( const T & value )
+		{
+			return OverRated::CD_INCREASING;
+		}
+
+		// Only a value target makes sense
+		bool _getCanTargetDirection() const
+		{
+			return false;
+		}
+
+	private:
+		OverRated::EaseCurve mCurve;	// The easing curve followed
+		OverRated::EaseMode mMode;		// Table or formula
+		T mStart;						// Where the current transition started
+		T mLast;						// The value last produced
+		double mProgress;				// Progress through the transition, 0 to 1
+		bool mIsStarted;				// Whether a transition has started
+	};
+}
+
+#endif // OVERRATED_UPDATEMETHODEASED_H_DEFINED__
@@ -28,6 +28,8 @@
 #define OVERRATED_UPDATEMETHODLOOPED_H_DEFINED__
 
 #include "OVRUpdateMethod.h"
+#include "OVRUpdateStep.h"
+#include "OVRBatch.h"
 
 namespace OverRated
 {
@@ -121,7 +123,142 @@ namespace OverRated
 			return mOverride;
 		}
 
+		/**
+		 *  Updates a whole array of values in one looped range towards their own targets at
+		 *  their own rates, taking the shortest way around. The result for each value is exactly
+		 *  what an UpdatedValue with an equivalent method would give; values already at their
+		 *  target are left alone. For float and double this uses the widest vector instructions
+		 *  the processor supports ( @see OVRSimd.h ).
+		 *
+		 *  @param values        The values to update in place
+		 *  @param targets       The value target of each value
+		 *  @param rates         The rate of each value
+		 *  @param count         Number of values
+		 *  @param timeElapsed   How much time has elapsed since last time, in seconds
+		 *  @param min           Minimum of the looping range
+		 *  @param max           Maximum of the looping range
+		 */
+		static void updateBatch( T * values, const T * targets, const T * rates, unsigned count,
+				double timeElapsed, const T & min, const T & max )
+		{
+			OverRated::BatchLoopedToValue(values, targets, rates, count, timeElapsed, min, max);
+		}
+
+		/**
+		 *  As above, but always going in the override direction rather than the shortest one
+		 *
+		 *  @param directionOverride   The direction to force
+		 */
+		static void updateBatch( T * values, const T * targets, const T * rates, unsigned count,
+				double timeElapsed, OverRated::ConstDirection directionOverride,
+				const T & min, const T & max )
+		{
+			OverRated::BatchLoopedToValue(values, targets, rates, count, timeElapsed,
+					directionOverride, min, max);
+		}
+
+		/**
+		 *  Updates a whole array of values in one looped range in a constant direction, each at
+		 *  its own rate.
+		 *
+		 *  @param values        The values to update in place
+		 *  @param rates         The rate of each value
+		 *  @param count         Number of values
+		 *  @param timeElapsed   How much time has elapsed since last time, in seconds
+		 *  @param target        The constant direction to travel in
+		 *  @param min           Minimum of the looping range
+		 *  @param max           Maximum of the looping range
+		 */
+		static void updateBatch( T * values, const T * rates, unsigned count,
+				double timeElapsed, OverRated::ConstDirection target, const T & min, const T & max )
+		{
+			OverRated::BatchLoopedInDirection(values, rates, count, timeElapsed, target, min, max);
+		}
+
+		/**
+		 *  The value travels rate * time around the range, in the same direction an update would
+		 *  pick, stopping at the target if it gets that far. Any number of laps is handled, so
+		 *  this is exact however long the time. A start value outside the range is looped in
+		 *  first and the direction is chosen from there, as updates do after their first step.
+		 *
+		 *  @param startValue   The value at the start
+		 *  @param time         How much time passes, in seconds
+		 *  @return             The value after that time
+		 */
+		T evaluateAt( const T & startValue, double time )
+		{
+			T magnitude( OverRated::UpdateMethod<T>::getRate() * time );
+			T original( startValue );
+
+			_checkValue(original);
+
+			if( OverRated::UpdateMethod<T>::getHasTargetDirection() )
+				return OverRated::StepLoopedWrapLaps(OverRated::StepApplyDirection(original,
+						OverRated::UpdateMethod<T>::getTargetDirection(), magnitude),
+						getMin(), getMax());
+
+			if( OverRated::UpdateMethod<T>::getIsFinished(startValue) )
+				return startValue;
+
+			T target = OverRated::UpdateMethod<T>::getTargetValue();
+			OverRated::ConstDirection dir = _getBestDirection(original);
+
+			if( !(magnitude < OverRated::StepLoopedDistance(original, target, dir,
+					getMin(), getMax())) )
+				return target;
+
+			return OverRated::StepLoopedWrapLaps(
+					OverRated::StepApplyDirection(original, dir, magnitude), getMin(), getMax());
+		}
+
+		/**
+		 *  The distance around the range to the target, in the direction an update would pick,
+		 *  over the rate
+		 *
+		 *  @param startValue   The value at the start
+		 *  @return             Time in seconds, or a negative number if the value never gets
+		 *                      there (directional target or no rate)
+		 */
+		double timeToFinish( const T & startValue )
+		{
+			T rate = OverRated::UpdateMethod<T>::getRate();
+			T original( startValue );
+
+			if( OverRated::UpdateMethod<T>::getHasTargetDirection() )
+				return -1.0;
+
+			if( OverRated::UpdateMethod<T>::getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(rate > 0) )
+				return -1.0;
+
+			_checkValue(original);
+
+			return double(OverRated::StepLoopedDistance(original,
+					OverRated::UpdateMethod<T>::getTargetValue(), _getBestDirection(original),
+					getMin(), getMax())) / double(rate);
+		}
+
+		/**
+		 *  @return   Always true; the looped model has a closed form
+		 */
+		bool getIsPredictable() const
+		{
+			return true;
+		}
+
 	private:
+		/**
+		 *  A directional target turns off any override direction, so a value target set
+		 *  afterwards is approached the shortest way, as with StaticMethodLooped
+		 */
+		void _onRetarget()
+		{
+			if( OverRated::UpdateMethod<T>::getHasTargetDirection() )
+				mOverrideEnabled = false;
+		}
+
 		/**
 		 *  The best direction for this method requires us to consider how far it would be to the
 		 *  target value in each direction and then pick the shortest. If an override was
@@ -133,18 +270,9 @@ namespace OverRated
 		{
 			if (getIsOverrideEnabled())
 				return getDirectionOverride();
-			else {
-				T target = OverRated::UpdateMethod<T>::getTargetValue();
-				T forward_distance = OverRated::UtilDist(value, target);
-				T backward_distance = OverRated::UtilDist(OverRated::UtilMin(value,	target),
-						getMin()) + OverRated::UtilDist(OverRated::UtilMax(value, target),
-						getMax());
-
-				if (forward_distance <= backward_distance)
-					return (value <= target) ? OverRated::CD_INCREASING : OverRated::CD_DECREASING;
-				else
-					return (value <= target) ? OverRated::CD_DECREASING	: OverRated::CD_INCREASING;
-			}
+			else
+				return OverRated::StepLoopedDirection(value,
+						OverRated::UpdateMethod<T>::getTargetValue(), getMin(), getMax());
 		}
 
 		/**
@@ -155,30 +283,16 @@ namespace OverRated
 		 *  @param result          The result to check, passed by reference so it can be changed
 		 *  @param originalValue   The value prior to the update which created the result
 		 *  @param dir             The direction that was used in the update
+		 *  @return                Whether the result was reverted to the target
 		 */
-		void _processResultForValueTarget(T & result, const T & originalValue,
+		bool _processResultForValueTarget(T & result, const T & originalValue,
 				const OverRated::ConstDirection & dir)
 		{
-			T target = OverRated::UpdateMethod<T>::getTargetValue();
-
-			// If the result is still in the range, the only way the target could have been
-			// passed is if it is between the original value and the result, much like the
-			// linear method.
-			if (OverRated::UtilRangeCheck(result, getMin(), getMax())) {
-				if (OverRated::UtilRangeCheck(target, originalValue, result))
-					result = target;
-			}
-			// if the result passed either bound of the range, it should loop. After looping,
-			// the target is passed if it is between the bound we looped to and the final result.
-			else {
-				T marker = (result > getMax()) ? getMin() : getMax(); // The bound we looped to
-
-				// Adjust the value
-				_checkValue(result);
+			OVERRATED_COUNT(OverRated::UpdateMethod<T>::getCounters(), OverRated::MC_WRAPS,
+					OverRated::UtilRangeCheck(result, getMin(), getMax()) ? 0 : 1);
 
-				if (OverRated::UtilRangeCheck(target, result, marker))
-					result = target;
-			}
+			return OverRated::StepLoopedSnap(result, originalValue,
+					OverRated::UpdateMethod<T>::getTargetValue(), getMin(), getMax());
 		}
 
 		/**
@@ -187,11 +301,13 @@ namespace OverRated
 		 *  @param result          The result to check, passed by reference so it can be changed
 		 *  @param originalValue   The value prior to the update which created the result
 		 *  @param dir             The direction that was used in the update
+		 *  @return                False, as there is no target to stop at
 		 */
-		void _processResultForDirectionalTarget( T & result, const T & originalValue,
+		bool _processResultForDirectionalTarget( T & result, const T & originalValue,
 						const OverRated::ConstDirection & dir )
 		{
 			_checkValue(result);
+			return false;
 		}
 
 		/**
@@ -200,13 +316,10 @@ namespace OverRated
 		 */
 		void _checkValue(T & value)
 		{
-			if (value > getMax())
-				value = getMin() + (value - getMax());
-			else if (value < getMin())
-				value = getMax() + (value - getMin());
+			OVERRATED_COUNT(OverRated::UpdateMethod<T>::getCounters(), OverRated::MC_WRAPS,
+					OverRated::UtilRangeCheck(value, getMin(), getMax()) ? 0 : 1);
 
-			// If the loop made it still go over a range, push it back to whichever is closest
-			OverRated::UtilBindValueToRange(value, getMin(), getMax());
+			OverRated::StepLoopedWrap(value, getMin(), getMax());
 		}
 
 	private:
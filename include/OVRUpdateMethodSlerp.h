@@ -0,0 +1,164 @@
+/**
+ *	UpdateMethodSlerp Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEMETHODSLERP_H_DEFINED__
+#define OVERRATED_UPDATEMETHODSLERP_H_DEFINED__
+
+#include "OVRUpdateMethod.h"
+#include "OVRVector.h"
+
+namespace OverRated
+{
+	/**
+	 *  Turns a rotation, held as a unit quaternion in x, y, z, w order, towards a target
+	 *  rotation at a constant angular speed, the shorter way round. The value is set exactly to
+	 *  the target once it's within the turn of a single update.
+	 *
+	 *  The rate of this method is the angular speed in every component ( @see getSpeed() ).
+	 */
+	template <typename T>
+	class UpdateMethodSlerp : public OverRated::UpdateMethod< OverRated::Vector<T, 4> >
+	{
+	public:
+		typedef OverRated::Vector<T, 4> QuaternionType;
+		typedef OverRated::UpdateMethod<QuaternionType> Base;
+
+		/**
+		 *  Constructor
+		 *
+		 *  @param speed    The angle to turn per second, in radians (magnitude is used)
+		 *  @param target   The rotation to try and reach; it should be normalized
+		 */
+		UpdateMethodSlerp( const T & speed, const QuaternionType & target )
+		: Base(QuaternionType(OverRated::UtilAbs(speed)), target)
+		{
+			Base::_setHasOwnStep(true);
+		}
+
+		/**
+		 *  @return   The angle turned per second, in radians
+		 */
+		T getSpeed() const
+		{
+			return Base::getRate()[0];
+		}
+
+		/**
+		 *  @param speed   The angle to turn per second, in radians (magnitude is used)
+		 */
+		void setSpeed( const T & speed )
+		{
+			Base::_setRate(QuaternionType(OverRated::UtilAbs(speed)));
+		}
+
+		/**
+		 *  Changes the speed and the target together
+		 *
+		 *  @param speed    The angle to turn per second, in radians (magnitude is used)
+		 *  @param target   The new target
+		 */
+		void retarget( const T & speed, const QuaternionType & target )
+		{
+			setSpeed(speed);
+			Base::setTargetValue(target);
+		}
+
+		/**
+		 *  The value turns about a fixed axis at a constant speed, so this is exact
+		 *
+		 *  @param startValue   The value at the start
+		 *  @param time         How much time passes, in seconds
+		 *  @return             The value after that time
+		 */
+		QuaternionType evaluateAt( const QuaternionType & startValue, double time )
+		{
+			if( Base::getIsFinished(startValue) )
+				return startValue;
+
+			return _step(startValue, time);
+		}
+
+		/**
+		 *  The angle to the target over the speed
+		 *
+		 *  @param startValue   The value at the start
+		 *  @return             Time in seconds, or a negative number if there's no speed
+		 */
+		double timeToFinish( const QuaternionType & startValue )
+		{
+			if( Base::getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(getSpeed() > T(0)) )
+				return -1.0;
+
+			return OverRated::QuaternionAngle(startValue, Base::getTargetValue()) /
+					double(getSpeed());
+		}
+
+		/**
+		 *  @return   Always true
+		 */
+		bool getIsPredictable() const
+		{
+			return true;
+		}
+
+	private:
+		/**
+		 *  Turns the value speed * time towards the target, stopping there
+		 *
+		 *  @param value        The value to update
+		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
+		 *  @return             The value after updating
+		 */
+		QuaternionType _step( const QuaternionType & value, const double & timeElapsed )
+		{
+			const QuaternionType & target = Base::getTargetValue();
+			double angle = OverRated::QuaternionAngle(value, target);
+			double turn = double(getSpeed()) * timeElapsed;
+
+			if( angle <= turn )
+				return target;
+
+			return OverRated::QuaternionSlerp(value, target, turn / angle);
+		}
+
+		// Not needed, as _step() is overloaded
+		OverRated::ConstDirection _getBestDirection( const QuaternionType & value )
+		{
+			return OverRated::CD_INCREASING;
+		}
+
+		// Only a value target makes sense
+		bool _getCanTargetDirection() const
+		{
+			return false;
+		}
+	};
+}
+
+#endif // OVERRATED_UPDATEMETHODSLERP_H_DEFINED__
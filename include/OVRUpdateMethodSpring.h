@@ -0,0 +1,430 @@
+/**
+ *	UpdateMethodSpring Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEMETHODSPRING_H_DEFINED__
+#define OVERRATED_UPDATEMETHODSPRING_H_DEFINED__
+
+#include <cmath>
+
+#include "OVRUpdateMethod.h"
+#include "OVRUtils.h"
+
+namespace OverRated
+{
+	/**
+	 *  Pulls a value towards a target value as if by a damped spring, so the value has a
+	 *  velocity which carries on smoothly when the target is moved ( @see setTargetValue() ).
+	 *  The motion is worked out exactly for however much time has passed rather than stepped,
+	 *  so it is equally stable and accurate at any frame rate. Only floating point types make
+	 *  sense here.
+	 *
+	 *  The spring has a stiffness (its pull per unit of distance) and a damping (its drag per
+	 *  unit of velocity), both for a mass of 1. Critical damping, 2 * sqrt(stiffness), settles
+	 *  fastest without overshooting; less overshoots and more creeps. The rate of the method is
+	 *  the natural frequency of the spring, sqrt(stiffness). A spring never quite arrives, so
+	 *  once the value and its velocity are both within the rest threshold of zero, the value is
+	 *  put on the target and the spring stops.
+	 *
+	 *  The velocity belongs to this method, so each instance must only be used by one value at
+	 *  a time. If the value is changed by anything but this method, the spring starts again
+	 *  from rest. Many values on the same spring can be updated at once ( @see updateBatch() ).
+	 */
+	template <typename T>
+	class UpdateMethodSpring : public OverRated::UpdateMethod<T>
+	{
+	public:
+		/**
+		 *  Constructor for a critically damped spring
+		 *
+		 *  @param stiffness       The pull of the spring per unit of distance
+		 *  @param target          The value to pull towards
+		 *  @param restThreshold   How close to still the value must be to stop
+		 */
+		UpdateMethodSpring( const T & stiffness, const T & target,
+				const T & restThreshold = T(0.001) )
+		: OverRated::UpdateMethod<T>(T(std::sqrt(double(stiffness))), target),
+		  mDamping(2.0 * std::sqrt(double(stiffness))), mRestThreshold(restThreshold),
+		  mVelocity(0), mLast(target), mIsStarted(false)
+		{
+			OverRated::UpdateMethod<T>::_setHasOwnStep(true);
+		}
+
+		/**
+		 *  Constructor
+		 *
+		 *  @param stiffness       The pull of the spring per unit of distance
+		 *  @param damping         The drag on the spring per unit of velocity
+		 *  @param target          The value to pull towards
+		 *  @param restThreshold   How close to still the value must be to stop
+		 */
+		UpdateMethodSpring( const T & stiffness, const T & damping, const T & target,
+				const T & restThreshold )
+		: OverRated::UpdateMethod<T>(T(std::sqrt(double(stiffness))), target),
+		  mDamping(double(damping)), mRestThreshold(restThreshold), mVelocity(0), mLast(target),
+		  mIsStarted(false)
+		{
+			OverRated::UpdateMethod<T>::_setHasOwnStep(true);
+		}
+
+		/**
+		 *  @return   The pull of the spring per unit of distance
+		 */
+		T getStiffness() const
+		{
+			T rate = OverRated::UpdateMethod<T>::getRate();
+
+			return rate * rate;
+		}
+
+		/**
+		 *  @param stiffness   The pull of the spring per unit of distance
+		 */
+		void setStiffness( const T & stiffness )
+		{
+			OverRated::UpdateMethod<T>::setRate(T(std::sqrt(double(stiffness))));
+		}
+
+		/**
+		 *  @return   The drag on the spring per unit of velocity
+		 */
+		T getDamping() const
+		{
+			return T(mDamping);
+		}
+
+		/**
+		 *  @param damping   The drag on the spring per unit of velocity
+		 */
+		void setDamping( const T & damping )
+		{
+			mDamping = double(damping);
+		}
+
+		/**
+		 *  Damps the spring critically for its current stiffness
+		 */
+		void setCriticallyDamped()
+		{
+			mDamping = 2.0 * double(OverRated::UpdateMethod<T>::getRate());
+		}
+
+		/**
+		 *  @return   How close to still the value must be to stop
+		 */
+		T getRestThreshold() const
+		{
+			return mRestThreshold;
+		}
+
+		/**
+		 *  @param threshold   How close to still the value must be to stop
+		 */
+		void setRestThreshold( const T & threshold )
+		{
+			mRestThreshold = threshold;
+		}
+
+		/**
+		 *  @return   The velocity of the value, in units per second
+		 */
+		T getVelocity() const
+		{
+			return mVelocity;
+		}
+
+		/**
+		 *  Gives the value a push. Any value using this method should be woken afterwards
+		 *  ( @see UpdatedObject::wake() ), as it may have been at rest.
+		 *
+		 *  @param velocity   The new velocity of the value, in units per second
+		 */
+		void setVelocity( const T & velocity )
+		{
+			mVelocity = velocity;
+		}
+
+		/**
+		 *  Where the value will be after some time. If startValue is where this method left the
+		 *  value, it carries on with the current velocity; otherwise it starts from rest.
+		 *
+		 *  @param startValue   The value at the start
+		 *  @param time         How much time passes, in seconds
+		 *  @return             The value after that time
+		 */
+		T evaluateAt( const T & startValue, double time )
+		{
+			double m[4];
+			T velocity = (mIsStarted && startValue == mLast) ? mVelocity : T(0);
+
+			if( OverRated::UpdateMethod<T>::getIsFinished(startValue) )
+				return startValue;
+
+			_coefficients(time, m);
+			return _move(startValue, velocity, m);
+		}
+
+		/**
+		 *  An estimate of how long the spring takes to come to rest, from how fast it loses
+		 *  energy. This is often short, most of all near critical damping, where the value can
+		 *  take half as long again.
+		 *
+		 *  @param startValue   The value at the start
+		 *  @return             Time in seconds, or a negative number for an undamped spring
+		 */
+		double timeToFinish( const T & startValue )
+		{
+			double rate = double(OverRated::UpdateMethod<T>::getRate());
+			double velocity = (mIsStarted && startValue == mLast) ? double(mVelocity) : 0.0;
+			double distance = double(OverRated::UtilDist(startValue,
+					OverRated::UpdateMethod<T>::getTargetValue()));
+			double threshold = double(mRestThreshold);
+			double decay;
+
+			if( OverRated::UpdateMethod<T>::getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(mDamping > 0.0) )
+				return -1.0;
+
+			// The slowest rate at which the motion dies away
+			if( mDamping < 2.0 * rate )
+				decay = mDamping / 2.0;
+			else if( rate > 0.0 ) {
+				double ratio = mDamping / (2.0 * rate);
+
+				decay = rate * (ratio - std::sqrt(ratio * ratio - 1.0));
+			}
+			else
+				decay = mDamping;
+
+			double size = distance + std::fabs(velocity) / ((rate > 0.0) ? rate : mDamping);
+
+			if( !(threshold > 0.0) || size <= threshold )
+				return (size <= threshold) ? 0.0 : -1.0;
+
+			return std::log(size / threshold) / decay;
+		}
+
+		/**
+		 *  The motion is known in closed form, so evaluateAt() is exact, but timeToFinish() is
+		 *  only an estimate
+		 *
+		 *  @return   Always false
+		 */
+		bool getIsPredictable() const
+		{
+			return false;
+		}
+
+		/**
+		 *  Updates a whole array of values on the same spring in one call. Each value has its
+		 *  own target and velocity, kept in arrays rather than in a method. The motion over the
+		 *  time elapsed comes down to four numbers shared by every value, so the loop is a few
+		 *  multiplies and a test for rest per value. GCC only vectorizes it at -O3 with
+		 *  -fno-trapping-math, which lets it turn that test into a select; otherwise it is
+		 *  scalar. The results match updateValue() on an equivalent method.
+		 *
+		 *  @param values          The values to update in place
+		 *  @param velocities      The velocity of each value, updated in place
+		 *  @param targets         The target of each value
+		 *  @param count           Number of values
+		 *  @param timeElapsed     How much time has elapsed since last time, in seconds
+		 *  @param stiffness       The pull of the spring per unit of distance
+		 *  @param damping         The drag on the spring per unit of velocity
+		 *  @param restThreshold   How close to still a value must be to stop
+		 */
+		static void updateBatch( T * values, T * velocities, const T * targets, unsigned count,
+				double timeElapsed, const T & stiffness, const T & damping,
+				const T & restThreshold )
+		{
+			double m[4];
+
+			_coefficients(timeElapsed, double(T(std::sqrt(double(stiffness)))), double(damping), m);
+
+			const T m00 = T(m[0]), m01 = T(m[1]), m10 = T(m[2]), m11 = T(m[3]);
+
+			for( unsigned i = 0; i < count; i++ ) {
+				T offset = values[i] - targets[i];
+				T y = m00 * offset + m01 * velocities[i];
+				T v = m10 * offset + m11 * velocities[i];
+				bool rest = OverRated::UtilAbs(y) <= restThreshold &&
+						OverRated::UtilAbs(v) <= restThreshold;
+
+				values[i] = rest ? targets[i] : targets[i] + y;
+				velocities[i] = rest ? T(0) : v;
+			}
+		}
+
+	private:
+		/**
+		 *  Moves a value and its velocity along the spring
+		 *
+		 *  @param value      The value
+		 *  @param velocity   Its velocity, updated in place
+		 *  @param m          The coefficients for the time elapsed ( @see _coefficients() )
+		 *  @return           The new value
+		 */
+		T _move( const T & value, T & velocity, const double * m ) const
+		{
+			T target = OverRated::UpdateMethod<T>::getTargetValue();
+			T offset = value - target;
+			T y = T(m[0]) * offset + T(m[1]) * velocity;
+			T v = T(m[2]) * offset + T(m[3]) * velocity;
+
+			if( OverRated::UtilAbs(y) <= mRestThreshold &&
+					OverRated::UtilAbs(v) <= mRestThreshold ) {
+				velocity = T(0);
+				return target;
+			}
+
+			velocity = v;
+			return target + y;
+		}
+
+		/**
+		 *  @see _coefficients( double, double, double, double * )
+		 */
+		void _coefficients( double time, double * m ) const
+		{
+			_coefficients(time, double(OverRated::UpdateMethod<T>::getRate()), mDamping, m);
+		}
+
+		/**
+		 *  The spring is linear, so after a length of time the offset from the target and the
+		 *  velocity are each a fixed mix of what they were before:
+		 *
+		 *      offset'   = m[0] * offset + m[1] * velocity
+		 *      velocity' = m[2] * offset + m[3] * velocity
+		 *
+		 *  @param time        The length of time
+		 *  @param frequency   Natural frequency of the spring, sqrt(stiffness)
+		 *  @param damping     Drag per unit of velocity
+		 *  @param m           Receives the four coefficients
+		 */
+		static void _coefficients( double time, double frequency, double damping, double * m )
+		{
+			double decay = damping / 2.0;
+			double critical = 2.0 * frequency;
+
+			if( !(frequency > 0.0) ) {
+				// No spring at all, only drag
+				double e = std::exp(-damping * time);
+
+				m[0] = 1.0;
+				m[1] = (damping > 0.0) ? (1.0 - e) / damping : time;
+				m[2] = 0.0;
+				m[3] = e;
+			}
+			else if( std::fabs(damping - critical) <= critical * 1.0e-6 ) {
+				double e = std::exp(-frequency * time);
+
+				m[0] = e * (1.0 + frequency * time);
+				m[1] = e * time;
+				m[2] = -e * frequency * frequency * time;
+				m[3] = e * (1.0 - frequency * time);
+			}
+			else if( damping < critical ) {
+				double damped = std::sqrt(frequency * frequency - decay * decay);
+				double e = std::exp(-decay * time);
+				double c = std::cos(damped * time);
+				double s = std::sin(damped * time);
+
+				m[0] = e * (c + decay * s / damped);
+				m[1] = e * s / damped;
+				m[2] = -e * s * frequency * frequency / damped;
+				m[3] = e * (c - decay * s / damped);
+			}
+			else {
+				double root = std::sqrt(decay * decay - frequency * frequency);
+				double r1 = -decay + root;
+				double r2 = -decay - root;
+				double e1 = std::exp(r1 * time);
+				double e2 = std::exp(r2 * time);
+				double d = r1 - r2;
+
+				m[0] = (r1 * e2 - r2 * e1) / d;
+				m[1] = (e1 - e2) / d;
+				m[2] = r1 * r2 * (e2 - e1) / d;
+				m[3] = (r1 * e1 - r2 * e2) / d;
+			}
+		}
+
+		/**
+		 *  Moves the value along the spring for the time elapsed
+		 *
+		 *  @param value        The value to update
+		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
+		 *  @return             The value after updating
+		 */
+		T _step( const T & value, const double & timeElapsed )
+		{
+			double m[4];
+
+			if( !mIsStarted || !(value == mLast) ) {
+				mVelocity = T(0);
+				mIsStarted = true;
+			}
+
+			_coefficients(timeElapsed, m);
+			mLast = _move(value, mVelocity, m);
+
+			return mLast;
+		}
+
+		/**
+		 *  A spring can swing through its target, so only a value which has come to rest
+		 *  there is finished
+		 *
+		 *  @param value   The value, which is at the target
+		 *  @return        Whether the value is still
+		 */
+		bool _getIsSettled( const T & value ) const
+		{
+			return !mIsStarted || !(value == mLast) || mVelocity == T(0);
+		}
+
+		// Not needed, as _step() is overloaded
+		OverRated::ConstDirection _getBestDirection( const T & value )
+		{
+			return OverRated::CD_INCREASING;
+		}
+
+		// Only a value target makes sense
+		bool _getCanTargetDirection() const
+		{
+			return false;
+		}
+
+	private:
+		double mDamping;		// Drag per unit of velocity
+		T mRestThreshold;		// How close to still counts as stopped
+		T mVelocity;			// Velocity of the value
+		T mLast;				// The value last produced
+		bool mIsStarted;		// Whether the spring has moved a value yet
+	};
+}
+
+#endif // OVERRATED_UPDATEMETHODSPRING_H_DEFINED__
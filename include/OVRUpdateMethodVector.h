@@ -0,0 +1,185 @@
+/**
+ *	UpdateMethodVector Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEMETHODVECTOR_H_DEFINED__
+#define OVERRATED_UPDATEMETHODVECTOR_H_DEFINED__
+
+#include "OVRUpdateMethod.h"
+#include "OVRUpdateStep.h"
+#include "OVRBatch.h"
+#include "OVRVector.h"
+
+namespace OverRated
+{
+	/**
+	 *  Moves a vector value (a position, a colour, ...) along the straight line to a target
+	 *  vector at a constant speed, so every component arrives at the same time and the value
+	 *  finishes as a whole. This replaces one UpdatedValue per component, each of which would
+	 *  move and finish separately.
+	 *
+	 *  The rate of this method is the speed in every component ( @see getSpeed() ). Only value
+	 *  targets make sense for a vector.
+	 */
+	template <typename T, unsigned N>
+	class UpdateMethodVector : public OverRated::UpdateMethod< OverRated::Vector<T, N> >
+	{
+	public:
+		typedef OverRated::Vector<T, N> VectorType;
+		typedef OverRated::UpdateMethod<VectorType> Base;
+
+		/**
+		 *  Constructor
+		 *
+		 *  @param speed    The distance to move per second (magnitude is used)
+		 *  @param target   The vector to try and reach
+		 */
+		UpdateMethodVector( const T & speed, const VectorType & target )
+		: Base(VectorType(OverRated::UtilAbs(speed)), target)
+		{
+			Base::_setHasOwnStep(true);
+		}
+
+		/**
+		 *  @return   The distance moved per second
+		 */
+		T getSpeed() const
+		{
+			return Base::getRate()[0];
+		}
+
+		/**
+		 *  @param speed   The distance to move per second (magnitude is used)
+		 */
+		void setSpeed( const T & speed )
+		{
+			Base::_setRate(VectorType(OverRated::UtilAbs(speed)));
+		}
+
+		/**
+		 *  Changes the speed and the target together
+		 *
+		 *  @param speed    The distance to move per second (magnitude is used)
+		 *  @param target   The new target
+		 */
+		void retarget( const T & speed, const VectorType & target )
+		{
+			setSpeed(speed);
+			Base::setTargetValue(target);
+		}
+
+		/**
+		 *  Updates a whole array of vector values towards their own targets at their own speeds
+		 *  in one call. The result for each value is exactly what updateValue() would give with
+		 *  an equivalent method. For float and double this uses the widest vector instructions
+		 *  the processor supports ( @see OVRSimd.h ), one value per lane.
+		 *
+		 *  @param values        The values to update in place, held as N arrays of count
+		 *                       components back to back ( @see BatchVectorToValue() )
+		 *  @param targets       The value target of each value, laid out the same way
+		 *  @param speeds        The speed of each value
+		 *  @param count         Number of values
+		 *  @param timeElapsed   How much time has elapsed since last time, in seconds
+		 */
+		static void updateBatch( T * values, const T * targets, const T * speeds, unsigned count,
+				double timeElapsed )
+		{
+			OverRated::BatchVectorToValue(values, targets, speeds, N, count, timeElapsed);
+		}
+
+		/**
+		 *  The value moves along a straight line at a constant speed, so this is exact
+		 *
+		 *  @param startValue   The value at the start
+		 *  @param time         How much time passes, in seconds
+		 *  @return             The value after that time
+		 */
+		VectorType evaluateAt( const VectorType & startValue, double time )
+		{
+			if( Base::getIsFinished(startValue) )
+				return startValue;
+
+			return _step(startValue, time);
+		}
+
+		/**
+		 *  The distance to the target over the speed
+		 *
+		 *  @param startValue   The value at the start
+		 *  @return             Time in seconds, or a negative number if there's no speed
+		 */
+		double timeToFinish( const VectorType & startValue )
+		{
+			if( Base::getIsFinished(startValue) )
+				return 0.0;
+
+			if( !(getSpeed() > T(0)) )
+				return -1.0;
+
+			return double(OverRated::VectorDist(startValue, Base::getTargetValue())) /
+					double(getSpeed());
+		}
+
+		/**
+		 *  @return   Always true
+		 */
+		bool getIsPredictable() const
+		{
+			return true;
+		}
+
+	private:
+		/**
+		 *  Moves the value speed * time along the line to the target, stopping there
+		 *
+		 *  @param value        The value to update
+		 *  @param timeElapsed  How much time has elapsed since last time, in seconds (1.0 = 1 sec)
+		 *  @return             The value after updating
+		 */
+		VectorType _step( const VectorType & value, const double & timeElapsed )
+		{
+			VectorType result( value );
+
+			OverRated::StepVectorToValue(result.getData(), Base::getTargetValue().getData(), N,
+					1, T(getSpeed() * timeElapsed));
+
+			return result;
+		}
+
+		// Not needed, as _step() is overloaded
+		OverRated::ConstDirection _getBestDirection( const VectorType & value )
+		{
+			return OverRated::CD_INCREASING;
+		}
+
+		// Only a value target makes sense
+		bool _getCanTargetDirection() const
+		{
+			return false;
+		}
+	};
+}
+
+#endif // OVERRATED_UPDATEMETHODVECTOR_H_DEFINED__
@@ -0,0 +1,919 @@
+/**
+ *	UpdateSchedule Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATESCHEDULE_H_DEFINED__
+#define OVERRATED_UPDATESCHEDULE_H_DEFINED__
+
+#include <cstddef>
+#include <vector>
+
+#include "OVRUpdatedObject.h"
+
+namespace OverRated
+{
+	/**
+	 *  Updates a tree of lists (a world list holding zone lists holding entity lists, say) as
+	 *  one flat list of the objects at its leaves. Adding time to the tree itself visits every
+	 *  list on the way down and checks whether each one is paused; the schedule works out once
+	 *  which leaves there are and which lists they sit under, then updates the active leaves in
+	 *  a single loop, so adding time costs the same however the tree is shaped.
+	 *
+	 *  Add time to the schedule instead of to the root of the tree. Any list which does nothing
+	 *  itself but update its items ( @see UpdatedObject::_getScheduleChildren() ) is flattened
+	 *  into the schedule; anything else, including a list with completion callbacks, a command
+	 *  queue, a thread pool or a fixed step, is a leaf and is updated as a whole. The lists
+	 *  flattened away don't see the time pass, so their elapsed time and counters stand still.
+	 *
+	 *  The schedule keeps up with the tree by itself. Pausing a list takes the leaves beneath it
+	 *  out of the loop at once, and unpausing it puts them back, without looking at the rest
+	 *  of the tree. The time scales of the lists above each leaf are multiplied together and
+	 *  kept up to date in the same way ( @see UpdatedObject::setTimeScale() ). Leaves which
+	 *  are paused or idle drop out of the loop just as they do in a list, until they are
+	 *  woken. When items are added to or removed from a list, only that list's leaves are
+	 *  brought up to date, once, when time is next added, however many changes were made in
+	 *  between. The whole tree is only worked out again ( @see compile() ) when lists
+	 *  themselves are added or removed, or a list starts or stops being flattened.
+	 *
+	 *  An object reached more than once through the tree is only updated once.
+	 *
+	 *  Only the lists are added to the schedule as a parent. The objects in them are found in
+	 *  a table the schedule keeps, and the lists pass on what happens to them, so scheduling
+	 *  an object costs it nothing of its own.
+	 */
+	class UpdateSchedule : public OverRated::UpdatedObject, public OverRated::UpdatedObjectParent
+	{
+	public:
+		/**
+		 *  @param root   The object at the top of the tree, or NULL
+		 */
+		explicit UpdateSchedule( OverRated::UpdatedObject * root = 0 )
+		: mRoot(root), mFreeLeaf(NO_LEAF), mScales(1, 1.0), mActiveCount(0), mIsStale(true),
+		  mPass(0), mLeafTableCount(0)
+		{}
+
+		/**
+		 *  The tree is only referred to, so it is left alone
+		 */
+		virtual ~UpdateSchedule()
+		{
+			_release();
+		}
+
+		/**
+		 *  Changes which tree is updated
+		 *
+		 *  @param root   The object at the top of the tree, or NULL
+		 */
+		void setRoot( OverRated::UpdatedObject * root )
+		{
+			mRoot = root;
+			_setStale();
+		}
+
+		/**
+		 *  @return   The object at the top of the tree (warning: can be NULL!)
+		 */
+		OverRated::UpdatedObject * getRoot() const
+		{
+			return mRoot;
+		}
+
+		/**
+		 *  Works out the leaves of the tree again now, rather than when time is next added. This
+		 *  is only needed to choose when the work is done, such as while loading.
+		 */
+		void compile()
+		{
+			_release();
+			mIsStale = false;
+
+			if( mRoot )
+				_flatten(mRoot, NO_NODE);
+
+			for( unsigned i = 0; i < mItems.size(); i++ ) {
+				if( _getCanRun(mLeafOf[i]) )
+					_activate(i);
+			}
+		}
+
+		/**
+		 *  @return   Whether the tree has changed since its leaves were last brought up to date
+		 */
+		bool getIsStale() const
+		{
+			return mIsStale || !mChangedNodes.empty();
+		}
+
+		/**
+		 *  @return   Number of objects updated by the schedule, as of the last time it was
+		 *            brought up to date
+		 */
+		unsigned getLeafCount() const
+		{
+			return mItems.size();
+		}
+
+		/**
+		 *  @return   Number of lists flattened into the schedule, as of the last compile()
+		 */
+		unsigned getNodeCount() const
+		{
+			return mNodes.size();
+		}
+
+		/**
+		 *  @return   Number of leaves which are currently being updated
+		 */
+		unsigned getActiveCount() const
+		{
+			return mActiveCount;
+		}
+
+		/**
+		 *  The schedule is idle when none of its leaves are active and the tree hasn't changed
+		 *
+		 *  @return   Whether adding time would do nothing
+		 */
+		bool getIsIdle() const
+		{
+			return mActiveCount == 0 && !getIsStale();
+		}
+
+	private:
+		UpdateSchedule( const UpdateSchedule & );
+		UpdateSchedule & operator=( const UpdateSchedule & );
+
+		/**
+		 *  Brings the leaves up to date if the tree has changed, then updates every active leaf
+		 *
+		 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+		 */
+		void _addTime( const double & timeElapsed )
+		{
+			if( !mIsStale && !mChangedNodes.empty() )
+				_patch();
+
+			if( mIsStale )
+				compile();
+
+			unsigned i = 0;
+
+			while( i < mActiveCount ) {
+				OverRated::UpdatedObject * item = mItems[i];
+
+				item->addTime(timeElapsed * mScales[mScaleOf[i]]);
+
+				// Deactivating swaps in the last active leaf, which still needs its update
+				if( item->getIsPaused() || item->_getIsIdleAfterUpdate() )
+					_deactivate(i);
+				else
+					i++;
+			}
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+			OverRated::FlushCounters();
+#endif
+		}
+
+		/**
+		 *  Adds an object and everything beneath it, depth first, so that the lists beneath any
+		 *  list follow on from it
+		 *
+		 *  @param object   The object
+		 *  @param parent   The list it is in, or NO_NODE for the root
+		 */
+		void _flatten( OverRated::UpdatedObject * object, unsigned parent )
+		{
+			unsigned slot;
+			unsigned first = mChildren.size();
+
+			if( _find(object, slot) )
+				return;
+
+			if( !object->_getScheduleChildren(mChildren) ) {
+				_addLeaf(object, parent);
+				return;
+			}
+
+			unsigned node = mNodes.size();
+			unsigned end = mChildren.size();
+
+			mNodes.push_back(Node(object, parent));
+			mNodes[node].isMasked = object->getIsPaused() || _getIsMasked(parent);
+			mScales.push_back(object->getTimeScale() * mScales[_getScaleIndex(parent)]);
+			object->_attachParent(this, node | NODE_BIT);
+
+			// Lists further down add their children past 'end' and take them off again
+			for( unsigned i = first; i < end; i++ )
+				_flatten(mChildren[i], node);
+
+			mChildren.resize(first);
+			mNodes[node].endNode = mNodes.size();
+		}
+
+		/**
+		 *  Brings the leaves of each list whose items have changed up to date, by comparing its
+		 *  items with the leaves it had. Anything more than leaves coming and going, such as a
+		 *  list being added, leaves the schedule stale to be compiled instead.
+		 */
+		void _patch()
+		{
+			for( unsigned c = 0; c < mChangedNodes.size() && !mIsStale; c++ ) {
+				if( mNodes[mChangedNodes[c]].object )
+					_patchNode(mChangedNodes[c]);
+			}
+
+			for( unsigned c = 0; c < mChangedNodes.size(); c++ )
+				mNodes[mChangedNodes[c]].isChanged = false;
+
+			mChangedNodes.clear();
+		}
+
+		/**
+		 *  Brings the leaves of one list up to date
+		 *
+		 *  @param node   Index of the list
+		 */
+		void _patchNode( unsigned node )
+		{
+			mChildren.clear();
+
+			if( !mNodes[node].object->_getScheduleChildren(mChildren) ) {
+				mIsStale = true;
+				return;
+			}
+
+			mPass++;
+
+			for( unsigned i = 0; i < mChildren.size(); i++ ) {
+				OverRated::UpdatedObject * child = mChildren[i];
+				unsigned slot;
+
+				if( !_find(child, slot) ) {
+					mProbe.clear();
+
+					// A new list needs its own range of lists, which only compiling can give it
+					if( child->_getScheduleChildren(mProbe) ) {
+						mIsStale = true;
+						return;
+					}
+
+					slot = _addLeaf(child, node);
+
+					if( _getCanRun(slot) )
+						_activate(mLeaves[slot].index);
+				}
+
+				// Something which was already elsewhere in the tree is only moved by compiling
+				if( (slot & NODE_BIT) ? mNodes[slot & ~NODE_BIT].parent != node :
+						mLeaves[slot].node != node ) {
+					mIsStale = true;
+					return;
+				}
+
+				if( slot & NODE_BIT )
+					mNodes[slot & ~NODE_BIT].pass = mPass;
+				else
+					mLeaves[slot].pass = mPass;
+			}
+
+			// Lists only leave the tree by compiling
+			for( unsigned n = node + 1; n < mNodes[node].endNode; n = mNodes[n].endNode ) {
+				if( mNodes[n].pass != mPass ) {
+					mIsStale = true;
+					return;
+				}
+			}
+
+			std::vector<unsigned> & leaves = mNodes[node].leaves;
+
+			for( unsigned i = leaves.size(); i-- > 0; ) {
+				if( mLeaves[leaves[i]].pass != mPass )
+					_removeLeaf(leaves[i], true);
+			}
+		}
+
+		/**
+		 *  Adds a leaf, inactive, reusing a free one if there is one
+		 *
+		 *  @param object   The object updated by the leaf
+		 *  @param node     The list it is in, or NO_NODE for the root
+		 *  @return         Index of the leaf
+		 */
+		unsigned _addLeaf( OverRated::UpdatedObject * object, unsigned node )
+		{
+			unsigned leaf = mFreeLeaf;
+
+			if( leaf != NO_LEAF ) {
+				mFreeLeaf = mLeaves[leaf].node;
+				mLeaves[leaf] = Leaf(object, node, mItems.size());
+			}
+			else {
+				leaf = mLeaves.size();
+				mLeaves.push_back(Leaf(object, node, mItems.size()));
+			}
+
+			mItems.push_back(object);
+			mLeafOf.push_back(leaf);
+			mScaleOf.push_back(_getScaleIndex(node));
+
+			if( node != NO_NODE ) {
+				mLeaves[leaf].position = mNodes[node].leaves.size();
+				mNodes[node].leaves.push_back(leaf);
+				_insertLeaf(object, leaf);
+			}
+			else
+				object->_attachParent(this, leaf);
+
+			return leaf;
+		}
+
+		/**
+		 *  Removes a leaf, which becomes free to be reused
+		 *
+		 *  @param leaf     Index of the leaf
+		 *  @param detach   Whether the object still exists and should forget the schedule
+		 */
+		void _removeLeaf( unsigned leaf, bool detach )
+		{
+			Leaf & entry = mLeaves[leaf];
+
+			if( entry.index < mActiveCount )
+				_deactivate(entry.index);
+
+			// Inactive leaves can go in any order, so the last one takes its place
+			_swap(entry.index, mItems.size() - 1);
+			mItems.pop_back();
+			mLeafOf.pop_back();
+			mScaleOf.pop_back();
+
+			if( entry.node != NO_NODE ) {
+				std::vector<unsigned> & leaves = mNodes[entry.node].leaves;
+
+				leaves[entry.position] = leaves.back();
+				mLeaves[leaves[entry.position]].position = entry.position;
+				leaves.pop_back();
+				_eraseLeaf(entry.object);
+			}
+			else if( detach )
+				entry.object->_detachParent(this);
+
+			if( entry.object == mRoot )
+				mRoot = 0;
+
+			entry.object = 0;
+			entry.node = mFreeLeaf;
+			mFreeLeaf = leaf;
+		}
+
+		/**
+		 *  Forgets the tree, detaching from everything in it which still exists
+		 */
+		void _release()
+		{
+			for( unsigned i = 0; i < mNodes.size(); i++ ) {
+				if( mNodes[i].object )
+					mNodes[i].object->_detachParent(this);
+			}
+
+			// Objects in lists were never added, and may since have been destroyed
+			for( unsigned i = 0; i < mItems.size(); i++ ) {
+				if( mLeaves[mLeafOf[i]].node == NO_NODE )
+					mItems[i]->_detachParent(this);
+			}
+
+			mNodes.clear();
+			mLeaves.clear();
+			mFreeLeaf = NO_LEAF;
+			mItems.clear();
+			mLeafOf.clear();
+			mScaleOf.clear();
+			mScales.resize(1);
+			mActiveCount = 0;
+			mChangedNodes.clear();
+			mLeafTable.clear();
+			mLeafTableCount = 0;
+		}
+
+		/**
+		 *  Marks the tree to be compiled again. If nothing was active, the schedule wakes its
+		 *  own parents so that it is given time to do so.
+		 */
+		void _setStale()
+		{
+			bool was_stale = getIsStale();
+
+			mIsStale = true;
+
+			if( !was_stale && mActiveCount == 0 )
+				wake();
+		}
+
+		/**
+		 *  Marks a list as needing its leaves brought up to date, waking the schedule as
+		 *  _setStale() does
+		 *
+		 *  @param node   Index of the list
+		 */
+		void _setChanged( unsigned node )
+		{
+			if( mIsStale || mNodes[node].isChanged )
+				return;
+
+			bool was_stale = getIsStale();
+
+			mNodes[node].isChanged = true;
+			mChangedNodes.push_back(node);
+
+			if( !was_stale && mActiveCount == 0 )
+				wake();
+		}
+
+		/**
+		 *  Anything in the tree which is destroyed must be forgotten without being touched. A
+		 *  leaf simply goes; a list means compiling again.
+		 *
+		 *  @param slot   The slot of the destroyed object
+		 */
+		void _onChildDestroyed( unsigned slot )
+		{
+			if( !(slot & NODE_BIT) ) {
+				_removeLeaf(slot, false);
+				return;
+			}
+
+			if( mNodes[slot & ~NODE_BIT].object == mRoot )
+				mRoot = 0;
+
+			mNodes[slot & ~NODE_BIT].object = 0;
+			_setStale();
+		}
+
+		/**
+		 *  A woken leaf goes back among the active ones unless a list above it is paused. A
+		 *  woken list may have been unpaused, which lets the leaves beneath it run again.
+		 *
+		 *  @param slot   The slot of the woken object
+		 */
+		void _onChildWoken( unsigned slot )
+		{
+			if( slot & NODE_BIT ) {
+				unsigned active = mActiveCount;
+
+				_unmask(slot & ~NODE_BIT);
+
+				if( active == 0 && mActiveCount != 0 )
+					wake();
+			}
+			else
+				_wakeLeaf(slot);
+		}
+
+		/**
+		 *  An object in a list is woken just as the root is
+		 *
+		 *  @param slot   The slot of the list
+		 *  @param item   The woken object
+		 */
+		void _onItemWoken( unsigned slot, OverRated::UpdatedObject * item )
+		{
+			if( !(slot & NODE_BIT) || mIsStale )
+				return;
+
+			unsigned leaf = _findLeaf(item);
+
+			if( leaf != NO_LEAF )
+				_wakeLeaf(leaf);
+		}
+
+		/**
+		 *  An object taken out of a list, or destroyed, is forgotten at once. It may have been
+		 *  reached through another list first, in which case it stays.
+		 *
+		 *  @param slot   The slot of the list
+		 *  @param item   The object taken out
+		 */
+		void _onItemRemoved( unsigned slot, OverRated::UpdatedObject * item )
+		{
+			if( !(slot & NODE_BIT) || mIsStale )
+				return;
+
+			unsigned leaf = _findLeaf(item);
+
+			if( leaf != NO_LEAF && mLeaves[leaf].node == (slot & ~NODE_BIT) )
+				_removeLeaf(leaf, false);
+		}
+
+		/**
+		 *  An object in a list is restructured just as the root is
+		 *
+		 *  @param slot   The slot of the list
+		 *  @param item   The changed object
+		 */
+		void _onItemRestructured( unsigned slot, OverRated::UpdatedObject * item )
+		{
+			if( !(slot & NODE_BIT) || mIsStale )
+				return;
+
+			unsigned leaf = _findLeaf(item);
+
+			if( leaf != NO_LEAF )
+				_restructureLeaf(leaf);
+		}
+
+		/**
+		 *  A woken leaf goes back among the active ones unless a list above it is paused
+		 *
+		 *  @param leaf   Index of the leaf
+		 */
+		void _wakeLeaf( unsigned leaf )
+		{
+			if( mLeaves[leaf].index < mActiveCount || _getIsMasked(mLeaves[leaf].node) )
+				return;
+
+			_activate(mLeaves[leaf].index);
+
+			if( mActiveCount == 1 )
+				wake();
+		}
+
+		/**
+		 *  A paused list takes every leaf beneath it out of the loop
+		 *
+		 *  @param slot   The slot of the paused object
+		 */
+		void _onChildPaused( unsigned slot )
+		{
+			if( !(slot & NODE_BIT) || mIsStale )
+				return;
+
+			unsigned first = slot & ~NODE_BIT;
+
+			if( mNodes[first].isMasked )
+				return;
+
+			for( unsigned n = first; n < mNodes[first].endNode; n++ ) {
+				const std::vector<unsigned> & leaves = mNodes[n].leaves;
+
+				mNodes[n].isMasked = true;
+
+				for( unsigned i = 0; i < leaves.size(); i++ ) {
+					if( mLeaves[leaves[i]].index < mActiveCount )
+						_deactivate(mLeaves[leaves[i]].index);
+				}
+			}
+		}
+
+		/**
+		 *  A list's new time scale passes down to every list beneath it. Leaves apply their own.
+		 *
+		 *  @param slot   The slot of the rescaled object
+		 */
+		void _onChildRescaled( unsigned slot )
+		{
+			if( !(slot & NODE_BIT) || mIsStale )
+				return;
+
+			unsigned first = slot & ~NODE_BIT;
+
+			for( unsigned n = first; n < mNodes[first].endNode; n++ ) {
+				mScales[n + 1] = mNodes[n].object->getTimeScale() *
+						mScales[_getScaleIndex(mNodes[n].parent)];
+			}
+		}
+
+		/**
+		 *  A list which gains or loses items has its leaves brought up to date when time is
+		 *  next added. A leaf which becomes a list that can be flattened means compiling again.
+		 *
+		 *  @param slot   The slot of the changed object
+		 */
+		void _onChildRestructured( unsigned slot )
+		{
+			if( slot & NODE_BIT )
+				_setChanged(slot & ~NODE_BIT);
+			else
+				_restructureLeaf(slot);
+		}
+
+		/**
+		 *  Compiles again if a leaf has become a list which can be flattened
+		 *
+		 *  @param leaf   Index of the leaf
+		 */
+		void _restructureLeaf( unsigned leaf )
+		{
+			mChildren.clear();
+
+			if( mLeaves[leaf].object->_getScheduleChildren(mChildren) )
+				_setStale();
+		}
+
+		/**
+		 *  Looks up an object already in the schedule, as a list or a leaf
+		 *
+		 *  @param object   The object
+		 *  @param slot     Receives its slot, if it is there
+		 *  @return         Whether it is there
+		 */
+		bool _find( const OverRated::UpdatedObject * object, unsigned & slot ) const
+		{
+			if( object->_findParent(this, slot) )
+				return true;
+
+			slot = _findLeaf(object);
+			return slot != NO_LEAF;
+		}
+
+		/**
+		 *  @param object   An object
+		 *  @return         Where to start looking for it in mLeafTable
+		 */
+		unsigned _getBucket( const OverRated::UpdatedObject * object ) const
+		{
+			std::size_t bits = reinterpret_cast<std::size_t>(object);
+
+			return unsigned((bits >> 4) * 2654435761u) & unsigned(mLeafTable.size() - 1);
+		}
+
+		/**
+		 *  @param object   An object
+		 *  @return         Index of its leaf inside a list, or NO_LEAF if it has none
+		 */
+		unsigned _findLeaf( const OverRated::UpdatedObject * object ) const
+		{
+			if( mLeafTable.empty() )
+				return NO_LEAF;
+
+			const unsigned mask = mLeafTable.size() - 1;
+
+			for( unsigned i = _getBucket(object); mLeafTable[i].object; i = (i + 1) & mask ) {
+				if( mLeafTable[i].object == object )
+					return mLeafTable[i].leaf;
+			}
+
+			return NO_LEAF;
+		}
+
+		/**
+		 *  Records the leaf of an object inside a list, keeping the table at most half full
+		 *
+		 *  @param object   The object, which mustn't already be in the table
+		 *  @param leaf     Index of its leaf
+		 */
+		void _insertLeaf( OverRated::UpdatedObject * object, unsigned leaf )
+		{
+			if( (mLeafTableCount + 1) * 2 > mLeafTable.size() ) {
+				std::vector<LeafEntry> old;
+
+				old.swap(mLeafTable);
+				mLeafTable.resize(old.empty() ? 16 : old.size() * 2);
+				mLeafTableCount = 0;
+
+				for( unsigned i = 0; i < old.size(); i++ ) {
+					if( old[i].object )
+						_insertLeaf(old[i].object, old[i].leaf);
+				}
+			}
+
+			const unsigned mask = mLeafTable.size() - 1;
+			unsigned i = _getBucket(object);
+
+			while( mLeafTable[i].object )
+				i = (i + 1) & mask;
+
+			mLeafTable[i] = LeafEntry(object, leaf);
+			mLeafTableCount++;
+		}
+
+		/**
+		 *  Forgets the leaf of an object inside a list
+		 *
+		 *  @param object   The object, which must be in the table
+		 */
+		void _eraseLeaf( const OverRated::UpdatedObject * object )
+		{
+			const unsigned mask = mLeafTable.size() - 1;
+			unsigned gap = _getBucket(object);
+
+			while( mLeafTable[gap].object != object )
+				gap = (gap + 1) & mask;
+
+			// Entries further on which had to go past the gap move back into it, so that
+			// looking them up never stops short at an empty entry
+			for( unsigned i = (gap + 1) & mask; mLeafTable[i].object; i = (i + 1) & mask ) {
+				unsigned start = _getBucket(mLeafTable[i].object);
+
+				if( ((i - start) & mask) >= ((i - gap) & mask) ) {
+					mLeafTable[gap] = mLeafTable[i];
+					gap = i;
+				}
+			}
+
+			mLeafTable[gap] = LeafEntry();
+			mLeafTableCount--;
+		}
+
+		/**
+		 *  Lets the leaves beneath a list run again, if neither it nor a list above it is paused.
+		 *  Lists beneath it which are paused themselves keep their leaves out.
+		 *
+		 *  @param first   Index of the list
+		 */
+		void _unmask( unsigned first )
+		{
+			if( mIsStale )
+				return;
+
+			Node & node = mNodes[first];
+
+			if( !node.isMasked || node.object->getIsPaused() || _getIsMasked(node.parent) )
+				return;
+
+			node.isMasked = false;
+
+			for( unsigned n = first; n < node.endNode; n++ ) {
+				const std::vector<unsigned> & leaves = mNodes[n].leaves;
+
+				if( n != first ) {
+					mNodes[n].isMasked = mNodes[n].object->getIsPaused() ||
+							mNodes[mNodes[n].parent].isMasked;
+				}
+
+				for( unsigned i = 0; i < leaves.size(); i++ ) {
+					if( mLeaves[leaves[i]].index >= mActiveCount && _getCanRun(leaves[i]) )
+						_activate(mLeaves[leaves[i]].index);
+				}
+			}
+		}
+
+		/**
+		 *  @param node   Index of a list, or NO_NODE
+		 *  @return       Whether that list or one above it is paused
+		 */
+		bool _getIsMasked( unsigned node ) const
+		{
+			return node != NO_NODE && mNodes[node].isMasked;
+		}
+
+		/**
+		 *  @param node   Index of a list, or NO_NODE
+		 *  @return       Where the time scale of the leaves directly in that list is in mScales
+		 */
+		static unsigned _getScaleIndex( unsigned node )
+		{
+			return (node == NO_NODE) ? 0 : node + 1;
+		}
+
+		/**
+		 *  @param leaf   Index of a leaf
+		 *  @return       Whether the leaf has anything to do when time is added
+		 */
+		bool _getCanRun( unsigned leaf ) const
+		{
+			const Leaf & entry = mLeaves[leaf];
+
+			return !_getIsMasked(entry.node) && !entry.object->getIsPaused() &&
+					!entry.object->getIsIdle();
+		}
+
+		/**
+		 *  Moves an inactive leaf to the end of the active ones
+		 *
+		 *  @param index   Position of the leaf in mItems
+		 */
+		void _activate( unsigned index )
+		{
+			_swap(index, mActiveCount);
+			mActiveCount++;
+		}
+
+		/**
+		 *  Moves an active leaf to the start of the inactive ones
+		 *
+		 *  @param index   Position of the leaf in mItems
+		 */
+		void _deactivate( unsigned index )
+		{
+			mActiveCount--;
+			_swap(index, mActiveCount);
+		}
+
+		/**
+		 *  Exchanges the positions of two leaves in mItems
+		 *
+		 *  @param first    Position of one leaf
+		 *  @param second   Position of the other
+		 */
+		void _swap( unsigned first, unsigned second )
+		{
+			OverRated::UpdatedObject * item = mItems[first];
+			unsigned leaf = mLeafOf[first];
+			unsigned scale = mScaleOf[first];
+
+			mItems[first] = mItems[second];
+			mLeafOf[first] = mLeafOf[second];
+			mScaleOf[first] = mScaleOf[second];
+			mItems[second] = item;
+			mLeafOf[second] = leaf;
+			mScaleOf[second] = scale;
+
+			mLeaves[mLeafOf[first]].index = first;
+			mLeaves[mLeafOf[second]].index = second;
+		}
+
+	private:
+		static const unsigned NO_NODE = ~0u;
+		static const unsigned NO_LEAF = ~0u;
+
+		// Slots of lists have this bit set; slots of leaves don't
+		static const unsigned NODE_BIT = 1u << 31;
+
+		// An object updated by the schedule. A free leaf has no object, and its node is the
+		// next free leaf.
+		struct Leaf
+		{
+			Leaf( OverRated::UpdatedObject * object, unsigned node, unsigned index )
+			: object(object), node(node), index(index), position(0), pass(0)
+			{}
+
+			OverRated::UpdatedObject * object;
+			unsigned node;			// The list it is in, or NO_NODE for the root
+			unsigned index;			// Where it is in mItems
+			unsigned position;		// Where it is in its list's leaves
+			unsigned pass;			// The last _patchNode() which found it
+		};
+
+		// Where the leaf of an object inside a list is. Empty entries have no object.
+		struct LeafEntry
+		{
+			LeafEntry() : object(0), leaf(0) {}
+			LeafEntry( OverRated::UpdatedObject * object, unsigned leaf )
+			: object(object), leaf(leaf)
+			{}
+
+			OverRated::UpdatedObject * object;
+			unsigned leaf;
+		};
+
+		// A list flattened into the schedule, NULL once destroyed. The lists beneath it follow
+		// on from it, so they form one range.
+		struct Node
+		{
+			Node( OverRated::UpdatedObject * object, unsigned parent )
+			: object(object), parent(parent), endNode(0), pass(0), isMasked(false),
+			  isChanged(false)
+			{}
+
+			OverRated::UpdatedObject * object;
+			unsigned parent;				// The list it is in, or NO_NODE for the root
+			unsigned endNode;				// One past the last list beneath it
+			unsigned pass;					// The last _patchNode() which found it
+			std::vector<unsigned> leaves;	// The leaves directly in it
+			bool isMasked;					// Whether it or a list above it is paused
+			bool isChanged;					// Whether it is waiting in mChangedNodes
+		};
+
+		OverRated::UpdatedObject * mRoot;	// The top of the tree, if any
+		std::vector<Node> mNodes;			// Every flattened list, depth first
+		std::vector<Leaf> mLeaves;			// Every leaf, in no particular order
+		unsigned mFreeLeaf;					// First free leaf, or NO_LEAF
+		std::vector<double> mScales;		// 1, then the time scale within each list
+		std::vector<OverRated::UpdatedObject*> mItems;	// The leaves, active ones first
+		std::vector<unsigned> mLeafOf;		// The leaf at each position of mItems
+		std::vector<unsigned> mScaleOf;		// Its time scale's index in mScales
+		unsigned mActiveCount;				// Number of active leaves at the front of mItems
+		bool mIsStale;						// Whether the tree needs compiling again
+		std::vector<unsigned> mChangedNodes;	// Lists whose leaves need bringing up to date
+		unsigned mPass;						// Count of _patchNode() calls, to mark what it finds
+		std::vector<OverRated::UpdatedObject*> mChildren;	// Scratch space for the tree
+		std::vector<OverRated::UpdatedObject*> mProbe;		// Scratch space for one object
+		std::vector<LeafEntry> mLeafTable;	// Leaves inside lists by object, a power of 2 long
+		unsigned mLeafTableCount;			// Number of entries in mLeafTable in use
+	};
+}
+
+#endif // OVERRATED_UPDATESCHEDULE_H_DEFINED__
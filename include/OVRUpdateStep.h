@@ -0,0 +1,352 @@
+/**
+ *	Update Step Functions
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATESTEP_H_DEFINED__
+#define OVERRATED_UPDATESTEP_H_DEFINED__
+
+#include <cmath>
+
+#include "OVRUpdateMethod.h"
+
+// This header defines the individual pieces of the linear and looped update methods as plain
+// functions. The methods themselves are built out of them, and so are the containers which step
+// many values at once without going through an UpdateMethod instance. Keeping them in one place
+// guarantees that every path produces exactly the same results.
+
+namespace OverRated
+{
+	/**
+	 *  Moves a value by a magnitude in the given direction
+	 *
+	 *  @param value       The value to move
+	 *  @param dir         The direction to move it in
+	 *  @param magnitude   The amount to move it by
+	 *  @return            The moved value
+	 */
+	template <typename T>
+	T StepApplyDirection( const T & value, OverRated::ConstDirection dir, const T & magnitude )
+	{
+		T result( value );
+
+		if( dir == OverRated::CD_INCREASING )
+			result += magnitude;
+		else
+			result -= magnitude;
+
+		return result;
+	}
+
+	/**
+	 *  The best direction on a linear number model; increase if the target's greater, decrease
+	 *  if it's less.
+	 *
+	 *  @param value    The current value
+	 *  @param target   The value to reach
+	 *  @return         The best direction
+	 */
+	template <typename T>
+	OverRated::ConstDirection StepLinearDirection( const T & value, const T & target )
+	{
+		if( target > value )
+			return OverRated::CD_INCREASING;
+		else
+			return OverRated::CD_DECREASING;
+	}
+
+	/**
+	 *  Reverts a linear result to the target if the update passed over it
+	 *
+	 *  @param result          The result to check, passed by reference so it can be changed
+	 *  @param originalValue   The value prior to the update which created the result
+	 *  @param target          The targeted value
+	 *  @return                Whether the result was reverted to the target
+	 */
+	template <typename T>
+	bool StepLinearSnap( T & result, const T & originalValue, const T & target )
+	{
+		if( !OverRated::UtilRangeCheck(target, originalValue, result) )
+			return false;
+
+		result = target;
+		return true;
+	}
+
+	/**
+	 *  Loops a value which has passed a bound of the range around to the other bound, surpassing
+	 *  it by the same magnitude that it exceeded the first.
+	 *
+	 *  @param value   The value to loop, passed by reference so it can be changed
+	 *  @param min     Minimum of the looping range
+	 *  @param max     Maximum of the looping range
+	 */
+	template <typename T>
+	void StepLoopedWrap( T & value, const T & min, const T & max )
+	{
+		if( value > max )
+			value = min + (value - max);
+		else if( value < min )
+			value = max + (value - min);
+
+		// If the loop made it still go over a range, push it back to whichever is closest
+		OverRated::UtilBindValueToRange(value, min, max);
+	}
+
+	/**
+	 *  The best direction in a looped range is whichever way around is shortest.
+	 *
+	 *  @param value    The current value
+	 *  @param target   The value to reach
+	 *  @param min      Minimum of the looping range
+	 *  @param max      Maximum of the looping range
+	 *  @return         The best direction
+	 */
+	template <typename T>
+	OverRated::ConstDirection StepLoopedDirection( const T & value, const T & target,
+			const T & min, const T & max )
+	{
+		T forward_distance = OverRated::UtilDist(value, target);
+		T backward_distance = OverRated::UtilDist(OverRated::UtilMin(value, target), min) +
+				OverRated::UtilDist(OverRated::UtilMax(value, target), max);
+
+		if( forward_distance <= backward_distance )
+			return (value <= target) ? OverRated::CD_INCREASING : OverRated::CD_DECREASING;
+		else
+			return (value <= target) ? OverRated::CD_DECREASING : OverRated::CD_INCREASING;
+	}
+
+	/**
+	 *  Determines whether a looped update passed the target, taking into account whether the
+	 *  update caused a loop, and reverts the result to the target if so. The result is looped
+	 *  back into the range as a side effect.
+	 *
+	 *  @param result          The result to check, passed by reference so it can be changed
+	 *  @param originalValue   The value prior to the update which created the result
+	 *  @param target          The targeted value
+	 *  @param min             Minimum of the looping range
+	 *  @param max             Maximum of the looping range
+	 *  @return                Whether the result was reverted to the target
+	 */
+	template <typename T>
+	bool StepLoopedSnap( T & result, const T & originalValue, const T & target,
+			const T & min, const T & max )
+	{
+		// If the result is still in the range, the only way the target could have been
+		// passed is if it is between the original value and the result, much like the
+		// linear method.
+		if( OverRated::UtilRangeCheck(result, min, max) ) {
+			if( !OverRated::UtilRangeCheck(target, originalValue, result) )
+				return false;
+		}
+		// if the result passed either bound of the range, it should loop. After looping,
+		// the target is passed if it is between the bound we looped to and the final result.
+		else {
+			T marker = (result > max) ? min : max; // The bound we looped to
+
+			OverRated::StepLoopedWrap(result, min, max);
+
+			if( !OverRated::UtilRangeCheck(target, result, marker) )
+				return false;
+		}
+
+		result = target;
+		return true;
+	}
+
+	/**
+	 *  Loops a value back into the range no matter how many times it has gone around. Whole
+	 *  laps are taken off first, and the rest is looped just as StepLoopedWrap() would.
+	 *
+	 *  @param value   The value to loop
+	 *  @param min     Minimum of the looping range
+	 *  @param max     Maximum of the looping range
+	 *  @return        The value within the range
+	 */
+	template <typename T>
+	T StepLoopedWrapLaps( const T & value, const T & min, const T & max )
+	{
+		T range = max - min;
+		T result( value );
+
+		if( result > max )
+			result -= range * T(static_cast<long long>((result - max) / range));
+		else if( result < min )
+			result += range * T(static_cast<long long>((min - result) / range));
+
+		OverRated::StepLoopedWrap(result, min, max);
+		return result;
+	}
+
+	/**
+	 *  The distance from a value to a target going around a looped range in one direction
+	 *
+	 *  @param value    The value to start from, within the range
+	 *  @param target   The value to reach, within the range
+	 *  @param dir      The direction to go in
+	 *  @param min      Minimum of the looping range
+	 *  @param max      Maximum of the looping range
+	 *  @return         The distance travelled
+	 */
+	template <typename T>
+	T StepLoopedDistance( const T & value, const T & target, OverRated::ConstDirection dir,
+			const T & min, const T & max )
+	{
+		if( dir == OverRated::CD_INCREASING )
+			return (target >= value) ? target - value : (max - value) + (target - min);
+		else
+			return (value >= target) ? value - target : (value - min) + (max - target);
+	}
+
+	/**
+	 *  A full update of a value on a linear model towards a value target
+	 *
+	 *  @param value       The value to update
+	 *  @param target      The value to reach
+	 *  @param magnitude   The amount of change to apply (rate * time)
+	 *  @return            The value after updating
+	 */
+	template <typename T>
+	T StepLinearToValue( const T & value, const T & target, const T & magnitude )
+	{
+		T result = OverRated::StepApplyDirection(value,
+				OverRated::StepLinearDirection(value, target), magnitude);
+
+		OverRated::StepLinearSnap(result, value, target);
+		return result;
+	}
+
+	/**
+	 *  A full update of a value in a looped range towards a value target, going in a forced
+	 *  direction rather than the shortest one.
+	 *
+	 *  @param value       The value to update
+	 *  @param target      The value to reach
+	 *  @param magnitude   The amount of change to apply (rate * time)
+	 *  @param min         Minimum of the looping range
+	 *  @param max         Maximum of the looping range
+	 *  @param dir         The direction to go in
+	 *  @return            The value after updating
+	 */
+	template <typename T>
+	T StepLoopedToValue( const T & value, const T & target, const T & magnitude,
+			const T & min, const T & max, OverRated::ConstDirection dir )
+	{
+		T original( value );
+
+		OverRated::StepLoopedWrap(original, min, max);
+
+		T result = OverRated::StepApplyDirection(original, dir, magnitude);
+
+		OverRated::StepLoopedSnap(result, original, target, min, max);
+		return result;
+	}
+
+	/**
+	 *  A full update of a value in a looped range towards a value target
+	 *
+	 *  @param value       The value to update
+	 *  @param target      The value to reach
+	 *  @param magnitude   The amount of change to apply (rate * time)
+	 *  @param min         Minimum of the looping range
+	 *  @param max         Maximum of the looping range
+	 *  @return            The value after updating
+	 */
+	template <typename T>
+	T StepLoopedToValue( const T & value, const T & target, const T & magnitude,
+			const T & min, const T & max )
+	{
+		return OverRated::StepLoopedToValue(value, target, magnitude, min, max,
+				OverRated::StepLoopedDirection(value, target, min, max));
+	}
+
+	/**
+	 *  A full update of a value in a looped range in a constant direction
+	 *
+	 *  @param value       The value to update
+	 *  @param dir         The direction to go in
+	 *  @param magnitude   The amount of change to apply (rate * time)
+	 *  @param min         Minimum of the looping range
+	 *  @param max         Maximum of the looping range
+	 *  @return            The value after updating
+	 */
+	template <typename T>
+	T StepLoopedInDirection( const T & value, OverRated::ConstDirection dir,
+			const T & magnitude, const T & min, const T & max )
+	{
+		T original( value );
+
+		OverRated::StepLoopedWrap(original, min, max);
+
+		T result = OverRated::StepApplyDirection(original, dir, magnitude);
+
+		OverRated::StepLoopedWrap(result, min, max);
+		return result;
+	}
+
+	/**
+	 *  A full update of a vector value towards a target along the straight line between them.
+	 *  The components of the value are spaced out by a stride, so this serves both a single
+	 *  vector (stride 1) and one vector out of arrays holding each component in turn (stride of
+	 *  the array length). The value arrives, and is set exactly to the target, as a whole.
+	 *
+	 *  @param value       The first component of the value, updated in place
+	 *  @param target      The first component of the target
+	 *  @param size        Number of components
+	 *  @param stride      Distance between components
+	 *  @param magnitude   The distance to move (rate * time)
+	 *  @return            Whether the value arrived at the target
+	 */
+	template <typename T>
+	bool StepVectorToValue( T * value, const T * target, unsigned size, unsigned stride,
+			const T & magnitude )
+	{
+		T distanceSquared(0);
+
+		for( unsigned i = 0; i < size; i++ ) {
+			T offset = target[i * stride] - value[i * stride];
+
+			distanceSquared = distanceSquared + offset * offset;
+		}
+
+		T distance = T(std::sqrt(distanceSquared));
+
+		if( distance <= magnitude ) {
+			for( unsigned i = 0; i < size; i++ )
+				value[i * stride] = target[i * stride];
+
+			return true;
+		}
+
+		T fraction = magnitude / distance;
+
+		for( unsigned i = 0; i < size; i++ )
+			value[i * stride] = value[i * stride] +
+					(target[i * stride] - value[i * stride]) * fraction;
+
+		return false;
+	}
+}
+
+#endif // OVERRATED_UPDATESTEP_H_DEFINED__
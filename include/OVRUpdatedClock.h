@@ -0,0 +1,71 @@
+/**
+ *	UpdatedClock Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEDCLOCK_H_DEFINED__
+#define OVERRATED_UPDATEDCLOCK_H_DEFINED__
+
+#include "OVRUpdatedObject.h"
+
+namespace OverRated
+{
+	/**
+	 *  An UpdatedObject which does nothing but add up the time it is given. Values which work
+	 *  out their state from a point in time ( @see UpdatedValueLazy ) share one of these rather
+	 *  than each being updated, so adding it to a list is all the ticking they need. Pausing
+	 *  the clock pauses everything which reads it.
+	 */
+	class UpdatedClock : public OverRated::UpdatedObject
+	{
+	public:
+		UpdatedClock()
+		: mTime( 0.0 )
+		{}
+
+		/**
+		 *  @return   The total time added while unpaused, in seconds
+		 */
+		double getTime() const
+		{
+			return mTime;
+		}
+
+	private:
+		/**
+		 *  Moves the clock on
+		 *
+		 *  @param timeElapsed   The amount of time that has passed in seconds (1.0 = 1 sec)
+		 */
+		void _addTime( const double & timeElapsed )
+		{
+			mTime += timeElapsed;
+		}
+
+	private:
+		double mTime;	// Total time so far, in seconds
+	};
+}
+
+#endif // OVERRATED_UPDATEDCLOCK_H_DEFINED__
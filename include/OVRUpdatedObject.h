@@ -27,34 +27,274 @@
 #ifndef OVERRATED_UPDATEDOBJECT_H_DEFINED__
 #define OVERRATED_UPDATEDOBJECT_H_DEFINED__
 
+#include <cmath>
+#include <vector>
+
 namespace OverRated
 {
+	class UpdatedObject;
+	class UpdateSchedule;
+	template <typename T> class UpdatedObjectList;
+	template <typename V> class UpdatedValueList;
+
+	/**
+	 *  Anything which keeps track of UpdatedObject's, such as a list. Objects remember which
+	 *  parents they have been added to, and under which slot, so that a parent can find an
+	 *  object without searching and can be told when one of its objects goes away.
+	 */
+	class UpdatedObjectParent
+	{
+	public:
+		virtual ~UpdatedObjectParent() {}
+
+	protected:
+		friend class OverRated::UpdatedObject;
+
+		/**
+		 *  Called when an object that was added to this parent is destroyed. The parent must
+		 *  forget the object without touching it.
+		 *
+		 *  @param slot   The slot the object was added under
+		 */
+		virtual void _onChildDestroyed( unsigned slot ) = 0;
+
+		/**
+		 *  Called when an object that was added to this parent may have work to do again after
+		 *  being idle or paused ( @see UpdatedObject::wake() ).
+		 *
+		 *  @param slot   The slot the object was added under
+		 */
+		virtual void _onChildWoken( unsigned slot ) = 0;
+
+		/**
+		 *  Called when an object that was added to this parent is paused
+		 *
+		 *  @param slot   The slot the object was added under
+		 */
+		virtual void _onChildPaused( unsigned slot )
+		{}
+
+		/**
+		 *  Called when an object that was added to this parent has its time scale changed
+		 *
+		 *  @param slot   The slot the object was added under
+		 */
+		virtual void _onChildRescaled( unsigned slot )
+		{}
+
+		/**
+		 *  Called when an object that was added to this parent changes what it is made of, such
+		 *  as a list having items added or removed ( @see UpdatedObject::_getScheduleChildren() )
+		 *
+		 *  @param slot   The slot the object was added under
+		 */
+		virtual void _onChildRestructured( unsigned slot )
+		{}
+
+		/**
+		 *  Called when an item of an object that was added to this parent, which passes time
+		 *  on to its items ( @see UpdatedObject::_getScheduleChildren() ), may have work to do
+		 *  again. A parent updating those items directly can keep track of them through these
+		 *  calls rather than being added to each one.
+		 *
+		 *  @param slot   The slot the object was added under
+		 *  @param item   The woken item
+		 */
+		virtual void _onItemWoken( unsigned slot, OverRated::UpdatedObject * item )
+		{}
+
+		/**
+		 *  Called when an item is taken out of an object that was added to this parent, or is
+		 *  destroyed. The item must not be touched.
+		 *
+		 *  @param slot   The slot the object was added under
+		 *  @param item   The item taken out
+		 */
+		virtual void _onItemRemoved( unsigned slot, OverRated::UpdatedObject * item )
+		{}
+
+		/**
+		 *  Called when an item of an object that was added to this parent changes what it is
+		 *  made of ( @see _onChildRestructured() )
+		 *
+		 *  @param slot   The slot the object was added under
+		 *  @param item   The changed item
+		 */
+		virtual void _onItemRestructured( unsigned slot, OverRated::UpdatedObject * item )
+		{}
+	};
+
 	/**
 	 *  Any class that needs to receive regular time updates. Updates are ignored if the instance
-	 *  is 'paused'. That is the only thing abstracted at this level. For now at least, this
-	 *  exists so that UpdatedValue can subclass it.
+	 *  is 'paused'. Beyond that, this level only keeps track of which parents the object has
+	 *  been added to. For now at least, this exists so that UpdatedValue can subclass it.
+	 *
+	 *  Time can optionally be applied in fixed steps, whatever the lengths of time added
+	 *  ( @see setFixedStep() ), and sped up or slowed down ( @see setTimeScale() ).
 	 */
 	class UpdatedObject
 	{
 	public:
 		UpdatedObject()
-		: mIsPaused( false )
+		: mFirstParent( 0 ), mExtras( 0 ), mFirstSlot( 0 ), mIsPaused( false ),
+		  mIdleAfterUpdate( IS_UNKNOWN )
 		{}
 
+		/**
+		 *  Copies only the pause, fixed step and time scale states. The copy does not belong to
+		 *  any of the parents the original was added to.
+		 */
+		UpdatedObject( const UpdatedObject & other )
+		: mFirstParent( 0 ), mExtras( 0 ), mFirstSlot( 0 ), mIsPaused( other.mIsPaused ),
+		  mIdleAfterUpdate( IS_UNKNOWN )
+		{
+			_copyTiming(other);
+		}
+
+		/**
+		 *  Destruction removes the object from any parents it was added to
+		 */
 		virtual ~UpdatedObject()
-		{}
+		{
+			_notifyParents(&UpdatedObjectParent::_onChildDestroyed);
+			delete mExtras;
+		}
 
 		/**
-		 *  If unpaused, add the elapsed time in seconds
+		 *  Assigns only the pause, fixed step and time scale states; parents are not affected.
+		 */
+		UpdatedObject & operator=( const UpdatedObject & other )
+		{
+			if( this == &other )
+				return *this;
+
+			mIsPaused = other.mIsPaused;
+			_copyTiming(other);
+			return *this;
+		}
+
+		/**
+		 *  If unpaused, add the elapsed time in seconds, multiplied by the time scale
+		 *  ( @see setTimeScale() ). With a fixed step, the scaled time is saved up and applied
+		 *  in whole steps ( @see setFixedStep() ).
 		 *
 		 *  @param timeElapsed   Amount of time that has passed in seconds (1.0 = 1 sec)
 		 */
 		void addTime( double timeElapsed )
 		{
-			if( !getIsPaused() )
+			if( getIsPaused() )
+				return;
+
+			if( !mExtras ) {
+				_addTime( timeElapsed );
+				return;
+			}
+
+			timeElapsed *= mExtras->timeScale;
+
+			if( mExtras->fixedStep > 0.0 )
+				_addFixedSteps( timeElapsed );
+			else
 				_addTime( timeElapsed );
 		}
 
+		/**
+		 *  Has time applied in steps of exactly the same length, however unevenly it is added.
+		 *  The result of a run of updates then doesn't depend on the frame rate or on jitter.
+		 *  Time left over which doesn't make a whole step waits for the next addTime(). Readers
+		 *  who want to see values between steps can use getPendingTime() or
+		 *  getInterpolationAlpha(), such as with UpdatedValue::getValueAhead().
+		 *
+		 *  To stop a long stall turning into a long burst of steps, at most maxSteps are taken in
+		 *  one addTime(); any whole steps beyond that are dropped, as if the object had been
+		 *  paused for that long.
+		 *
+		 *  @param step       Length of a step in seconds, or 0 to apply time as it is added
+		 *  @param maxSteps   Most steps to take at once, or 0 for no limit
+		 */
+		void setFixedStep( double step, unsigned maxSteps = 8 )
+		{
+			step = (step > 0.0) ? step : 0.0;
+
+			if( step > 0.0 || mExtras ) {
+				Extras & extras = _getExtras();
+
+				extras.fixedStep = step;
+				extras.maxSteps = maxSteps;
+				extras.pendingTime = 0.0;
+				_trimExtras();
+			}
+
+			_restructured();
+		}
+
+		/**
+		 *  @return   Length of a fixed step in seconds, or 0 if there isn't one
+		 */
+		double getFixedStep() const
+		{
+			return mExtras ? mExtras->fixedStep : 0.0;
+		}
+
+		/**
+		 *  @return   Most fixed steps taken at once, or 0 for no limit
+		 */
+		unsigned getMaxSteps() const
+		{
+			return mExtras ? mExtras->maxSteps : 0;
+		}
+
+		/**
+		 *  @return   Time added but not yet applied because it doesn't make a whole fixed step
+		 */
+		double getPendingTime() const
+		{
+			return mExtras ? mExtras->pendingTime : 0.0;
+		}
+
+		/**
+		 *  @return   How far through the next fixed step the pending time is, from 0 to 1; 0 if
+		 *            there is no fixed step
+		 */
+		double getInterpolationAlpha() const
+		{
+			if( !mExtras || mExtras->fixedStep <= 0.0 )
+				return 0.0;
+
+			return mExtras->pendingTime / mExtras->fixedStep;
+		}
+
+		/**
+		 *  Speeds up or slows down the time this object is given. A list passes on the time it
+		 *  is given, once scaled, so scaling a list scales everything in it (and in lists within
+		 *  it) in one go, without touching the items or their methods. Methods can then still be
+		 *  shared between lists running at different speeds. The time scale can itself be
+		 *  changed smoothly over time ( @see UpdatedValueTimeScale ).
+		 *
+		 *  @param scale   Multiplier for time added; 1 for normal speed, 0 to stand still
+		 *                 (negative numbers are treated as 0)
+		 */
+		void setTimeScale( double scale )
+		{
+			scale = (scale > 0.0) ? scale : 0.0;
+
+			if( scale == getTimeScale() )
+				return;
+
+			_getExtras().timeScale = scale;
+			_trimExtras();
+
+			_notifyParents(&UpdatedObjectParent::_onChildRescaled);
+		}
+
+		/**
+		 *  @return   Multiplier for time added to this object
+		 */
+		double getTimeScale() const
+		{
+			return mExtras ? mExtras->timeScale : 1.0;
+		}
+
 		/**
 		 *  Getter for the paused state
 		 *
@@ -72,7 +312,63 @@ namespace OverRated
 		 */
 		void setIsPaused( bool paused )
 		{
+			bool was_paused = mIsPaused;
+
 			mIsPaused = paused;
+
+			if( was_paused && !paused )
+				wake();
+			else if( !was_paused && paused )
+				_notifyParents(&UpdatedObjectParent::_onChildPaused);
+		}
+
+		/**
+		 *  Whether adding time would currently do nothing at all, such as for a value which has
+		 *  reached its target. Containers use this to stop visiting objects until they are woken.
+		 *  Objects which can't tell should leave this returning false.
+		 *
+		 *  @return   Whether the object is idle
+		 */
+		virtual bool getIsIdle() const
+		{
+			return false;
+		}
+
+		/**
+		 *  Whether the object has got to where it was going, such as a value which has reached
+		 *  its target. Objects with no such end should leave this returning false.
+		 *
+		 *  @return   Whether the object is finished
+		 */
+		virtual bool getIsFinished() const
+		{
+			return false;
+		}
+
+		/**
+		 *  How much more time the object expects to need before getIsFinished() is true, if
+		 *  nothing changes along the way. Lists use this to check on objects only around when
+		 *  they should finish ( @see UpdatedObjectList::addCompletion() ). This is time as the
+		 *  object sees it, once its own time scale has been applied.
+		 *
+		 *  @return   Time in seconds, 0 if it can't tell (so it is checked on every update), or
+		 *            a negative number if it won't finish unless something changes and wakes it
+		 */
+		virtual double getTimeToFinish() const
+		{
+			return -1.0;
+		}
+
+		/**
+		 *  Tells any parents this object was added to that it may have work to do again. This
+		 *  happens automatically when the object is unpaused, when a value is given a new method
+		 *  or value, and so on; call it yourself after changing something the object can't see,
+		 *  such as the variable behind an UpdatedValueRef.
+		 */
+		void wake()
+		{
+			mIdleAfterUpdate = IS_UNKNOWN;
+			_notifyParents(&UpdatedObjectParent::_onChildWoken);
 		}
 
 	protected:
@@ -83,8 +379,382 @@ namespace OverRated
 		 */
 		virtual void _addTime( const double & timeElapsed ) = 0;
 
+		/**
+		 *  Objects which do nothing when time is added but pass it on to other objects, such as
+		 *  lists, give those objects here. An UpdateSchedule can then update them directly
+		 *  rather than going through this object. Call _restructured() whenever the answer
+		 *  would change, and tell parents about the objects given through _itemWoken(),
+		 *  _itemRemoved() and _itemRestructured().
+		 *
+		 *  @param children   Receives the objects time is passed on to
+		 *  @return           Whether time is only passed on; false to be updated as a whole
+		 */
+		virtual bool _getScheduleChildren( std::vector<OverRated::UpdatedObject*> & children )
+		{
+			return false;
+		}
+
+		/**
+		 *  Objects which carry out commands queued by other threads, such as a list with a
+		 *  CommandQueue, say so here, as do objects holding any such object. Call
+		 *  _restructured() whenever the answer would change.
+		 *
+		 *  @return   Whether _applyCommands() has anything to do
+		 */
+		virtual bool _getHasCommands() const
+		{
+			return false;
+		}
+
+		/**
+		 *  Carries out any commands queued for this object and the objects it holds now, rather
+		 *  than when time is next added. A list updating its items in parallel calls this first,
+		 *  so that the commands are carried out on its own thread.
+		 */
+		virtual void _applyCommands()
+		{}
+
+		/**
+		 *  Tells any parents this object was added to that _getScheduleChildren() has changed
+		 */
+		void _restructured()
+		{
+			_notifyParents(&UpdatedObjectParent::_onChildRestructured);
+		}
+
+		/**
+		 *  Tells any parents this object was added to that one of its items was woken
+		 *
+		 *  @param item   The item
+		 */
+		void _itemWoken( OverRated::UpdatedObject * item )
+		{
+			_notifyParents(&UpdatedObjectParent::_onItemWoken, item);
+		}
+
+		/**
+		 *  Tells any parents this object was added to that one of its items was taken out
+		 *
+		 *  @param item   The item
+		 */
+		void _itemRemoved( OverRated::UpdatedObject * item )
+		{
+			_notifyParents(&UpdatedObjectParent::_onItemRemoved, item);
+		}
+
+		/**
+		 *  Tells any parents this object was added to that one of its items was restructured
+		 *
+		 *  @param item   The item
+		 */
+		void _itemRestructured( OverRated::UpdatedObject * item )
+		{
+			_notifyParents(&UpdatedObjectParent::_onItemRestructured, item);
+		}
+
+		/**
+		 *  Objects which find out in _addTime() whether they are now idle can say so here, so
+		 *  that the list updating them needn't ask getIsIdle() straight afterwards. The answer
+		 *  holds until the next _addTime() or wake().
+		 *
+		 *  @param idle   Whether getIsIdle() would now return true
+		 */
+		void _setIsIdleAfterUpdate( bool idle )
+		{
+			mIdleAfterUpdate = idle ? IS_IDLE : IS_BUSY;
+		}
+
+	private:
+		friend class OverRated::UpdateSchedule;
+		template <typename T> friend class OverRated::UpdatedObjectList;
+		template <typename V> friend class OverRated::UpdatedValueList;
+
+		// A parent this object has been added to, and the slot it was added under
+		struct ParentLink
+		{
+			ParentLink() : parent(0), slot(0) {}
+			ParentLink( OverRated::UpdatedObjectParent * parent, unsigned slot )
+			: parent(parent), slot(slot) {}
+
+			OverRated::UpdatedObjectParent * parent;
+			unsigned slot;
+		};
+
+		// Everything most objects never use, kept out of line so that objects stay small. It
+		// only exists while something in it differs from the defaults.
+		struct Extras
+		{
+			Extras() : fixedStep(0.0), maxSteps(0), pendingTime(0.0), timeScale(1.0) {}
+
+			double fixedStep;						// Length of a fixed step, or 0 for none
+			unsigned maxSteps;						// Most fixed steps at once, or 0 for no limit
+			double pendingTime;						// Time saved up towards the next fixed step
+			double timeScale;						// Multiplier for time added
+			ParentLink secondParent;				// Such as an UpdateSchedule over a list
+			std::vector<ParentLink> moreParents;	// Parents after the second, which is unusual
+		};
+
+		typedef void (OverRated::UpdatedObjectParent::*ParentCallback)( unsigned slot );
+		typedef void (OverRated::UpdatedObjectParent::*ItemCallback)( unsigned slot,
+				OverRated::UpdatedObject * item );
+
+		// What the last _addTime() found out about being idle ( @see _setIsIdleAfterUpdate() )
+		enum IdleState
+		{
+			IS_UNKNOWN,		// Nothing, so getIsIdle() has to be asked
+			IS_BUSY,
+			IS_IDLE
+		};
+
+		/**
+		 *  For lists, straight after adding time: the same as getIsIdle(), but without asking
+		 *  again when the update has already said
+		 *
+		 *  @return   Whether the object is idle
+		 */
+		bool _getIsIdleAfterUpdate() const
+		{
+			if( mIdleAfterUpdate == IS_UNKNOWN )
+				return getIsIdle();
+
+			return mIdleAfterUpdate == IS_IDLE;
+		}
+
+		/**
+		 *  Calls the same function on every parent this object was added to
+		 *
+		 *  @param callback   The parent's function to call with this object's slot
+		 */
+		void _notifyParents( ParentCallback callback )
+		{
+			if( mFirstParent )
+				(mFirstParent->*callback)(mFirstSlot);
+
+			if( mExtras ) {
+				if( mExtras->secondParent.parent )
+					(mExtras->secondParent.parent->*callback)(mExtras->secondParent.slot);
+
+				for( unsigned i = 0; i < mExtras->moreParents.size(); i++ ) {
+					const ParentLink & link = mExtras->moreParents[i];
+					(link.parent->*callback)(link.slot);
+				}
+			}
+		}
+
+		/**
+		 *  Calls the same function about one of this object's items on every parent
+		 *
+		 *  @param callback   The parent's function to call with this object's slot
+		 *  @param item       The item
+		 */
+		void _notifyParents( ItemCallback callback, OverRated::UpdatedObject * item )
+		{
+			if( mFirstParent )
+				(mFirstParent->*callback)(mFirstSlot, item);
+
+			if( mExtras ) {
+				if( mExtras->secondParent.parent )
+					(mExtras->secondParent.parent->*callback)(mExtras->secondParent.slot, item);
+
+				for( unsigned i = 0; i < mExtras->moreParents.size(); i++ ) {
+					const ParentLink & link = mExtras->moreParents[i];
+					(link.parent->*callback)(link.slot, item);
+				}
+			}
+		}
+
+		/**
+		 *  @return   The out of line state, created if there isn't any yet
+		 */
+		Extras & _getExtras()
+		{
+			if( !mExtras )
+				mExtras = new Extras();
+
+			return *mExtras;
+		}
+
+		/**
+		 *  Frees the out of line state if it is back to the defaults
+		 */
+		void _trimExtras()
+		{
+			if( mExtras && mExtras->fixedStep == 0.0 && mExtras->timeScale == 1.0 &&
+				!mExtras->secondParent.parent && mExtras->moreParents.empty() ) {
+				delete mExtras;
+				mExtras = 0;
+			}
+		}
+
+		/**
+		 *  Copies the fixed step and time scale states of another object, but not its parents
+		 *
+		 *  @param other   The object to copy from
+		 */
+		void _copyTiming( const UpdatedObject & other )
+		{
+			if( !other.mExtras && !mExtras )
+				return;
+
+			Extras & extras = _getExtras();
+
+			if( other.mExtras ) {
+				extras.fixedStep = other.mExtras->fixedStep;
+				extras.maxSteps = other.mExtras->maxSteps;
+				extras.pendingTime = other.mExtras->pendingTime;
+				extras.timeScale = other.mExtras->timeScale;
+			}
+			else {
+				extras.fixedStep = 0.0;
+				extras.maxSteps = 0;
+				extras.pendingTime = 0.0;
+				extras.timeScale = 1.0;
+			}
+
+			_trimExtras();
+		}
+
+		/**
+		 *  Saves up time and applies whatever whole fixed steps it makes
+		 *
+		 *  @param timeElapsed   Amount of time that has passed in seconds (1.0 = 1 sec)
+		 */
+		void _addFixedSteps( double timeElapsed )
+		{
+			Extras & extras = *mExtras;
+			const double step = extras.fixedStep;
+			unsigned steps = 0;
+
+			extras.pendingTime += timeElapsed;
+
+			while( extras.pendingTime >= step ) {
+				if( extras.maxSteps && steps == extras.maxSteps ) {
+					extras.pendingTime = std::fmod(extras.pendingTime, step);
+					break;
+				}
+
+				extras.pendingTime -= step;
+				_addTime( step );
+				steps++;
+			}
+		}
+
+		/**
+		 *  Records that this object was added to a parent
+		 *
+		 *  @param parent   The parent
+		 *  @param slot     The slot the parent keeps this object under
+		 */
+		void _attachParent( OverRated::UpdatedObjectParent * parent, unsigned slot )
+		{
+			if( !mFirstParent ) {
+				mFirstParent = parent;
+				mFirstSlot = slot;
+				return;
+			}
+
+			Extras & extras = _getExtras();
+
+			if( !extras.secondParent.parent )
+				extras.secondParent = ParentLink(parent, slot);
+			else
+				extras.moreParents.push_back(ParentLink(parent, slot));
+		}
+
+		/**
+		 *  Forgets a parent this object was added to. The last parent takes its place.
+		 *
+		 *  @param parent   The parent
+		 */
+		void _detachParent( const OverRated::UpdatedObjectParent * parent )
+		{
+			unsigned slot;
+			ParentLink * link = _findLink(parent, slot);
+			ParentLink last;
+
+			if( !link && mFirstParent != parent )
+				return;
+
+			// Take the last parent off
+			if( mExtras && !mExtras->moreParents.empty() ) {
+				last = mExtras->moreParents.back();
+				mExtras->moreParents.pop_back();
+			}
+			else if( mExtras && mExtras->secondParent.parent ) {
+				last = mExtras->secondParent;
+				mExtras->secondParent = ParentLink();
+			}
+			else {
+				last = ParentLink(mFirstParent, mFirstSlot);
+				mFirstParent = 0;
+				mFirstSlot = 0;
+			}
+
+			// Unless that was the one to forget, put it where the one to forget was
+			if( last.parent != parent ) {
+				if( link )
+					*link = last;
+				else {
+					mFirstParent = last.parent;
+					mFirstSlot = last.slot;
+				}
+			}
+
+			_trimExtras();
+		}
+
+		/**
+		 *  Looks up the slot this object has under a parent
+		 *
+		 *  @param parent   The parent
+		 *  @param slot     Receives the slot, if there is one
+		 *  @return         Whether this object was added to the parent
+		 */
+		bool _findParent( const OverRated::UpdatedObjectParent * parent, unsigned & slot ) const
+		{
+			if( mFirstParent == parent && parent ) {
+				slot = mFirstSlot;
+				return true;
+			}
+
+			return _findLink(parent, slot) != 0;
+		}
+
+		/**
+		 *  Looks up a parent other than the first
+		 *
+		 *  @param parent   The parent
+		 *  @param slot     Receives the slot, if there is one
+		 *  @return         The link to the parent, or NULL if it isn't one past the first
+		 */
+		ParentLink * _findLink( const OverRated::UpdatedObjectParent * parent,
+				unsigned & slot ) const
+		{
+			if( !mExtras || !parent )
+				return 0;
+
+			ParentLink * link = 0;
+
+			if( mExtras->secondParent.parent == parent )
+				link = &mExtras->secondParent;
+
+			for( unsigned i = 0; !link && i < mExtras->moreParents.size(); i++ ) {
+				if( mExtras->moreParents[i].parent == parent )
+					link = &mExtras->moreParents[i];
+			}
+
+			if( link )
+				slot = link->slot;
+
+			return link;
+		}
+
 	private:
-		bool mIsPaused;	// Whether this object is paused
+		OverRated::UpdatedObjectParent * mFirstParent;	// The parent this was added to, if any
+		Extras * mExtras;								// Rarely used state, or NULL if unused
+		unsigned mFirstSlot;							// The slot under the first parent
+		bool mIsPaused;									// Whether this object is paused
+		unsigned char mIdleAfterUpdate;					// An IdleState
 	};
 }
 
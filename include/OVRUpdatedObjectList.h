@@ -29,30 +29,173 @@
 
 #include <vector>
 
+#ifdef OVERRATED_ENABLE_COUNTERS
+#include <chrono>
+#endif
+
+#include "OVRCommandQueue.h"
+#include "OVRCounters.h"
+#include "OVRHandle.h"
+#include "OVRTracer.h"
 #include "OVRUpdatedObject.h"
 
 namespace OverRated
 {
+	class ThreadPool;
+
+	/**
+	 *  @return   How many parallel list updates the calling thread is doing a share of, which
+	 *            is only ever more than 0 on the threads of a pool
+	 */
+	inline unsigned & _ParallelDepth()
+	{
+		static thread_local unsigned depth = 0;
+
+		return depth;
+	}
+
 	/**
 	 *  A container which allows you to update a list of UpdatedObject's in one shot. Caller must
 	 *  supply the full type of the UpdatedObject via a template argument, as with most standard
 	 *  lists. The argument should always be an UpdatedObject or a subclass of it.
 	 *
 	 *  Example: UpdatedObjectList< UpdatedValue<double> >
+	 *
+	 *  Items are kept packed for updating, and each one also gets a slot which doesn't move for
+	 *  as long as it stays in the list. Adding, removing and checking for an item all take the
+	 *  same time no matter how long the list is. Removing an item moves the last item into its
+	 *  place, so the order of items (and their index) may change; a Handle does not. An item
+	 *  which is destroyed while in the list is removed automatically, which makes any handle to
+	 *  it stale rather than dangling.
+	 *
+	 *  Only active items are visited when time is added. Items that are paused or idle
+	 *  ( @see UpdatedObject::getIsIdle() ) are moved out of the way after an update and come
+	 *  back when they are woken ( @see UpdatedObject::wake() ), so adding time to a list where
+	 *  nothing is moving costs the same however many items it holds. The list is idle itself
+	 *  when none of its items are active.
+	 *
+	 *  Large lists can optionally be updated on a ThreadPool ( @see setParallel() ), and their
+	 *  updates can be recorded for viewing in a trace viewer ( @see Tracer ). A tree of lists
+	 *  can be updated as one flat list of the objects at its leaves ( @see UpdateSchedule ).
+	 *
+	 *  Instead of polling items to see which have finished, a callback can be registered to be
+	 *  called when one does ( @see addCompletion() ).
+	 *
+	 *  Items which don't need updating as often as the list is, such as those far away, can be
+	 *  put in a list of their own which updates each of them only every few times
+	 *  ( @see setUpdateTier() ).
 	 */
 	template <typename T>
-	class UpdatedObjectList : public OverRated::UpdatedObject
+	class UpdatedObjectList : public OverRated::UpdatedObject, public OverRated::UpdatedObjectParent
 	{
 	public:
+		/**
+		 *  Called when an item finishes ( @see addCompletion() )
+		 *
+		 *  @param item       The item which finished
+		 *  @param userData   Whatever was passed in when the callback was added
+		 */
+		typedef void (*CompletionCallback)( T * item, void * userData );
+
+		// The highest update tier, at which items are updated every 256th time
+		static const unsigned MAX_UPDATE_TIER = 8;
+
+		UpdatedObjectList()
+		: mActiveCount(0), mFreeSlot(NO_SLOT), mPool(0), mRunParallel(0), mGrainSize(0),
+		  mParallelThreshold(0), mName("UpdatedObjectList"), mCommands(0), mUpdateTier(0),
+		  mIsCatchingUp(false), mTick(0), mElapsed(0.0), mFreeCompletion(NO_SLOT),
+		  mCompletionCount(0), mNextSequence(0)
+		{}
+
+		/**
+		 *  Copies the items of another list; the items themselves are shared, not copied. Any
+		 *  completion callbacks and command queue stay with the other list.
+		 */
+		UpdatedObjectList( const UpdatedObjectList & other )
+		: OverRated::UpdatedObject(other), mActiveCount(0), mFreeSlot(NO_SLOT), mPool(other.mPool),
+		  mRunParallel(other.mRunParallel), mGrainSize(other.mGrainSize),
+		  mParallelThreshold(other.mParallelThreshold),
+		  mName(other.mName), mCommands(0), mUpdateTier(other.mUpdateTier), mIsCatchingUp(false),
+		  mTick(0), mElapsed(0.0), mFreeCompletion(NO_SLOT), mCompletionCount(0),
+		  mNextSequence(0)
+		{
+			for( unsigned i = 0; i < other.getSize(); i++ )
+				add(other.getItem(i));
+		}
+
+		/**
+		 *  Replaces the items of this list with those of another. Completion callbacks on this
+		 *  list are dropped and those of the other list are not copied.
+		 */
+		UpdatedObjectList & operator=( const UpdatedObjectList & other )
+		{
+			if( this != &other ) {
+				OverRated::UpdatedObject::operator=(other);
+				mPool = other.mPool;
+				mRunParallel = other.mRunParallel;
+				mGrainSize = other.mGrainSize;
+				mParallelThreshold = other.mParallelThreshold;
+				setUpdateTier(other.mUpdateTier);
+				mName = other.mName;
+				clear();
+
+				for( unsigned i = 0; i < other.getSize(); i++ )
+					add(other.getItem(i));
+			}
+			return *this;
+		}
+
+		/**
+		 *  The items are not deleted, they are only told that they no longer belong to the list
+		 */
+		virtual ~UpdatedObjectList()
+		{
+			for( unsigned i = 0; i < mList.size(); i++ )
+				mList[i]->_detachParent(this);
+		}
+
 		/**
 		 *  Adds a new item to the list
 		 *
 		 *  @param newItem  The item to add
+		 *  @return         A handle to the item; if it was already in the list, its existing one
 		 */
-		void add( T * newItem )
+		OverRated::Handle add( T * newItem )
 		{
-			if( !contains(newItem) )
-				mList.push_back(newItem);
+			unsigned slot;
+
+			if( newItem->_findParent(this, slot) )
+				return OverRated::Handle(slot, mSlots[slot].generation);
+
+			if( mFreeSlot != NO_SLOT ) {
+				slot = mFreeSlot;
+				mFreeSlot = mSlots[slot].index;
+				mSlots[slot].generation++;
+			}
+			else {
+				slot = mSlots.size();
+				mSlots.push_back(Slot());
+			}
+
+			mSlots[slot].index = mList.size();
+			mList.push_back(newItem);
+			mSlotOf.push_back(slot);
+			mLastUpdated.push_back(mElapsed);
+			newItem->_attachParent(this, slot);
+
+			if( static_cast<OverRated::UpdatedObject*>(newItem)->_getHasCommands() )
+				_setItemHasCommands(slot, true);
+
+			if( !newItem->getIsPaused() && !newItem->getIsIdle() ) {
+				_activate(mList.size() - 1);
+
+				if( mActiveCount == 1 )
+					wake();
+			}
+
+			_restructured();
+
+			return OverRated::Handle(slot, mSlots[slot].generation);
 		}
 
 		/**
@@ -62,20 +205,47 @@ namespace OverRated
 		 */
 		void remove( T * item )
 		{
-			for( unsigned i = 0; i < mList.size(); i++ ) {
-				if( mList[i] == item ) {
-					mList.erase( mList.begin() + i);
-					return;
-				}
+			unsigned slot;
+
+			if( item && item->_findParent(this, slot) ) {
+				item->_detachParent(this);
+				_removeSlot(slot);
+			}
+		}
+
+		/**
+		 *  Removes an existing item from the list (if the handle isn't stale)
+		 *
+		 *  @param handle   Handle of the item to remove
+		 */
+		void remove( const OverRated::Handle & handle )
+		{
+			if( contains(handle) ) {
+				mList[mSlots[handle.slot].index]->_detachParent(this);
+				_removeSlot(handle.slot);
 			}
 		}
 
 		/**
-		 *  Clears the list without deleting anything
+		 *  Clears the list without deleting anything. Every handle to the list becomes stale,
+		 *  and any completion callbacks are dropped.
 		 */
 		void clear()
 		{
+			for( unsigned i = 0; i < mList.size(); i++ ) {
+				mList[i]->_detachParent(this);
+				_itemRemoved(mList[i]);
+				_removeCompletions(mSlotOf[i]);
+				_freeSlot(mSlotOf[i]);
+			}
+
 			mList.clear();
+			mSlotOf.clear();
+			mLastUpdated.clear();
+			mCommandItems.clear();
+			mActiveCount = 0;
+
+			_restructured();
 		}
 
 		/**
@@ -89,6 +259,31 @@ namespace OverRated
 			return mList[index];
 		}
 
+		/**
+		 *  Accessor by handle
+		 *
+		 *  @param handle   Handle of the desired item
+		 *  @return         The desired item, or NULL if the handle is stale
+		 */
+		T * getItem( const OverRated::Handle & handle ) const
+		{
+			if( contains(handle) )
+				return mList[mSlots[handle.slot].index];
+
+			return 0;
+		}
+
+		/**
+		 *  @param index   Index of an item
+		 *  @return        The handle of that item
+		 */
+		OverRated::Handle getHandle( unsigned index ) const
+		{
+			unsigned slot = mSlotOf[index];
+
+			return OverRated::Handle(slot, mSlots[slot].generation);
+		}
+
 		/**
 		 *  Returns the size of the list
 		 *
@@ -99,35 +294,1026 @@ namespace OverRated
 			return mList.size();
 		}
 
+		/**
+		 *  @return   Number of items which are currently being updated
+		 */
+		unsigned getActiveCount() const
+		{
+			return mActiveCount;
+		}
+
+		/**
+		 *  The list is idle when none of its items are active
+		 *
+		 *  @return   Whether adding time would do nothing
+		 */
+		bool getIsIdle() const
+		{
+			return mActiveCount == 0;
+		}
+
 		/**
 		 *  Returns whether or not the list currently contains an item
 		 *
 		 *  @param item   The item to query the list for
 		 *  @return       Whether the item currently exists in this container
 		 */
-		bool contains( const T * item )
+		bool contains( const T * item ) const
 		{
-			for( unsigned i = 0; i < mList.size(); i++ ) {
-				if( mList[i] == item )
-					return true;
+			unsigned slot;
+
+			return item && item->_findParent(this, slot);
+		}
+
+		/**
+		 *  Returns whether a handle still refers to an item in this list
+		 *
+		 *  @param handle   The handle to check
+		 *  @return         Whether the handle is current
+		 */
+		bool contains( const OverRated::Handle & handle ) const
+		{
+			return handle.slot < mSlots.size() &&
+					mSlots[handle.slot].generation == handle.generation &&
+					(mSlots[handle.slot].generation & 1) == 0;
+		}
+
+		/**
+		 *  Has the list update its items across the threads of a pool whenever it holds at
+		 *  least 'threshold' active items. Fewer are cheaper to update on the calling thread.
+		 *  Pass NULL to go back to updating serially.
+		 *
+		 *  While a parallel update runs, any two items may be updated at the same time, so:
+		 *  - an item must not be in this list more than once through nested lists, nor in
+		 *    another list that is updated at the same time;
+		 *  - items may share an UpdateMethod, because updating a value only reads its method.
+		 *    Nothing may change a shared method during the update (setRate() and the like are
+		 *    only safe between updates), and custom methods must not change their own state
+		 *    while updating a value if they are shared;
+		 *  - UpdatedValueRef's must not refer to the same variable;
+		 *  - items must not be added, removed, destroyed or woken from within the update.
+		 *    Lists beneath this one with command queues have their commands carried out on
+		 *    the calling thread before the update starts, and not by the threads of the pool.
+		 *
+		 *  The list only needs ThreadPool declared, so OVRThreadPool.h (and with it the thread
+		 *  library) is only needed where setParallel() is called.
+		 *
+		 *  @param pool        The pool to use, or NULL
+		 *  @param grainSize   Number of consecutive items each thread takes at a time
+		 *  @param threshold   The smallest number of active items which is updated in parallel
+		 */
+		void setParallel( OverRated::ThreadPool * pool, unsigned grainSize = 1024,
+				unsigned threshold = 4096 )
+		{
+			mPool = pool;
+			mRunParallel = &UpdatedObjectList::_runParallel<OverRated::ThreadPool>;
+			mGrainSize = grainSize;
+			mParallelThreshold = threshold;
+
+			_restructured();
+		}
+
+		/**
+		 *  @return   The pool used for parallel updates (warning: can be NULL!)
+		 */
+		OverRated::ThreadPool * getParallelPool() const
+		{
+			return mPool;
+		}
+
+		/**
+		 *  Has the list update each active item only once every 2^tier times time is added to
+		 *  it, rather than every time, which cuts the cost of an update by about that much. Each
+		 *  item is given all the time added since it was last updated, in one go, so items end
+		 *  up in the same place, just in fewer and longer steps. The items are taken in turns,
+		 *  a share on each update, so the cost is spread evenly rather than coming all at once.
+		 *
+		 *  This suits items which don't need to look smooth, such as those far away or out of
+		 *  sight; put them in a list of their own within the main one. Completion callbacks
+		 *  can be up to 2^tier updates late, since an item is only seen to finish when it is
+		 *  updated. An item woken between its updates is given time from when it was woken.
+		 *  Moving to a lower tier first gives every item the time it is owed.
+		 *
+		 *  @param tier   0 to update every item every time, 1 for every other time, 2 for every
+		 *                4th time, and so on up to MAX_UPDATE_TIER
+		 */
+		void setUpdateTier( unsigned tier )
+		{
+			if( tier > MAX_UPDATE_TIER )
+				tier = MAX_UPDATE_TIER;
+
+			// Items updated every time so far owe no time
+			if( !mUpdateTier && !mIsCatchingUp ) {
+				for( unsigned i = 0; i < mActiveCount; i++ )
+					mLastUpdated[i] = mElapsed;
 			}
-			return false;
+
+			mIsCatchingUp = mIsCatchingUp || tier < mUpdateTier;
+			mUpdateTier = tier;
+
+			_restructured();
+		}
+
+		/**
+		 *  @return   The update tier ( @see setUpdateTier() )
+		 */
+		unsigned getUpdateTier() const
+		{
+			return mUpdateTier;
+		}
+
+		/**
+		 *  Has the list carry out the commands other threads have queued, at the start of each
+		 *  update ( @see CommandQueue ). A queue must only be attached to one list, and that
+		 *  list should be one that time is added to directly, since a list which is idle or
+		 *  paused isn't updated and so doesn't apply commands. Beneath a list updated in
+		 *  parallel ( @see setParallel() ), the commands are carried out at the start of that
+		 *  list's update instead. Pass NULL to detach it.
+		 *
+		 *  @param queue   The queue, or NULL
+		 */
+		void setCommandQueue( OverRated::CommandQueue<T> * queue )
+		{
+			mCommands = queue;
+
+			_restructured();
+		}
+
+		/**
+		 *  @return   The attached command queue (warning: can be NULL!)
+		 */
+		OverRated::CommandQueue<T> * getCommandQueue() const
+		{
+			return mCommands;
+		}
+
+		/**
+		 *  Has a function called once when an item finishes
+		 *  ( @see UpdatedObject::getIsFinished() ). Rather than checking every item on
+		 *  every update, the list asks the item how long it expects to take
+		 *  ( @see UpdatedObject::getTimeToFinish() ) and only looks at it again around then. Items
+		 *  which are woken, such as by being given a new method or value or by being unpaused, or
+		 *  which stop being active are asked again. Paused items are not checked until they are
+		 *  unpaused.
+		 *
+		 *  Callbacks are made from within addTime(), once the items have been updated, on the
+		 *  calling thread. Those due in the same update are made in the order the items were
+		 *  expected to finish, and in the order they were added when that is the same, so the
+		 *  order never depends on how the list is laid out. An item that has already finished
+		 *  is reported on the next update. Once called, a callback is removed; a callback may
+		 *  add another, or change or remove items.
+		 *
+		 *  Nothing is allocated while updating; adding callbacks allocates only if there are more
+		 *  than ever before ( @see reserveCompletions() ).
+		 *
+		 *  @param item       Handle of the item to watch
+		 *  @param callback   The function to call
+		 *  @param userData   Passed to the function as it is
+		 *  @return           A handle to the callback, or a null handle if the item's is stale
+		 */
+		OverRated::Handle addCompletion( const OverRated::Handle & item,
+				CompletionCallback callback, void * userData = 0 )
+		{
+			unsigned index;
+
+			if( !contains(item) )
+				return OverRated::Handle();
+
+			if( mFreeCompletion != NO_SLOT ) {
+				index = mFreeCompletion;
+				mFreeCompletion = mCompletions[index].nextOfSlot;
+				mCompletions[index].generation++;
+			}
+			else {
+				index = mCompletions.size();
+				mCompletions.push_back(Completion());
+			}
+
+			Completion & completion = mCompletions[index];
+			Slot & slot = mSlots[item.slot];
+
+			completion.slot = item.slot;
+			completion.nextOfSlot = slot.firstCompletion;
+			completion.callback = callback;
+			completion.userData = userData;
+			completion.sequence = mNextSequence++;
+			completion.heapIndex = NO_SLOT;
+			slot.firstCompletion = index;
+			mCompletionCount++;
+
+			if( mCompletionCount == 1 )
+				_restructured();
+
+			_scheduleCompletion(index);
+
+			return OverRated::Handle(index, completion.generation);
+		}
+
+		/**
+		 *  @see addCompletion( const Handle &, CompletionCallback, void * )
+		 *
+		 *  @param item       The item to watch
+		 *  @param callback   The function to call
+		 *  @param userData   Passed to the function as it is
+		 *  @return           A handle to the callback, or a null handle if the item isn't here
+		 */
+		OverRated::Handle addCompletion( T * item, CompletionCallback callback,
+				void * userData = 0 )
+		{
+			unsigned slot;
+
+			if( !item->_findParent(this, slot) )
+				return OverRated::Handle();
+
+			return addCompletion(OverRated::Handle(slot, mSlots[slot].generation), callback,
+					userData);
+		}
+
+		/**
+		 *  Drops a completion callback before it is called (if the handle isn't stale)
+		 *
+		 *  @param completion   Handle returned by addCompletion()
+		 */
+		void removeCompletion( const OverRated::Handle & completion )
+		{
+			if( completion.slot >= mCompletions.size() ||
+					mCompletions[completion.slot].generation != completion.generation ||
+					(completion.generation & 1) != 0 )
+				return;
+
+			unsigned * link = &mSlots[mCompletions[completion.slot].slot].firstCompletion;
+
+			while( *link != completion.slot )
+				link = &mCompletions[*link].nextOfSlot;
+
+			*link = mCompletions[completion.slot].nextOfSlot;
+			_freeCompletion(completion.slot);
+		}
+
+		/**
+		 *  @return   Number of completion callbacks waiting to be called
+		 */
+		unsigned getCompletionCount() const
+		{
+			return mCompletionCount;
+		}
+
+		/**
+		 *  Makes room for a number of completion callbacks so that adding that many won't
+		 *  allocate
+		 *
+		 *  @param count   How many callbacks to make room for
+		 */
+		void reserveCompletions( unsigned count )
+		{
+			mCompletions.reserve(count);
+			mCompletionHeap.reserve(count);
+			mCompletionsDue.reserve(count);
+			mCompletionsWoken.reserve(count);
+		}
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+		/**
+		 *  Counts of what updates of this list have done ( @see ListCounter ). Only available
+		 *  when built with OVERRATED_ENABLE_COUNTERS.
+		 *
+		 *  @return   The counters, which may be read from any thread
+		 */
+		const OverRated::ListCounters & getCounters() const
+		{
+			return mCounters;
+		}
+#endif
+
+		/**
+		 *  Names the list in traces ( @see Tracer ). Only the pointer is kept, so the string must
+		 *  last as long as the list and any trace it appears in, such as a string literal.
+		 *
+		 *  @param name   The name
+		 */
+		void setName( const char * name )
+		{
+			mName = name;
+		}
+
+		/**
+		 *  @return   The name of the list in traces
+		 */
+		const char * getName() const
+		{
+			return mName;
+		}
+
+		/**
+		 *  @return   Total time added to this list while it wasn't paused, in seconds
+		 */
+		double getElapsedTime() const
+		{
+			return mElapsed;
 		}
 
 	private:
 		/**
-		 *  When time is added, update every item in the list.
+		 *  When time is added, apply any queued commands then update every item in the list,
+		 *  recording a span if tracing.
 		 *
 		 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
 		 */
 		void _addTime( const double & timeElapsed )
 		{
-			for( unsigned i = 0; i < mList.size(); i++ )
-				mList[i]->addTime(timeElapsed);
+			OverRated::Tracer * tracer = OverRated::TraceGetTracer();
+
+			// Within a parallel update, the list updated in parallel has already applied them
+			if( mCommands && !OverRated::_ParallelDepth() )
+				mCommands->apply(*this);
+
+			if( tracer ) {
+				unsigned long long begin = tracer->now();
+				unsigned active = mActiveCount;
+
+				_update(timeElapsed);
+				tracer->record(mName, begin, mList.size(), active);
+			}
+			else
+				_update(timeElapsed);
+		}
+
+		// What the threads of a parallel update share: item i is updated for each j from 0 to
+		// the count, where i = first + j * step, and idle[j] is set if it then needs no more
+		struct ParallelUpdate
+		{
+			T * const * items;
+			double * updated;				// mLastUpdated, used when taking turns
+			unsigned char * idle;
+			bool inTurns;
+			unsigned step;
+			unsigned first;
+			double now;
+			double timeElapsed;
+		};
+
+		typedef void (*RunParallel)( OverRated::ThreadPool * pool, unsigned count,
+				unsigned grainSize, const ParallelUpdate & update );
+
+		/**
+		 *  Runs a parallel update across the threads of a pool. This is a template only so that
+		 *  ThreadPool need not be complete until setParallel() is called.
+		 *
+		 *  @param pool        The pool to use
+		 *  @param count       Number of items to update
+		 *  @param grainSize   Number of consecutive items each thread takes at a time
+		 *  @param update      The items and how to update them
+		 */
+		template <typename Pool>
+		static void _runParallel( Pool * pool, unsigned count, unsigned grainSize,
+				const ParallelUpdate & update )
+		{
+			pool->parallelFor(count, grainSize, [&update]( unsigned begin, unsigned end ) {
+				OverRated::_ParallelDepth()++;
+
+				for( unsigned j = begin; j < end; j++ ) {
+					unsigned i = update.first + j * update.step;
+					T * item = update.items[i];
+
+					if( update.inTurns ) {
+						item->addTime(update.now - update.updated[i]);
+						update.updated[i] = update.now;
+					}
+					else
+						item->addTime(update.timeElapsed);
+
+					update.idle[j] = item->getIsPaused() || item->_getIsIdleAfterUpdate();
+				}
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+				OverRated::FlushCounters();
+#endif
+				OverRated::_ParallelDepth()--;
+			});
+		}
+
+		/**
+		 *  Updates the active items whose turn it is (every one, unless there is an update tier),
+		 *  then checks on completions
+		 *
+		 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+		 */
+		void _update( const double & timeElapsed )
+		{
+#ifdef OVERRATED_ENABLE_COUNTERS
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			unsigned before = mActiveCount;
+			unsigned visited = 0;
+			unsigned paused = 0;
+#endif
+
+			// Lists beneath with commands apply them now, while nothing else is running, as they
+			// could change this list
+			if( mPool && !mCommandItems.empty() && !OverRated::_ParallelDepth() )
+				_applyItemCommands();
+
+			// With a tier, items are given the time since they were last updated, and take
+			// turns by position; catching up, every item is given what it is owed
+			const bool inTurns = mUpdateTier || mIsCatchingUp;
+			const unsigned step = mIsCatchingUp ? 1 : 1u << mUpdateTier;
+			const unsigned first = mTick++ & (step - 1);
+			const double now = mElapsed + timeElapsed;
+			const unsigned count = (mActiveCount > first) ?
+					(mActiveCount - first + step - 1) / step : 0;
+
+			mIsCatchingUp = false;
+
+			if( mPool && count > 0 && count >= mParallelThreshold ) {
+				ParallelUpdate update;
+
+				mIdleFlags.resize(count);
+
+				update.items = mList.data();
+				update.updated = mLastUpdated.data();
+				update.idle = mIdleFlags.data();
+				update.inTurns = inTurns;
+				update.step = step;
+				update.first = first;
+				update.now = now;
+				update.timeElapsed = timeElapsed;
+
+				mRunParallel(mPool, count, mGrainSize, update);
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+				visited = count;
+#endif
+
+				// Going backwards, everything past i is already settled, so the last active item
+				// is never one that still needs checking
+				for( unsigned j = count; j-- > 0; ) {
+					if( update.idle[j] ) {
+#ifdef OVERRATED_ENABLE_COUNTERS
+						paused += mList[first + j * step]->getIsPaused() ? 1 : 0;
+#endif
+						_deactivate(first + j * step);
+					}
+				}
+			}
+			else {
+				unsigned i = first;
+
+				while( i < mActiveCount ) {
+					T * item = mList[i];
+
+					if( inTurns ) {
+						item->addTime(now - mLastUpdated[i]);
+						mLastUpdated[i] = now;
+					}
+					else
+						item->addTime(timeElapsed);
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+					visited++;
+#endif
+
+					// Deactivating swaps in the last active item, which still needs its update
+					if( item->getIsPaused() || item->_getIsIdleAfterUpdate() ) {
+#ifdef OVERRATED_ENABLE_COUNTERS
+						paused += item->getIsPaused() ? 1 : 0;
+#endif
+						_deactivate(i);
+					}
+					else
+						i += step;
+				}
+			}
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+			mCounters.add(OverRated::LC_TICKS, 1);
+			mCounters.add(OverRated::LC_VISITED, visited);
+			mCounters.add(OverRated::LC_ACTIVE, visited - (before - mActiveCount));
+			mCounters.add(OverRated::LC_FINISHED, before - mActiveCount - paused);
+			mCounters.add(OverRated::LC_PAUSED, paused);
+#endif
+
+			mElapsed += timeElapsed;
+
+			if( mCompletionCount )
+				_updateCompletions(timeElapsed);
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+			mCounters.add(OverRated::LC_TICK_NANOSECONDS,
+					std::chrono::duration_cast<std::chrono::nanoseconds>(
+						std::chrono::steady_clock::now() - start).count());
+			OverRated::FlushCounters();
+#endif
+		}
+
+		/**
+		 *  A list does nothing itself but update its items, so an UpdateSchedule can update them
+		 *  directly, unless the list has work of its own: commands to apply, completions to
+		 *  check, a thread pool to use, fixed steps to take or an update tier to keep.
+		 *
+		 *  @param children   Receives the items
+		 *  @return           Whether the items can be updated directly
+		 */
+		bool _getScheduleChildren( std::vector<OverRated::UpdatedObject*> & children )
+		{
+			if( mCommands || mCompletionCount || mPool || mUpdateTier || getFixedStep() > 0.0 )
+				return false;
+
+			children.insert(children.end(), mList.begin(), mList.end());
+			return true;
+		}
+
+		/**
+		 *  An item destroyed while in the list simply drops out of it
+		 *
+		 *  @param slot   The slot of the destroyed item
+		 */
+		void _onChildDestroyed( unsigned slot )
+		{
+			_removeSlot(slot);
+		}
+
+		/**
+		 *  A woken item goes back among the active ones. If the list had nothing active, it
+		 *  wakes its own parents in turn.
+		 *
+		 *  @param slot   The slot of the woken item
+		 */
+		void _onChildWoken( unsigned slot )
+		{
+			unsigned index = mSlots[slot].index;
+
+			_wakeCompletions(slot);
+			_itemWoken(mList[index]);
+
+			if( index < mActiveCount )
+				return;
+
+			_activate(index);
+
+			if( mActiveCount == 1 )
+				wake();
+		}
+
+		/**
+		 *  An UpdateSchedule over the list may be updating the item directly
+		 *
+		 *  @param slot   The slot of the changed item
+		 */
+		void _onChildRestructured( unsigned slot )
+		{
+			OverRated::UpdatedObject * item = mList[mSlots[slot].index];
+
+			_setItemHasCommands(slot, item->_getHasCommands());
+			_itemRestructured(item);
+		}
+
+		/**
+		 *  @return   Whether the list or anything in it has a command queue
+		 */
+		bool _getHasCommands() const
+		{
+			return mCommands || !mCommandItems.empty();
+		}
+
+		/**
+		 *  Applies the list's own commands, then those of everything in it
+		 */
+		void _applyCommands()
+		{
+			if( mCommands )
+				mCommands->apply(*this);
+
+			_applyItemCommands();
+		}
+
+		/**
+		 *  Applies the commands of everything in the list which has any. Commands may take
+		 *  items out as they go.
+		 */
+		void _applyItemCommands()
+		{
+			for( unsigned i = 0; i < mCommandItems.size(); i++ ) {
+				OverRated::UpdatedObject * item = mList[mSlots[mCommandItems[i]].index];
+
+				item->_applyCommands();
+			}
+		}
+
+		/**
+		 *  Keeps track of which items have commands to apply ( @see _getHasCommands() ),
+		 *  telling the list's own parents if that changes whether the list has any
+		 *
+		 *  @param slot          The slot of the item
+		 *  @param hasCommands   Whether it has any
+		 */
+		void _setItemHasCommands( unsigned slot, bool hasCommands )
+		{
+			bool had = _getHasCommands();
+			unsigned i = 0;
+
+			while( i < mCommandItems.size() && mCommandItems[i] != slot )
+				i++;
+
+			if( hasCommands && i == mCommandItems.size() )
+				mCommandItems.push_back(slot);
+			else if( !hasCommands && i < mCommandItems.size() ) {
+				mCommandItems[i] = mCommandItems.back();
+				mCommandItems.pop_back();
+			}
+			else
+				return;
+
+			if( had != _getHasCommands() )
+				_restructured();
+		}
+
+		/**
+		 *  Moves an inactive item to the end of the active ones
+		 *
+		 *  @param index   Index of the item
+		 */
+		void _activate( unsigned index )
+		{
+			_swap(index, mActiveCount);
+			mLastUpdated[mActiveCount] = mElapsed;
+			mActiveCount++;
+		}
+
+		/**
+		 *  Moves an active item to the start of the inactive ones
+		 *
+		 *  @param index   Index of the item
+		 */
+		void _deactivate( unsigned index )
+		{
+			// It may have just finished, and it won't be looked at again until it is woken
+			_wakeCompletions(mSlotOf[index]);
+
+			mActiveCount--;
+			_swap(index, mActiveCount);
+		}
+
+		/**
+		 *  Exchanges the positions of two items in the packed list
+		 *
+		 *  @param first    Index of one item
+		 *  @param second   Index of the other
+		 */
+		void _swap( unsigned first, unsigned second )
+		{
+			T * item = mList[first];
+			unsigned slot = mSlotOf[first];
+			double updated = mLastUpdated[first];
+
+			mList[first] = mList[second];
+			mSlotOf[first] = mSlotOf[second];
+			mLastUpdated[first] = mLastUpdated[second];
+			mList[second] = item;
+			mSlotOf[second] = slot;
+			mLastUpdated[second] = updated;
+
+			mSlots[mSlotOf[first]].index = first;
+			mSlots[mSlotOf[second]].index = second;
+		}
+
+		/**
+		 *  Takes the item in a slot out of the packed list by moving another item into its place,
+		 *  then frees the slot.
+		 *
+		 *  @param slot   The slot of the item to remove
+		 */
+		void _removeSlot( unsigned slot )
+		{
+			unsigned index = mSlots[slot].index;
+
+			_itemRemoved(mList[index]);
+
+			if( !mCommandItems.empty() )
+				_setItemHasCommands(slot, false);
+
+			// Keep the active items together at the front
+			if( index < mActiveCount ) {
+				_deactivate(index);
+				index = mActiveCount;
+			}
+
+			_swap(index, mList.size() - 1);
+
+			mList.pop_back();
+			mSlotOf.pop_back();
+			mLastUpdated.pop_back();
+
+			_removeCompletions(slot);
+			_freeSlot(slot);
+			_restructured();
+		}
+
+		/**
+		 *  Puts a slot on the free list. Its generation moves on so old handles become stale.
+		 *
+		 *  @param slot   The slot to free
+		 */
+		void _freeSlot( unsigned slot )
+		{
+			mSlots[slot].generation++;
+			mSlots[slot].index = mFreeSlot;
+			mFreeSlot = slot;
+		}
+
+		/**
+		 *  Predicts the completions of woken items again, then checks every completion which is
+		 *  due. Anything expected within half of an update from now counts as due, so that an
+		 *  item which finishes a little sooner than predicted isn't reported an update late. A
+		 *  completion whose item turns out not to have finished is predicted again, and isn't
+		 *  checked again until the next update.
+		 *
+		 *  @param timeElapsed   The time added in this update
+		 */
+		void _updateCompletions( const double & timeElapsed )
+		{
+			for( unsigned i = 0; i < mCompletionsWoken.size(); i++ ) {
+				Slot & slot = mSlots[mCompletionsWoken[i]];
+
+				// The slot may have been freed since, which also clears this flag
+				if( slot.isWoken ) {
+					slot.isWoken = false;
+
+					for( unsigned c = slot.firstCompletion; c != NO_SLOT;
+							c = mCompletions[c].nextOfSlot )
+						_scheduleCompletion(c);
+				}
+			}
+			mCompletionsWoken.clear();
+
+			double due = mElapsed + timeElapsed * 0.5;
+
+			while( !mCompletionHeap.empty() && !(mCompletions[mCompletionHeap[0]].due > due) ) {
+				unsigned index = mCompletionHeap[0];
+
+				_heapRemove(0);
+				mCompletionsDue.push_back(OverRated::Handle(index, mCompletions[index].generation));
+			}
+
+			for( unsigned i = 0; i < mCompletionsDue.size(); i++ ) {
+				unsigned index = mCompletionsDue[i].slot;
+
+				// A callback already made may have removed this one, or its item
+				if( mCompletions[index].generation != mCompletionsDue[i].generation ||
+						mCompletions[index].heapIndex != NO_SLOT )
+					continue;
+
+				Completion & completion = mCompletions[index];
+				T * item = mList[mSlots[completion.slot].index];
+
+				if( item->getIsFinished() ) {
+					CompletionCallback callback = completion.callback;
+					void * userData = completion.userData;
+
+					removeCompletion(mCompletionsDue[i]);
+					callback(item, userData);
+				}
+				else
+					_scheduleCompletion(index);
+			}
+			mCompletionsDue.clear();
+		}
+
+		/**
+		 *  Puts a completion in the queue for when its item expects to finish, or takes it out
+		 *  of the queue if the item doesn't expect to finish as things are.
+		 *
+		 *  @param index   Index of the completion
+		 */
+		void _scheduleCompletion( unsigned index )
+		{
+			Completion & completion = mCompletions[index];
+			T * item = mList[mSlots[completion.slot].index];
+			double time = item->getIsPaused() ? -1.0 : item->getTimeToFinish();
+
+			// The item's time runs at its own scale; one standing still won't finish
+			if( time > 0.0 )
+				time = (item->getTimeScale() > 0.0) ? time / item->getTimeScale() : -1.0;
+
+			if( time < 0.0 ) {
+				if( completion.heapIndex != NO_SLOT )
+					_heapRemove(completion.heapIndex);
+				return;
+			}
+
+			completion.due = mElapsed + time;
+
+			if( completion.heapIndex == NO_SLOT ) {
+				completion.heapIndex = mCompletionHeap.size();
+				mCompletionHeap.push_back(index);
+			}
+
+			_heapUp(_heapDown(completion.heapIndex));
+		}
+
+		/**
+		 *  Has the completions of a slot predicted again on the next update (or at the end of
+		 *  this one, if it is in progress)
+		 *
+		 *  @param slot   The slot
+		 */
+		void _wakeCompletions( unsigned slot )
+		{
+			if( mSlots[slot].firstCompletion != NO_SLOT && !mSlots[slot].isWoken ) {
+				mSlots[slot].isWoken = true;
+				mCompletionsWoken.push_back(slot);
+			}
+		}
+
+		/**
+		 *  Drops every completion of a slot
+		 *
+		 *  @param slot   The slot
+		 */
+		void _removeCompletions( unsigned slot )
+		{
+			unsigned index = mSlots[slot].firstCompletion;
+
+			while( index != NO_SLOT ) {
+				unsigned next = mCompletions[index].nextOfSlot;
+
+				_freeCompletion(index);
+				index = next;
+			}
+
+			mSlots[slot].firstCompletion = NO_SLOT;
+			mSlots[slot].isWoken = false;
+		}
+
+		/**
+		 *  Takes a completion out of the queue and puts it on the free list. It must already be
+		 *  unlinked from its slot.
+		 *
+		 *  @param index   Index of the completion
+		 */
+		void _freeCompletion( unsigned index )
+		{
+			if( mCompletions[index].heapIndex != NO_SLOT )
+				_heapRemove(mCompletions[index].heapIndex);
+
+			mCompletions[index].generation++;
+			mCompletions[index].nextOfSlot = mFreeCompletion;
+			mFreeCompletion = index;
+			mCompletionCount--;
+
+			if( mCompletionCount == 0 )
+				_restructured();
+		}
+
+		/**
+		 *  @return   Whether the completion at one position of the heap is due before another
+		 */
+		bool _heapLess( unsigned first, unsigned second ) const
+		{
+			const Completion & a = mCompletions[mCompletionHeap[first]];
+			const Completion & b = mCompletions[mCompletionHeap[second]];
+
+			return a.due < b.due || (!(b.due < a.due) && a.sequence < b.sequence);
+		}
+
+		/**
+		 *  Exchanges two entries of the heap
+		 */
+		void _heapSwap( unsigned first, unsigned second )
+		{
+			unsigned index = mCompletionHeap[first];
+
+			mCompletionHeap[first] = mCompletionHeap[second];
+			mCompletionHeap[second] = index;
+			mCompletions[mCompletionHeap[first]].heapIndex = first;
+			mCompletions[mCompletionHeap[second]].heapIndex = second;
+		}
+
+		/**
+		 *  Moves an entry of the heap towards the top until it is in order
+		 *
+		 *  @param pos   Position of the entry
+		 *  @return      Where it ended up
+		 */
+		unsigned _heapUp( unsigned pos )
+		{
+			while( pos > 0 && _heapLess(pos, (pos - 1) / 2) ) {
+				_heapSwap(pos, (pos - 1) / 2);
+				pos = (pos - 1) / 2;
+			}
+			return pos;
+		}
+
+		/**
+		 *  Moves an entry of the heap towards the bottom until it is in order
+		 *
+		 *  @param pos   Position of the entry
+		 *  @return      Where it ended up
+		 */
+		unsigned _heapDown( unsigned pos )
+		{
+			unsigned size = mCompletionHeap.size();
+
+			for( ;; ) {
+				unsigned least = pos;
+				unsigned left = pos * 2 + 1;
+
+				if( left < size && _heapLess(left, least) )
+					least = left;
+				if( left + 1 < size && _heapLess(left + 1, least) )
+					least = left + 1;
+				if( least == pos )
+					return pos;
+
+				_heapSwap(pos, least);
+				pos = least;
+			}
+		}
+
+		/**
+		 *  Takes an entry out of the heap
+		 *
+		 *  @param pos   Position of the entry
+		 */
+		void _heapRemove( unsigned pos )
+		{
+			unsigned last = mCompletionHeap.size() - 1;
+
+			mCompletions[mCompletionHeap[pos]].heapIndex = NO_SLOT;
+
+			if( pos != last ) {
+				mCompletionHeap[pos] = mCompletionHeap[last];
+				mCompletions[mCompletionHeap[pos]].heapIndex = pos;
+				mCompletionHeap.pop_back();
+				_heapUp(_heapDown(pos));
+			}
+			else
+				mCompletionHeap.pop_back();
 		}
 
 	private:
-		std::vector<T*> mList;	// The updated items
+		static const unsigned NO_SLOT = ~0u;
+
+		// Where the item using a slot is in the packed list. Generations are even while a slot
+		// is in use and odd while it is free. A free slot's index is the next free slot.
+		struct Slot
+		{
+			Slot() : index(0), generation(0), firstCompletion(NO_SLOT), isWoken(false) {}
+
+			unsigned index;
+			unsigned generation;
+			unsigned firstCompletion;	// First completion of the item, or NO_SLOT
+			bool isWoken;				// Whether it is waiting in mCompletionsWoken
+		};
+
+		// A callback waiting for an item to finish. Generations work as they do for slots; a
+		// free completion's nextOfSlot is the next free completion.
+		struct Completion
+		{
+			Completion()
+			: slot(0), nextOfSlot(NO_SLOT), generation(0), callback(0), userData(0), due(0.0),
+			  sequence(0), heapIndex(NO_SLOT)
+			{}
+
+			unsigned slot;					// Slot of the item
+			unsigned nextOfSlot;			// Next completion of the same item, or NO_SLOT
+			unsigned generation;
+			CompletionCallback callback;
+			void * userData;
+			double due;						// Elapsed time it should be checked at
+			unsigned long long sequence;	// Order it was added in, to break ties
+			unsigned heapIndex;				// Where it is in mCompletionHeap, or NO_SLOT
+		};
+
+		std::vector<T*> mList;				// The updated items, active ones first
+		unsigned mActiveCount;				// Number of active items at the front of mList
+		std::vector<unsigned> mSlotOf;		// The slot of each item in mList
+		std::vector<Slot> mSlots;			// Every slot ever used
+		unsigned mFreeSlot;					// First free slot, or NO_SLOT
+
+		OverRated::ThreadPool * mPool;		// Pool for parallel updates, if any
+		RunParallel mRunParallel;			// Runs a parallel update on mPool
+		unsigned mGrainSize;				// Items per range in a parallel update
+		unsigned mParallelThreshold;		// Smallest size that is updated in parallel
+		std::vector<unsigned char> mIdleFlags;	// Which items went idle in a parallel update
+		const char * mName;					// Name of the list in traces
+		OverRated::CommandQueue<T> * mCommands;	// Commands from other threads, if any
+		std::vector<unsigned> mCommandItems;	// Slots of the items with commands to apply
+		unsigned mUpdateTier;				// Items are updated every 2^mUpdateTier updates
+		bool mIsCatchingUp;					// Whether items are owed time from a higher tier
+		unsigned mTick;						// Number of updates, to take items in turns
+		std::vector<double> mLastUpdated;	// mElapsed when each item was last given time
+
+		double mElapsed;							// Time added so far, for completions
+		std::vector<Completion> mCompletions;		// Every completion ever used
+		unsigned mFreeCompletion;					// First free completion, or NO_SLOT
+		unsigned mCompletionCount;					// Completions in use
+		unsigned long long mNextSequence;			// Sequence of the next completion added
+		std::vector<unsigned> mCompletionHeap;		// Queued completions, soonest due first
+		std::vector<OverRated::Handle> mCompletionsDue;	// Completions being checked
+		std::vector<unsigned> mCompletionsWoken;	// Slots whose completions need predicting
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+		OverRated::ListCounters mCounters;			// What updates of this list have done
+#endif
 	};
 }
 
@@ -40,9 +40,43 @@ namespace OverRated
 	class UpdatedValue : public OverRated::UpdatedObject
 	{
 	public:
-		UpdatedValue() : mUpdateMethod(0) {}
+		typedef T ValueType;	// The type of the value being updated
 
-		virtual ~UpdatedValue() {}
+		UpdatedValue()
+		: mIsApplyingUpdate(false), mIsIdleTracked(false), mUpdateMethod(0), mMethodSlot(0)
+		{}
+
+		/**
+		 *  The copy uses the same method as the original
+		 */
+		UpdatedValue( const UpdatedValue & other )
+		: OverRated::UpdatedObject(other), mIsApplyingUpdate(false),
+		  mIsIdleTracked(other.mIsIdleTracked), mUpdateMethod(0), mMethodSlot(0)
+		{
+			_attachMethod(other.mUpdateMethod);
+		}
+
+		virtual ~UpdatedValue()
+		{
+			_detachMethod();
+		}
+
+		/**
+		 *  Takes on the method of the other value, as well as its pause and timing states. The
+		 *  value is woken, as it may have somewhere new to go; subclasses which copy the value
+		 *  itself should do so through setValue(), or wake it again afterwards.
+		 */
+		UpdatedValue & operator=( const UpdatedValue & other )
+		{
+			if( this != &other ) {
+				OverRated::UpdatedObject::operator=(other);
+				mIsIdleTracked = other.mIsIdleTracked;
+				_detachMethod();
+				_attachMethod(other.mUpdateMethod);
+				OverRated::UpdatedObject::wake();
+			}
+			return *this;
+		}
 
 		/**
 		 *  An updated value must overload this accessor for the changing value
@@ -52,7 +86,8 @@ namespace OverRated
 		virtual T getValue() const = 0;
 
 		/**
-		 *  An updated value must overload this setter for the changing value
+		 *  An updated value must overload this setter for the changing value. Overloads should
+		 *  call _onValueChanged() once the value is stored.
 		 *
 		 *  @param value   The value to apply
 		 */
@@ -67,10 +102,57 @@ namespace OverRated
 		 */
 		void setMethod( OverRated::UpdateMethod<T> * method )
 		{
-			mUpdateMethod = method;
+			_onMethodChanging();
+
+			_detachMethod();
+			_attachMethod(method);
 
 			// Adjust any invalid initial setting
 			_addTime(0.0);
+
+			OverRated::UpdatedObject::wake();
+		}
+
+		/**
+		 *  Moves the target of the current method without replacing the method, and has the
+		 *  value carry on towards it ( @see UpdateMethod::setTargetValue() ). Every other value
+		 *  using the same method is retargeted and woken too. Does nothing without a method.
+		 *
+		 *  @param target   The value to try and reach
+		 */
+		void setTargetValue( const T & target )
+		{
+			if( mUpdateMethod ) {
+				_onMethodChanging();
+				mUpdateMethod->setTargetValue(target);
+			}
+		}
+
+		/**
+		 *  As setTargetValue(), but giving the method a directional target
+		 *
+		 *  @param target   The constant direction to travel in
+		 */
+		void setTargetDirection( OverRated::ConstDirection target )
+		{
+			if( mUpdateMethod ) {
+				_onMethodChanging();
+				mUpdateMethod->setTargetDirection(target);
+			}
+		}
+
+		/**
+		 *  As setTargetValue(), changing the rate of the method as well
+		 *
+		 *  @param rate     The new rate (magnitude is used)
+		 *  @param target   The value to try and reach
+		 */
+		void retarget( const T & rate, const T & target )
+		{
+			if( mUpdateMethod ) {
+				_onMethodChanging();
+				mUpdateMethod->retarget(rate, target);
+			}
 		}
 
 		/**
@@ -94,7 +176,145 @@ namespace OverRated
 			return false;
 		}
 
+		/**
+		 *  A value is idle once it has no method or has reached its target, but only if its
+		 *  subclass has said that it will notice any change to the value
+		 *  ( @see _setIsIdleTracked() ). Otherwise lists keep updating it, as they always have.
+		 *
+		 *  @return   Whether adding time would do nothing
+		 */
+		bool getIsIdle() const
+		{
+			return mIsIdleTracked && !getIsUpdating();
+		}
+
+		/**
+		 *  Works out what the value will be once more time has been added, without changing it
+		 *  ( @see UpdateMethod::continueAt() ). With fixed steps, passing the time still pending
+		 *  gives a smooth value between steps; for a value in a list with a fixed step, that is
+		 *  the list's getPendingTime().
+		 *
+		 *  Methods such as eased and spring keep the state of one transition. This follows it
+		 *  only for the value the method last moved; for any other value sharing the method it
+		 *  starts afresh, as that value's next update will.
+		 *
+		 *  @param time   How far ahead to look, in seconds
+		 *  @return       The value that far ahead
+		 */
+		T getValueAhead( double time ) const
+		{
+			if( mUpdateMethod && time > 0.0 )
+				return mUpdateMethod->continueAt(getValue(), time);
+
+			return getValue();
+		}
+
+		/**
+		 *  @return   The value as of all the time added to it, including time pending towards the
+		 *            next fixed step ( @see setFixedStep() )
+		 */
+		T getInterpolatedValue() const
+		{
+			return getValueAhead(getPendingTime());
+		}
+
+		/**
+		 *  A value is finished once it has a method and has reached the method's target
+		 *
+		 *  @return   Whether the value is finished
+		 */
+		bool getIsFinished() const
+		{
+			return mUpdateMethod && mUpdateMethod->getIsFinished(getValue());
+		}
+
+		/**
+		 *  Asks the method how long the value will take to reach its target
+		 *  ( @see UpdateMethod::timeToFinish() )
+		 *
+		 *  @return   Time in seconds, 0 if the method can't tell, or a negative number if the
+		 *            value won't get there as things are
+		 */
+		double getTimeToFinish() const
+		{
+			if( !mUpdateMethod )
+				return -1.0;
+
+			double time = mUpdateMethod->timeToFinish(getValue());
+
+			if( time < 0.0 && !mUpdateMethod->getIsPredictable() )
+				return 0.0;
+
+			return time;
+		}
+
+	protected:
+		/**
+		 *  Called by setMethod() while the old method is still in place, and before the method
+		 *  is retargeted, for subclasses which need to know where the old one had got to.
+		 */
+		virtual void _onMethodChanging() {}
+
+		/**
+		 *  Subclasses should call this whenever setValue() changes the value, so that lists which
+		 *  have stopped updating this value notice that it may need updating again. Changes made
+		 *  by the update itself are ignored.
+		 */
+		void _onValueChanged()
+		{
+			if( !mIsApplyingUpdate )
+				OverRated::UpdatedObject::wake();
+		}
+
+		/**
+		 *  Subclasses whose value can only change through setValue(), which calls
+		 *  _onValueChanged(), should turn this on so that lists can stop visiting the value once
+		 *  it is idle. It is off by default because a value which can change without being told,
+		 *  such as a variable held by reference, would never be woken again.
+		 *
+		 *  @param tracked   Whether the value may report itself as idle
+		 */
+		void _setIsIdleTracked( bool tracked )
+		{
+			mIsIdleTracked = tracked;
+		}
+
 	private:
+		template <typename V> friend class OverRated::UpdatedValueList;
+		friend class OverRated::UpdateMethod<T>;
+
+		/**
+		 *  Starts using a method, adding this value to the method's users
+		 *
+		 *  @param method   The method, or NULL
+		 */
+		void _attachMethod( OverRated::UpdateMethod<T> * method )
+		{
+			mUpdateMethod = method;
+
+			if( method ) {
+				mMethodSlot = method->mUsers.size();
+				method->mUsers.push_back(this);
+			}
+		}
+
+		/**
+		 *  Stops using the current method, if any, removing this value from its users. The last
+		 *  user takes this value's place.
+		 */
+		void _detachMethod()
+		{
+			if( !mUpdateMethod )
+				return;
+
+			std::vector<UpdatedValue*> & users = mUpdateMethod->mUsers;
+
+			users[mMethodSlot] = users.back();
+			users[mMethodSlot]->mMethodSlot = mMethodSlot;
+			users.pop_back();
+			mUpdateMethod = 0;
+		}
+
 		/**
 		 *  Add time in seconds to this object to update the value using the installed
 		 *  UpdateMethod (if any)
@@ -103,12 +323,35 @@ namespace OverRated
 		 */
 		void _addTime( const double & timeElapsed )
 		{
-			if( getIsUpdating() )
-				setValue( mUpdateMethod->updateValue( getValue(), timeElapsed ) );
+			if( !mUpdateMethod ) {
+				OverRated::UpdatedObject::_setIsIdleAfterUpdate(mIsIdleTracked);
+				return;
+			}
+
+			T value = getValue();
+
+			// Whether the value is still updating is known from here, so lists needn't ask
+			if( !mUpdateMethod->getIsFinished(value) ) {
+				value = mUpdateMethod->updateValue(value, timeElapsed);
+
+				mIsApplyingUpdate = true;
+				setValue(value);
+				mIsApplyingUpdate = false;
+
+				if( !mIsIdleTracked || !mUpdateMethod->getIsFinished(value) ) {
+					OverRated::UpdatedObject::_setIsIdleAfterUpdate(false);
+					return;
+				}
+			}
+
+			OverRated::UpdatedObject::_setIsIdleAfterUpdate(mIsIdleTracked);
 		}
 
 	private:
+		bool mIsApplyingUpdate;						// Set while the update calls setValue()
+		bool mIsIdleTracked;						// Whether getIsIdle() may return true
 		OverRated::UpdateMethod<T> * mUpdateMethod;	// The method of updating the managed value
+		unsigned mMethodSlot;						// Where this is in the method's users
 	};
 }
 
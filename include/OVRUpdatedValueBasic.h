@@ -46,6 +46,20 @@ namespace OverRated
 		UpdatedValueBasic( const T & initValue )
 		{
 			mVar = initValue;
+			OverRated::UpdatedValue<T>::_setIsIdleTracked(true);
+		}
+
+		/**
+		 *  Takes on the value of the other as well as its method and states, waking this value
+		 *  once the value has been copied
+		 */
+		UpdatedValueBasic & operator=( const UpdatedValueBasic & other )
+		{
+			if( this != &other ) {
+				OverRated::UpdatedValue<T>::operator=(other);
+				setValue(other.mVar);
+			}
+			return *this;
 		}
 
 		/**
@@ -66,6 +80,7 @@ namespace OverRated
 		void setValue(const T & value)
 		{
 			mVar = value;
+			OverRated::UpdatedValue<T>::_onValueChanged();
 		}
 
 	private:
@@ -0,0 +1,147 @@
+/**
+ *	UpdatedValueLazy Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEDVALUELAZY_H_DEFINED__
+#define OVERRATED_UPDATEDVALUELAZY_H_DEFINED__
+
+#include "OVRUpdatedValue.h"
+#include "OVRUpdatedClock.h"
+
+namespace OverRated
+{
+	/**
+	 *  This type of updated value is never stepped. It remembers a start value and the time on
+	 *  a shared UpdatedClock when it started, and works the current value out whenever it is
+	 *  read ( @see UpdateMethod::evaluateAt() ). Add the clock to a list instead of the values;
+	 *  ticking then costs the same however many values read that clock, and the work is only
+	 *  done for values which are actually read.
+	 *
+	 *  Some things to be aware of:
+	 *   - Reads are exact only for methods where getIsPredictable() is true. Others are treated
+	 *     as if all the time since the start had passed in a single update.
+	 *   - Changing the settings of the method in use changes the whole path from the start, not
+	 *     just from now. Call rebase() first if the change should only apply from now on.
+	 *   - Nothing ever adds time to the value itself, so pausing it does nothing. Pause the
+	 *     clock instead.
+	 */
+	template <typename T>
+	class UpdatedValueLazy : public OverRated::UpdatedValue<T>
+	{
+	public:
+		/**
+		 *  Constructor
+		 *
+		 *  @param clock       The clock to read the time from. It must outlive this value.
+		 *  @param initValue   Initializes the value, starting from the clock's current time
+		 */
+		UpdatedValueLazy( const OverRated::UpdatedClock & clock, const T & initValue )
+		: mClock( &clock ), mStartValue( initValue ), mStartTime( clock.getTime() )
+		{}
+
+		/**
+		 *  Getter for the value; required of the UpdatedValue template. This is where the
+		 *  update is worked out.
+		 *
+		 *  @return   The value at the clock's current time
+		 */
+		T getValue() const
+		{
+			OverRated::UpdateMethod<T> * method = OverRated::UpdatedValue<T>::getMethod();
+
+			if( method )
+				return method->evaluateAt(mStartValue, mClock->getTime() - mStartTime);
+
+			return mStartValue;
+		}
+
+		/**
+		 *  Setter for the value; required of the UpdatedValue template. The value starts again
+		 *  from here at the clock's current time.
+		 *
+		 *  @param value   The new value being set
+		 */
+		void setValue( const T & value )
+		{
+			mStartValue = value;
+			mStartTime = mClock->getTime();
+			OverRated::UpdatedValue<T>::_onValueChanged();
+		}
+
+		/**
+		 *  Makes the current value the new start, so that changes made to the method from now on
+		 *  don't affect the path taken so far.
+		 */
+		void rebase()
+		{
+			T current = getValue();
+
+			mStartValue = current;
+			mStartTime = mClock->getTime();
+		}
+
+		/**
+		 *  @return   The clock this value reads
+		 */
+		const OverRated::UpdatedClock & getClock() const
+		{
+			return *mClock;
+		}
+
+		/**
+		 *  A lazy value never needs time added, so lists can always skip it
+		 *
+		 *  @return   Always true
+		 */
+		bool getIsIdle() const
+		{
+			return true;
+		}
+
+	protected:
+		/**
+		 *  The path so far belongs to the old method, so start again from where it got to
+		 */
+		void _onMethodChanging()
+		{
+			rebase();
+		}
+
+	private:
+		/**
+		 *  Time comes from the clock, so there is nothing to do here
+		 *
+		 *  @param timeElapsed   The amount of time that has passed in seconds (1.0 = 1 sec)
+		 */
+		void _addTime( const double & timeElapsed ) {}
+
+	private:
+		const OverRated::UpdatedClock * mClock;	// Where the time comes from
+		T mStartValue;							// The value at mStartTime
+		double mStartTime;						// Clock time the current path started at
+	};
+}
+
+#endif // OVERRATED_UPDATEDVALUELAZY_H_DEFINED__
@@ -0,0 +1,576 @@
+/**
+ *	UpdatedValueList Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEDVALUELIST_H_DEFINED__
+#define OVERRATED_UPDATEDVALUELIST_H_DEFINED__
+
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "OVRHandle.h"
+#include "OVRUpdatedObject.h"
+#include "OVRUpdatedValue.h"
+#include "OVRUpdateMethodLinear.h"
+#include "OVRUpdateMethodLooped.h"
+#include "OVRUpdateStep.h"
+
+namespace OverRated
+{
+	/**
+	 *  A list of values of one concrete class V (UpdatedValueBasic<float>, say) which keeps its
+	 *  values grouped by the method they use. Where many values share a few methods, this
+	 *  saves most of the cost of updating them one by one: for each group using a plain
+	 *  UpdateMethodLinear or UpdateMethodLooped, the target, range and rate * time are read
+	 *  once, and every value in the group is stepped in a tight loop with no virtual calls.
+	 *  Values using any other method, or with a fixed step or time scale of their own, are
+	 *  updated just as UpdatedObjectList would update them. The results are the same anyway.
+	 *
+	 *  Only values of exactly class V may be added; the fast loop calls V's getValue() and
+	 *  setValue() directly, so a subclass overriding them would be bypassed. Methods are told
+	 *  apart by their exact class, so a subclass of UpdateMethodLinear takes the ordinary path.
+	 *
+	 *  A value moves to the right group by itself when it's given a new method. Groups are
+	 *  found by searching, so this suits a handful of methods rather than one per value.
+	 *
+	 *  The values themselves stay wherever their owners put them; only pointers to them are
+	 *  kept side by side in each group. The saving is in the method being read once per group
+	 *  and in the calls not being virtual, not in the values being next to each other in
+	 *  memory, so values allocated together update fastest.
+	 */
+	template <typename V>
+	class UpdatedValueList : public OverRated::UpdatedObject, public OverRated::UpdatedObjectParent
+	{
+	public:
+		typedef typename V::ValueType T;
+
+		static_assert(!std::is_abstract<V>::value, "UpdatedValueList needs a concrete value class");
+
+		UpdatedValueList()
+		: mFreeSlot(NO_SLOT), mSize(0), mIsIdle(true)
+		{}
+
+		/**
+		 *  The list only refers to its values, so they are left alone
+		 */
+		virtual ~UpdatedValueList()
+		{
+			clear();
+		}
+
+		/**
+		 *  Adds a value to the list, in the group of its method
+		 *
+		 *  @param newItem  The value to add
+		 *  @return         A handle to the value; if it was already in the list, its existing one
+		 */
+		OverRated::Handle add( V * newItem )
+		{
+			unsigned slot;
+
+			if( newItem->_findParent(this, slot) )
+				return OverRated::Handle(slot, mSlots[slot].generation);
+
+			if( mFreeSlot != NO_SLOT ) {
+				slot = mFreeSlot;
+				mFreeSlot = mSlots[slot].index;
+				mSlots[slot].generation++;
+			}
+			else {
+				slot = mSlots.size();
+				mSlots.push_back(Slot());
+			}
+
+			_insert(slot, newItem);
+			mSize++;
+			newItem->_attachParent(this, slot);
+
+			if( !newItem->getIsPaused() && !newItem->getIsIdle() )
+				_wakeList();
+
+			return OverRated::Handle(slot, mSlots[slot].generation);
+		}
+
+		/**
+		 *  Removes a value from the list (if it is actually there)
+		 *
+		 *  @param item   The value to remove
+		 */
+		void remove( V * item )
+		{
+			unsigned slot;
+
+			if( item && item->_findParent(this, slot) ) {
+				item->_detachParent(this);
+				_removeSlot(slot);
+			}
+		}
+
+		/**
+		 *  Removes a value from the list (if the handle isn't stale)
+		 *
+		 *  @param handle   Handle of the value to remove
+		 */
+		void remove( const OverRated::Handle & handle )
+		{
+			V * item = getItem(handle);
+
+			if( item ) {
+				item->_detachParent(this);
+				_removeSlot(handle.slot);
+			}
+		}
+
+		/**
+		 *  Clears the list without deleting anything. Every handle to the list becomes stale.
+		 */
+		void clear()
+		{
+			for( unsigned b = 0; b < mBuckets.size(); b++ ) {
+				Bucket & bucket = mBuckets[b];
+
+				for( unsigned i = 0; i < bucket.values.size(); i++ ) {
+					bucket.values[i]->_detachParent(this);
+					_freeSlot(bucket.slots[i]);
+				}
+			}
+
+			mBuckets.clear();
+			mSize = 0;
+			mIsIdle = true;
+		}
+
+		/**
+		 *  Accessor by handle
+		 *
+		 *  @param handle   Handle of the desired value
+		 *  @return         The value, or NULL if the handle is stale
+		 */
+		V * getItem( const OverRated::Handle & handle ) const
+		{
+			if( !contains(handle) )
+				return 0;
+
+			const Slot & slot = mSlots[handle.slot];
+
+			return mBuckets[slot.bucket].values[slot.index];
+		}
+
+		/**
+		 *  @return   Number of values in the list
+		 */
+		unsigned getSize() const
+		{
+			return mSize;
+		}
+
+		/**
+		 *  @return   Number of groups, one for each method in use (and one for no method)
+		 */
+		unsigned getGroupCount() const
+		{
+			return mBuckets.size();
+		}
+
+		/**
+		 *  @param item   The value to query the list for
+		 *  @return       Whether the value is in this list
+		 */
+		bool contains( const V * item ) const
+		{
+			unsigned slot;
+
+			return item && item->_findParent(this, slot);
+		}
+
+		/**
+		 *  @param handle   The handle to check
+		 *  @return         Whether the handle still refers to a value in this list
+		 */
+		bool contains( const OverRated::Handle & handle ) const
+		{
+			return handle.slot < mSlots.size() &&
+					mSlots[handle.slot].generation == handle.generation &&
+					(mSlots[handle.slot].generation & 1) == 0;
+		}
+
+		/**
+		 *  The list is idle once none of its unpaused values moved in the last update
+		 *
+		 *  @return   Whether adding time would do nothing
+		 */
+		bool getIsIdle() const
+		{
+			return mIsIdle;
+		}
+
+	protected:
+		/**
+		 *  Updates every group in turn
+		 *
+		 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+		 */
+		void _addTime( const double & timeElapsed )
+		{
+			bool updating = false;
+
+			for( unsigned b = 0; b < mBuckets.size(); b++ ) {
+				Bucket & bucket = mBuckets[b];
+				OverRated::UpdateMethod<T> * method = bucket.method;
+
+				if( !method )
+					continue;
+
+				if( typeid(*method) == typeid(OverRated::UpdateMethodLinear<T>) )
+					updating |= _updateLinear(bucket, timeElapsed);
+				else if( typeid(*method) == typeid(OverRated::UpdateMethodLooped<T>) )
+					updating |= _updateLooped(bucket, timeElapsed);
+				else
+					updating |= _updateEach(bucket, timeElapsed);
+			}
+
+#ifdef OVERRATED_ENABLE_COUNTERS
+			OverRated::FlushCounters();
+#endif
+
+			mIsIdle = !updating;
+		}
+
+		/**
+		 *  A destroyed value is forgotten without touching it
+		 *
+		 *  @param slot   The slot of the value
+		 */
+		void _onChildDestroyed( unsigned slot )
+		{
+			_removeSlot(slot);
+		}
+
+		/**
+		 *  A value wakes when it is given a new method, so this is where it changes groups
+		 *
+		 *  @param slot   The slot of the value
+		 */
+		void _onChildWoken( unsigned slot )
+		{
+			Slot & entry = mSlots[slot];
+			V * item = mBuckets[entry.bucket].values[entry.index];
+
+			if( item->getMethod() != mBuckets[entry.bucket].method ) {
+				_erase(slot);
+				_insert(slot, item);
+			}
+
+			_wakeList();
+		}
+
+	private:
+		enum { NO_SLOT = ~0u };
+
+		// Where a value is kept. Generations work as they do in UpdatedObjectList; a free
+		// slot's index is the next free slot.
+		struct Slot
+		{
+			Slot() : bucket(0), index(0), generation(0) {}
+
+			unsigned bucket;
+			unsigned index;
+			unsigned generation;
+		};
+
+		// Pointers to the values using one method, side by side
+		struct Bucket
+		{
+			OverRated::UpdateMethod<T> * method;
+			std::vector<V *> values;
+			std::vector<unsigned> slots;		// Slot of each value
+		};
+
+		/**
+		 *  Whether a value should be left to update itself; paused values aren't updated at
+		 *  all, and values with a fixed step or time scale apply time in their own way
+		 *
+		 *  @param item          The value
+		 *  @param timeElapsed   The time elapsed since last time
+		 *  @param updating      Set if the value is still updating afterwards
+		 *  @return              Whether the value was dealt with
+		 */
+		static bool _updateSelf( V * item, const double & timeElapsed, bool & updating )
+		{
+			if( item->getIsPaused() )
+				return true;
+
+			if( item->getFixedStep() > 0.0 || item->getTimeScale() != 1.0 ) {
+				item->addTime(timeElapsed);
+				updating |= !item->_getIsIdleAfterUpdate();
+				return true;
+			}
+
+			return false;
+		}
+
+		/**
+		 *  Stores a new value as the result of an update, so the value doesn't wake itself
+		 */
+		static void _apply( V * item, const T & value )
+		{
+			item->mIsApplyingUpdate = true;
+			item->V::setValue(value);
+			item->mIsApplyingUpdate = false;
+		}
+
+		/**
+		 *  Steps a group using an UpdateMethodLinear
+		 *
+		 *  @return   Whether any value in the group is still updating
+		 */
+		bool _updateLinear( Bucket & bucket, const double & timeElapsed )
+		{
+			const OverRated::UpdateMethod<T> & method = *bucket.method;
+			const T magnitude( method.getRate() * timeElapsed );
+			const unsigned count = bucket.values.size();
+			bool updating = false;
+
+			if( method.getHasTargetDirection() ) {
+				const OverRated::ConstDirection dir = method.getTargetDirection();
+
+				for( unsigned i = 0; i < count; i++ ) {
+					V * item = bucket.values[i];
+
+					if( !_updateSelf(item, timeElapsed, updating) ) {
+						_apply(item, OverRated::StepApplyDirection(item->V::getValue(), dir,
+								magnitude));
+						updating = true;
+					}
+				}
+
+				return updating;
+			}
+
+			const T target = method.getTargetValue();
+
+			for( unsigned i = 0; i < count; i++ ) {
+				V * item = bucket.values[i];
+
+				if( _updateSelf(item, timeElapsed, updating) )
+					continue;
+
+				T value = item->V::getValue();
+
+				if( !(value == target) ) {
+					value = OverRated::StepLinearToValue(value, target, magnitude);
+					_apply(item, value);
+					updating |= !(value == target);
+				}
+			}
+
+			return updating;
+		}
+
+		/**
+		 *  Steps a group using an UpdateMethodLooped
+		 *
+		 *  @return   Whether any value in the group is still updating
+		 */
+		bool _updateLooped( Bucket & bucket, const double & timeElapsed )
+		{
+			const OverRated::UpdateMethodLooped<T> & method =
+					static_cast<const OverRated::UpdateMethodLooped<T> &>(*bucket.method);
+			const T magnitude( method.getRate() * timeElapsed );
+			const T min = method.getMin();
+			const T max = method.getMax();
+			const unsigned count = bucket.values.size();
+			bool updating = false;
+
+			if( method.getHasTargetDirection() ) {
+				const OverRated::ConstDirection dir = method.getTargetDirection();
+
+				for( unsigned i = 0; i < count; i++ ) {
+					V * item = bucket.values[i];
+
+					if( !_updateSelf(item, timeElapsed, updating) ) {
+						_apply(item, OverRated::StepLoopedInDirection(item->V::getValue(), dir,
+								magnitude, min, max));
+						updating = true;
+					}
+				}
+
+				return updating;
+			}
+
+			const T target = method.getTargetValue();
+			const bool forced = method.getIsOverrideEnabled();
+			// The override direction is only defined when it is enabled
+			const OverRated::ConstDirection dir = forced ? method.getDirectionOverride() :
+					OverRated::CD_INCREASING;
+
+			for( unsigned i = 0; i < count; i++ ) {
+				V * item = bucket.values[i];
+
+				if( _updateSelf(item, timeElapsed, updating) )
+					continue;
+
+				T value = item->V::getValue();
+
+				if( !(value == target) ) {
+					if( forced )
+						value = OverRated::StepLoopedToValue(value, target, magnitude, min, max,
+								dir);
+					else
+						value = OverRated::StepLoopedToValue(value, target, magnitude, min, max);
+
+					_apply(item, value);
+					updating |= !(value == target);
+				}
+			}
+
+			return updating;
+		}
+
+		/**
+		 *  Updates a group with any other method one value at a time
+		 *
+		 *  @return   Whether any value in the group is still updating
+		 */
+		bool _updateEach( Bucket & bucket, const double & timeElapsed )
+		{
+			bool updating = false;
+
+			for( unsigned i = 0; i < bucket.values.size(); i++ ) {
+				V * item = bucket.values[i];
+
+				if( !item->getIsPaused() ) {
+					item->addTime(timeElapsed);
+					updating |= !item->_getIsIdleAfterUpdate();
+				}
+			}
+
+			return updating;
+		}
+
+		/**
+		 *  Puts a value at the end of the group for its method, making the group if needed
+		 *
+		 *  @param slot   The slot of the value
+		 *  @param item   The value
+		 */
+		void _insert( unsigned slot, V * item )
+		{
+			OverRated::UpdateMethod<T> * method = item->getMethod();
+			unsigned b = 0;
+
+			while( b < mBuckets.size() && mBuckets[b].method != method )
+				b++;
+
+			if( b == mBuckets.size() ) {
+				mBuckets.push_back(Bucket());
+				mBuckets[b].method = method;
+			}
+
+			mSlots[slot].bucket = b;
+			mSlots[slot].index = mBuckets[b].values.size();
+			mBuckets[b].values.push_back(item);
+			mBuckets[b].slots.push_back(slot);
+		}
+
+		/**
+		 *  Takes a value out of its group. The last value of the group takes its place, and a
+		 *  group left empty is replaced by the last group.
+		 *
+		 *  @param slot   The slot of the value
+		 */
+		void _erase( unsigned slot )
+		{
+			unsigned b = mSlots[slot].bucket;
+			unsigned index = mSlots[slot].index;
+			Bucket & bucket = mBuckets[b];
+
+			bucket.values[index] = bucket.values.back();
+			bucket.slots[index] = bucket.slots.back();
+			mSlots[bucket.slots[index]].index = index;
+			bucket.values.pop_back();
+			bucket.slots.pop_back();
+
+			if( bucket.values.empty() ) {
+				unsigned last = mBuckets.size() - 1;
+
+				if( b != last ) {
+					std::swap(mBuckets[b], mBuckets[last]);
+
+					for( unsigned i = 0; i < mBuckets[b].slots.size(); i++ )
+						mSlots[mBuckets[b].slots[i]].bucket = b;
+				}
+
+				mBuckets.pop_back();
+			}
+		}
+
+		/**
+		 *  Forgets the value in a slot and frees the slot
+		 *
+		 *  @param slot   The slot of the value
+		 */
+		void _removeSlot( unsigned slot )
+		{
+			_erase(slot);
+			_freeSlot(slot);
+			mSize--;
+		}
+
+		/**
+		 *  Puts a slot on the free list. Its generation moves on so old handles become stale.
+		 *
+		 *  @param slot   The slot to free
+		 */
+		void _freeSlot( unsigned slot )
+		{
+			mSlots[slot].generation++;
+			mSlots[slot].index = mFreeSlot;
+			mFreeSlot = slot;
+		}
+
+		/**
+		 *  Something changed which may give the list work to do again
+		 */
+		void _wakeList()
+		{
+			if( mIsIdle ) {
+				mIsIdle = false;
+				wake();
+			}
+		}
+
+	private:
+		std::vector<Bucket> mBuckets;	// The values, grouped by method
+		std::vector<Slot> mSlots;		// Where each value is kept, by slot
+		unsigned mFreeSlot;				// First free slot, or NO_SLOT
+		unsigned mSize;					// Number of values
+		bool mIsIdle;					// Whether nothing moved in the last update
+	};
+}
+
+#endif // OVERRATED_UPDATEDVALUELIST_H_DEFINED__
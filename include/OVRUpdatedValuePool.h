@@ -0,0 +1,403 @@
+/**
+ *	UpdatedValuePool Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEDVALUEPOOL_H_DEFINED__
+#define OVERRATED_UPDATEDVALUEPOOL_H_DEFINED__
+
+#include <vector>
+
+#include "OVRUpdatedObject.h"
+#include "OVRUpdateMethodLinear.h"
+#include "OVRUpdateMethodLooped.h"
+#include "OVRUpdateStep.h"
+#include "OVRSnapshot.h"
+
+namespace OverRated
+{
+	/**
+	 *  A container for large numbers of plain values which are updated the same way an
+	 *  UpdatedValueBasic would be, using the settings of an UpdateMethodLinear or
+	 *  UpdateMethodLooped. Rather than storing an object per value, everything is kept in
+	 *  parallel arrays and the whole pool is stepped in a single pass when time is added.
+	 *
+	 *  Values are addressed by index. Methods are copied into the pool when set, so changing an
+	 *  UpdateMethod afterwards does not affect values that were already given it. The pool is
+	 *  idle once every unpaused value has reached its target.
+	 */
+	template <typename T>
+	class UpdatedValuePool : public OverRated::UpdatedObject
+	{
+	private:
+		// How a value in the pool is updated
+		enum Mode
+		{
+			M_NONE,					// No method; the value is left alone
+			M_LINEAR_VALUE,			// UpdateMethodLinear with a value target
+			M_LINEAR_DIRECTION,		// UpdateMethodLinear with a directional target
+			M_LOOPED_VALUE,			// UpdateMethodLooped with a value target
+			M_LOOPED_OVERRIDE,		// UpdateMethodLooped with a value target and override
+			M_LOOPED_DIRECTION		// UpdateMethodLooped with a directional target
+		};
+
+	public:
+		UpdatedValuePool()
+		: mIsIdle(true)
+		{}
+
+		/**
+		 *  Adds a new value with no method to the end of the pool
+		 *
+		 *  @param initValue   Initializes the new value
+		 *  @return            Index of the new value
+		 */
+		unsigned add( const T & initValue )
+		{
+			mValues.push_back(initValue);
+			mRates.push_back(T(0));
+			mTargets.push_back(T(0));
+			mMins.push_back(T(0));
+			mMaxs.push_back(T(0));
+			mModes.push_back(M_NONE);
+			mDirs.push_back(OverRated::CD_INCREASING);
+			mPaused.push_back(false);
+
+			return mValues.size() - 1;
+		}
+
+		/**
+		 *  Removes a value from the pool. To keep the arrays packed, the last value in the pool
+		 *  is moved into its place, so the index of that value changes to 'index'.
+		 *
+		 *  @param index   Index of the value to remove
+		 */
+		void remove( unsigned index )
+		{
+			unsigned last = mValues.size() - 1;
+
+			mValues[index] = mValues[last];
+			mRates[index] = mRates[last];
+			mTargets[index] = mTargets[last];
+			mMins[index] = mMins[last];
+			mMaxs[index] = mMaxs[last];
+			mModes[index] = mModes[last];
+			mDirs[index] = mDirs[last];
+			mPaused[index] = mPaused[last];
+
+			mValues.pop_back();
+			mRates.pop_back();
+			mTargets.pop_back();
+			mMins.pop_back();
+			mMaxs.pop_back();
+			mModes.pop_back();
+			mDirs.pop_back();
+			mPaused.pop_back();
+		}
+
+		/**
+		 *  Removes every value from the pool
+		 */
+		void clear()
+		{
+			mValues.clear();
+			mRates.clear();
+			mTargets.clear();
+			mMins.clear();
+			mMaxs.clear();
+			mModes.clear();
+			mDirs.clear();
+			mPaused.clear();
+		}
+
+		/**
+		 *  Pre-allocates room for a number of values
+		 *
+		 *  @param capacity   The number of values to make room for
+		 */
+		void reserve( unsigned capacity )
+		{
+			mValues.reserve(capacity);
+			mRates.reserve(capacity);
+			mTargets.reserve(capacity);
+			mMins.reserve(capacity);
+			mMaxs.reserve(capacity);
+			mModes.reserve(capacity);
+			mDirs.reserve(capacity);
+			mPaused.reserve(capacity);
+		}
+
+		/**
+		 *  @return   The number of values in the pool
+		 */
+		unsigned getSize() const
+		{
+			return mValues.size();
+		}
+
+		/**
+		 *  @param index   Index of the value
+		 *  @return        The value at its current state
+		 */
+		T getValue( unsigned index ) const
+		{
+			return mValues[index];
+		}
+
+		/**
+		 *  @param index   Index of the value
+		 *  @param value   The new value
+		 */
+		void setValue( unsigned index, const T & value )
+		{
+			mValues[index] = value;
+			_wakePool();
+		}
+
+		/**
+		 *  Direct access to the packed values, for reading them in bulk
+		 *
+		 *  @return   Pointer to the first of getSize() values
+		 */
+		const T * getValues() const
+		{
+			return mValues.empty() ? 0 : &mValues[0];
+		}
+
+		/**
+		 *  Publishes every value in the pool, in index order, as the next frame of a snapshot
+		 *  for other threads to read ( @see Snapshot ). Call it from the thread adding time.
+		 *
+		 *  @param snapshot   The snapshot, with room for every value
+		 */
+		void publish( OverRated::Snapshot<T> & snapshot ) const
+		{
+			snapshot.publish(getValues(), getSize());
+		}
+
+		/**
+		 *  Gives a value the settings of a linear method.
+		 *
+		 *  @param index    Index of the value
+		 *  @param method   The method to copy
+		 */
+		void setMethod( unsigned index, const OverRated::UpdateMethodLinear<T> & method )
+		{
+			mRates[index] = method.getRate();
+
+			if( method.getHasTargetValue() ) {
+				mModes[index] = M_LINEAR_VALUE;
+				mTargets[index] = method.getTargetValue();
+			}
+			else {
+				mModes[index] = M_LINEAR_DIRECTION;
+				mDirs[index] = method.getTargetDirection();
+			}
+
+			// Adjust any invalid initial setting
+			_step(index, 0.0);
+			_wakePool();
+		}
+
+		/**
+		 *  Gives a value the settings of a looped method.
+		 *
+		 *  @param index    Index of the value
+		 *  @param method   The method to copy
+		 */
+		void setMethod( unsigned index, const OverRated::UpdateMethodLooped<T> & method )
+		{
+			mRates[index] = method.getRate();
+			mMins[index] = method.getMin();
+			mMaxs[index] = method.getMax();
+
+			if( method.getHasTargetValue() ) {
+				mTargets[index] = method.getTargetValue();
+
+				if( method.getIsOverrideEnabled() ) {
+					mModes[index] = M_LOOPED_OVERRIDE;
+					mDirs[index] = method.getDirectionOverride();
+				}
+				else
+					mModes[index] = M_LOOPED_VALUE;
+			}
+			else {
+				mModes[index] = M_LOOPED_DIRECTION;
+				mDirs[index] = method.getTargetDirection();
+			}
+
+			// Adjust any invalid initial setting
+			_step(index, 0.0);
+			_wakePool();
+		}
+
+		/**
+		 *  Detaches the method from a value, so that it is no longer updated
+		 *
+		 *  @param index   Index of the value
+		 */
+		void clearMethod( unsigned index )
+		{
+			mModes[index] = M_NONE;
+		}
+
+		/**
+		 *  Pauses or unpauses a single value in the pool
+		 *
+		 *  @param index    Index of the value
+		 *  @param paused   Whether to pause(true) or unpause(false)
+		 */
+		void setIsPaused( unsigned index, bool paused )
+		{
+			mPaused[index] = paused;
+
+			if( !paused )
+				_wakePool();
+		}
+
+		/**
+		 *  @param index   Index of the value
+		 *  @return        The pause state of that value
+		 */
+		bool getIsPaused( unsigned index ) const
+		{
+			return mPaused[index] != 0;
+		}
+
+		// The pool itself can still be paused as a whole
+		using OverRated::UpdatedObject::setIsPaused;
+		using OverRated::UpdatedObject::getIsPaused;
+
+		/**
+		 *  @return   Whether every unpaused value has reached its target
+		 */
+		bool getIsIdle() const
+		{
+			return mIsIdle;
+		}
+
+		/**
+		 *  @param index   Index of the value
+		 *  @return        Whether the value has a method and has not reached its target
+		 */
+		bool getIsUpdating( unsigned index ) const
+		{
+			switch( mModes[index] )
+			{
+			case M_NONE:
+				return false;
+			case M_LINEAR_VALUE:
+			case M_LOOPED_VALUE:
+			case M_LOOPED_OVERRIDE:
+				return !(mValues[index] == mTargets[index]);
+			default:
+				return true;
+			}
+		}
+
+	private:
+		/**
+		 *  When time is added, every unpaused value is stepped in one pass over the arrays.
+		 *
+		 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+		 */
+		void _addTime( const double & timeElapsed )
+		{
+			unsigned size = mValues.size();
+			bool updating = false;
+
+			for( unsigned i = 0; i < size; i++ ) {
+				if( !mPaused[i] )
+					updating |= _step(i, timeElapsed);
+			}
+
+			mIsIdle = !updating;
+		}
+
+		/**
+		 *  Something changed which may give the pool work to do again
+		 */
+		void _wakePool()
+		{
+			if( mIsIdle ) {
+				mIsIdle = false;
+				wake();
+			}
+		}
+
+		/**
+		 *  Updates a single value just as an UpdatedValue with the equivalent method would
+		 *
+		 *  @param i             Index of the value
+		 *  @param timeElapsed   The time elapsed since last time; normally, in seconds
+		 *  @return              Whether the value is still updating afterwards
+		 */
+		bool _step( unsigned i, const double & timeElapsed )
+		{
+			T & value = mValues[i];
+			T magnitude( mRates[i] * timeElapsed );
+			OverRated::ConstDirection dir = static_cast<OverRated::ConstDirection>(mDirs[i]);
+
+			switch( mModes[i] )
+			{
+			case M_LINEAR_VALUE:
+				if( !(value == mTargets[i]) )
+					value = OverRated::StepLinearToValue(value, mTargets[i], magnitude);
+				return !(value == mTargets[i]);
+			case M_LINEAR_DIRECTION:
+				value = OverRated::StepApplyDirection(value, dir, magnitude);
+				return true;
+			case M_LOOPED_VALUE:
+				if( !(value == mTargets[i]) )
+					value = OverRated::StepLoopedToValue(value, mTargets[i], magnitude,
+							mMins[i], mMaxs[i]);
+				return !(value == mTargets[i]);
+			case M_LOOPED_OVERRIDE:
+				if( !(value == mTargets[i]) )
+					value = OverRated::StepLoopedToValue(value, mTargets[i], magnitude,
+							mMins[i], mMaxs[i], dir);
+				return !(value == mTargets[i]);
+			case M_LOOPED_DIRECTION:
+				value = OverRated::StepLoopedInDirection(value, dir, magnitude,
+						mMins[i], mMaxs[i]);
+				return true;
+			default:
+				return false;
+			}
+		}
+
+	private:
+		std::vector<T> mValues;					// The updated values
+		std::vector<T> mRates;					// Rate of change of each value
+		std::vector<T> mTargets;				// Value target of each value, if it has one
+		std::vector<T> mMins;					// Looped range minimum of each value
+		std::vector<T> mMaxs;					// Looped range maximum of each value
+		std::vector<unsigned char> mModes;		// How each value is updated (see Mode)
+		std::vector<unsigned char> mDirs;		// Directional target or override of each value
+		std::vector<unsigned char> mPaused;		// Whether each value is paused
+		bool mIsIdle;							// Whether nothing moved in the last update
+	};
+}
+
+#endif // OVERRATED_UPDATEDVALUEPOOL_H_DEFINED__
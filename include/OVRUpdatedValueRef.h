@@ -36,6 +36,10 @@ namespace OverRated
 	 *  own variable, it influences an existing one by reference. Note that this isn't the only
 	 *  way to directly affect your own value. You can also roll your own and overload the getter
 	 *  and setter methods as needed.
+	 *
+	 *  Because the referenced variable can be changed without this knowing, lists keep updating
+	 *  the value even once it has reached its target. If every direct change to the variable is
+	 *  followed by a call to wake(), setIsIdleTracked() lets lists skip it while it is idle.
 	 */
 	template <typename T>
 	class UpdatedValueRef : public OverRated::UpdatedValue<T>
@@ -68,6 +72,19 @@ namespace OverRated
 		void setValue(const T & value)
 		{
 			mVar = value;
+			OverRated::UpdatedValue<T>::_onValueChanged();
+		}
+
+		/**
+		 *  Lets lists stop updating this value while it is idle. Only turn this on if every
+		 *  change made to the variable directly, rather than through setValue(), is followed by
+		 *  a call to wake(); otherwise the value may never be updated again.
+		 *
+		 *  @param tracked   Whether the value may report itself as idle
+		 */
+		void setIsIdleTracked( bool tracked )
+		{
+			OverRated::UpdatedValue<T>::_setIsIdleTracked(tracked);
 		}
 
 	private:
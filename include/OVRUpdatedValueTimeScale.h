@@ -0,0 +1,87 @@
+/**
+ *	UpdatedValueTimeScale Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_UPDATEDVALUETIMESCALE_H_DEFINED__
+#define OVERRATED_UPDATEDVALUETIMESCALE_H_DEFINED__
+
+#include "OVRUpdatedObject.h"
+#include "OVRUpdatedValue.h"
+
+namespace OverRated
+{
+	/**
+	 *  An updated value which is the time scale of an object
+	 *  ( @see UpdatedObject::setTimeScale() ), so that a list can be eased into slow motion,
+	 *  say, with any UpdateMethod:
+	 *
+	 *      UpdatedValueTimeScale slowMotion(world);
+	 *      UpdateMethodEased<double> ease(EC_QUAD_OUT, 0.5, 0.25);
+	 *
+	 *      slowMotion.setMethod(&ease);
+	 *      ui.add(&slowMotion);
+	 *
+	 *  Add it to a list which isn't itself being scaled, or it will slow itself down too. The
+	 *  object must last as long as this does.
+	 */
+	class UpdatedValueTimeScale : public OverRated::UpdatedValue<double>
+	{
+	public:
+		/**
+		 *  Constructor
+		 *
+		 *  @param object   The object whose time scale is updated
+		 */
+		UpdatedValueTimeScale( OverRated::UpdatedObject & object )
+		: mObject(object)
+		{}
+
+		/**
+		 *  Getter for the value; required of the UpdatedValue template.
+		 *
+		 *  @return   The object's time scale
+		 */
+		double getValue() const
+		{
+			return mObject.getTimeScale();
+		}
+
+		/**
+		 *  Setter for the value; required of the UpdatedValue template.
+		 *
+		 *  @param value   The new time scale (negative numbers are treated as 0)
+		 */
+		void setValue( const double & value )
+		{
+			mObject.setTimeScale(value);
+			OverRated::UpdatedValue<double>::_onValueChanged();
+		}
+
+	private:
+		OverRated::UpdatedObject & mObject;	// The object whose time scale is updated
+	};
+}
+
+#endif // OVERRATED_UPDATEDVALUETIMESCALE_H_DEFINED__
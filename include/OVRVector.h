@@ -0,0 +1,254 @@
+/**
+ *	Vector Class Definition
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	Copyright (c) 2011 Joseph Austin
+ *
+ *				Permission is hereby granted, free of charge, to any person obtaining a copy
+ *				of this software and associated documentation files (the "Software"), to deal
+ *				in the Software without restriction, including without limitation the rights
+ *				to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *				copies of the Software, and to permit persons to whom the Software is
+ *				furnished to do so, subject to the following conditions:
+ *
+ *				The above copyright notice and this permission notice shall be included in
+ *				all copies or substantial portions of the Software.
+ *
+ *				THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *				IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *				FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *				AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *				LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *				OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *				THE SOFTWARE.
+ */
+
+#ifndef OVERRATED_VECTOR_H_DEFINED__
+#define OVERRATED_VECTOR_H_DEFINED__
+
+#include <cmath>
+
+#include "assert.h"
+
+namespace OverRated
+{
+	/**
+	 *  A fixed size vector of components, for positions, colours, quaternions and the like. It
+	 *  has just the arithmetic UpdateMethod needs and no ordering, since a vector has none; use
+	 *  the vector methods with it ( @see UpdateMethodVector, UpdateMethodSlerp ). Quaternions
+	 *  are Vector<T, 4> in x, y, z, w order.
+	 */
+	template <typename T, unsigned N>
+	class Vector
+	{
+	public:
+		enum { SIZE = N };
+
+		/**
+		 *  Constructor; all components are zero
+		 */
+		Vector()
+		{
+			for( unsigned i = 0; i < N; i++ )
+				mValues[i] = T(0);
+		}
+
+		/**
+		 *  Constructor with every component the same
+		 *
+		 *  @param value   The value of each component
+		 */
+		explicit Vector( const T & value )
+		{
+			for( unsigned i = 0; i < N; i++ )
+				mValues[i] = value;
+		}
+
+		/**
+		 *  Constructor for two components
+		 */
+		Vector( const T & x, const T & y )
+		{
+			static_assert(N == 2, "Vector needs one value per component");
+			mValues[0] = x;
+			mValues[1] = y;
+		}
+
+		/**
+		 *  Constructor for three components
+		 */
+		Vector( const T & x, const T & y, const T & z )
+		{
+			static_assert(N == 3, "Vector needs one value per component");
+			mValues[0] = x;
+			mValues[1] = y;
+			mValues[2] = z;
+		}
+
+		/**
+		 *  Constructor for four components
+		 */
+		Vector( const T & x, const T & y, const T & z, const T & w )
+		{
+			static_assert(N == 4, "Vector needs one value per component");
+			mValues[0] = x;
+			mValues[1] = y;
+			mValues[2] = z;
+			mValues[3] = w;
+		}
+
+		T & operator[]( unsigned index )
+		{
+			assert( index < N );
+			return mValues[index];
+		}
+
+		const T & operator[]( unsigned index ) const
+		{
+			assert( index < N );
+			return mValues[index];
+		}
+
+		/**
+		 *  @return   The components as an array of N values
+		 */
+		T * getData() { return mValues; }
+		const T * getData() const { return mValues; }
+
+		bool operator==( const Vector & other ) const
+		{
+			for( unsigned i = 0; i < N; i++ ) {
+				if( !(mValues[i] == other.mValues[i]) )
+					return false;
+			}
+
+			return true;
+		}
+
+		bool operator!=( const Vector & other ) const
+		{
+			return !(*this == other);
+		}
+
+		Vector & operator+=( const Vector & other )
+		{
+			for( unsigned i = 0; i < N; i++ )
+				mValues[i] += other.mValues[i];
+
+			return *this;
+		}
+
+		Vector & operator-=( const Vector & other )
+		{
+			for( unsigned i = 0; i < N; i++ )
+				mValues[i] -= other.mValues[i];
+
+			return *this;
+		}
+
+		Vector & operator*=( const T & scale )
+		{
+			for( unsigned i = 0; i < N; i++ )
+				mValues[i] *= scale;
+
+			return *this;
+		}
+
+		Vector operator+( const Vector & other ) const { return Vector(*this) += other; }
+		Vector operator-( const Vector & other ) const { return Vector(*this) -= other; }
+		Vector operator*( const T & scale ) const { return Vector(*this) *= scale; }
+		Vector operator-() const { return Vector(*this) *= T(-1); }
+
+	private:
+		T mValues[N];	// The components
+	};
+
+	/**
+	 *  @return   The dot product of two vectors
+	 */
+	template <typename T, unsigned N>
+	T VectorDot( const OverRated::Vector<T, N> & first, const OverRated::Vector<T, N> & second )
+	{
+		T result(0);
+
+		for( unsigned i = 0; i < N; i++ )
+			result = result + first[i] * second[i];
+
+		return result;
+	}
+
+	/**
+	 *  @return   The straight line distance between two vectors
+	 */
+	template <typename T, unsigned N>
+	T VectorDist( const OverRated::Vector<T, N> & first, const OverRated::Vector<T, N> & second )
+	{
+		OverRated::Vector<T, N> offset( second - first );
+
+		return T(std::sqrt(OverRated::VectorDot(offset, offset)));
+	}
+
+	/**
+	 *  The angle of the rotation that takes one unit quaternion to another, in radians between
+	 *  0 and pi. A quaternion and its negative are the same rotation, so the angle is 0 for them.
+	 *
+	 *  @param first    The rotation to start from
+	 *  @param second   The rotation to end at
+	 *  @return         The angle between them
+	 */
+	template <typename T>
+	double QuaternionAngle( const OverRated::Vector<T, 4> & first,
+			const OverRated::Vector<T, 4> & second )
+	{
+		double dot = std::fabs(double(OverRated::VectorDot(first, second)));
+
+		return 2.0 * std::acos((dot < 1.0) ? dot : 1.0);
+	}
+
+	/**
+	 *  Spherical linear interpolation between two unit quaternions, along the shorter way round
+	 *  so that the rotation turns at a constant rate. The result is normalized.
+	 *
+	 *  @param first    The rotation at 0
+	 *  @param second   The rotation at 1
+	 *  @param amount   How far from first to second, between 0 and 1
+	 *  @return         The rotation in between
+	 */
+	template <typename T>
+	OverRated::Vector<T, 4> QuaternionSlerp( const OverRated::Vector<T, 4> & first,
+			const OverRated::Vector<T, 4> & second, double amount )
+	{
+		double dot = double(OverRated::VectorDot(first, second));
+		double sign = (dot < 0.0) ? -1.0 : 1.0;
+		double cosine = dot * sign;
+		double from = 1.0 - amount;
+		double to = amount;
+		double result[4];
+		double length = 0.0;
+		OverRated::Vector<T, 4> rotation;
+
+		// Too close for the angle to be worked out accurately; interpolating straight is as good
+		if( cosine < 0.9999 ) {
+			double angle = std::acos(cosine);
+			double sine = std::sin(angle);
+
+			from = std::sin(from * angle) / sine;
+			to = std::sin(to * angle) / sine;
+		}
+
+		for( unsigned i = 0; i < 4; i++ ) {
+			result[i] = from * double(first[i]) + to * sign * double(second[i]);
+			length += result[i] * result[i];
+		}
+
+		length = std::sqrt(length);
+
+		for( unsigned i = 0; i < 4; i++ )
+			rotation[i] = T(result[i] / length);
+
+		return rotation;
+	}
+}
+
+#endif // OVERRATED_VECTOR_H_DEFINED__
@@ -28,16 +28,42 @@
 #define OVERRATED_COMPLETE_INCLUDE_H__
 
 #include "OVRUtils.h"
+#include "OVRCounters.h"
+#include "OVRHandle.h"
+#include "OVRThreadPool.h"
+#include "OVRTracer.h"
+#include "OVRSnapshot.h"
 
 #include "OVRUpdatedObject.h"
 #include "OVRUpdatedObjectList.h"
+#include "OVRCommandQueue.h"
+#include "OVRUpdateSchedule.h"
+#include "OVRUpdatedClock.h"
 
 #include "OVRUpdatedValue.h"
 #include "OVRUpdatedValueBasic.h"
 #include "OVRUpdatedValueRef.h"
+#include "OVRUpdatedValueLazy.h"
+#include "OVRUpdatedValueTimeScale.h"
+#include "OVRUpdatedValuePool.h"
+#include "OVRUpdatedValueList.h"
+#include "OVRUpdateArena.h"
 
 #include "OVRUpdateMethod.h"
 #include "OVRUpdateMethodLinear.h"
 #include "OVRUpdateMethodLooped.h"
+#include "OVRUpdateMethodEased.h"
+#include "OVRUpdateMethodSpring.h"
+#include "OVRUpdateMethodVector.h"
+#include "OVRUpdateMethodSlerp.h"
+#include "OVRUpdateStep.h"
+#include "OVREase.h"
+#include "OVRVector.h"
+
+#include "OVRStaticUpdateMethod.h"
+#include "OVRStaticUpdatedValue.h"
+
+#include "OVRSimd.h"
+#include "OVRBatch.h"
 
 #endif // OVERRATED_COMPLETE_INCLUDE_H__
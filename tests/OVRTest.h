@@ -0,0 +1,60 @@
+/**
+ *	OverRated Tests: shared checking
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Each test is a plain program which returns 0 when every check passes, so that ctest can run
+ *	it without a test framework. Failed checks are printed with where they are.
+ */
+
+#ifndef OVERRATED_TEST_H_DEFINED__
+#define OVERRATED_TEST_H_DEFINED__
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Number of checks which have failed so far
+static int gFailures = 0;
+
+// State of testRandom(); tests set it to get a different but repeatable sequence
+static unsigned gSeed = 1;
+
+#define OVERRATED_CHECK(condition) \
+	do { \
+		if( !(condition) ) { \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			gFailures++; \
+		} \
+	} while( 0 )
+
+// Small deterministic generator, so that runs are the same everywhere
+inline unsigned testRandom( unsigned range )
+{
+	gSeed = gSeed * 1103515245u + 12345u;
+	return (gSeed >> 16) % range;
+}
+
+// True if both arrays hold exactly the same bits
+template <typename T>
+inline bool testSameBits( const std::vector<T> & a, const std::vector<T> & b )
+{
+	return a.size() == b.size() && (a.empty() || !memcmp(&a[0], &b[0], a.size() * sizeof(T)));
+}
+
+// Returns the exit code for main()
+inline int testResult( const char * name )
+{
+	if( gFailures )
+		fprintf(stderr, "%s: %d check(s) failed\n", name, gFailures);
+	else
+		printf("%s: passed\n", name);
+
+	return gFailures ? 1 : 0;
+}
+
+#endif
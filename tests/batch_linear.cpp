@@ -0,0 +1,72 @@
+/**
+ *	OverRated Tests: UpdateMethodLinear::updateBatch at each SimdLevel
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that the vectorized linear batch gives bit for bit the same results as the scalar
+ *	template and as updating each value with its own method, at every instruction set level.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+// An odd count, so every vector width leaves a remainder for the scalar loop
+static const unsigned COUNT = 37;
+static const unsigned TICKS = 40;
+static const double TICK = 1.0 / 60.0;
+
+template <typename T>
+static T randomValue( unsigned range, T divisor )
+{
+	return T(testRandom(range)) / divisor;
+}
+
+template <typename T>
+static void checkLinear()
+{
+	std::vector<T> values(COUNT), targets(COUNT), rates(COUNT);
+
+	for( unsigned i = 0; i < COUNT; i++ ) {
+		values[i] = randomValue<T>(1000, T(7));
+		targets[i] = (i % 5) ? randomValue<T>(1000, T(7)) : values[i];
+		rates[i] = T(1) + randomValue<T>(50, T(3));
+	}
+
+	std::vector<T> scalar = values, single = values;
+
+	for( unsigned tick = 0; tick < TICKS; tick++ ) {
+		UpdateMethodLinear<T>::updateBatch(&values[0], &targets[0], &rates[0], COUNT, TICK);
+		BatchLinearToValue<T>(&scalar[0], &targets[0], &rates[0], COUNT, TICK);
+
+		for( unsigned i = 0; i < COUNT; i++ ) {
+			UpdateMethodLinear<T> method(rates[i], targets[i]);
+			single[i] = method.updateValue(single[i], TICK);
+		}
+	}
+
+	OVERRATED_CHECK(testSameBits(values, scalar));
+	OVERRATED_CHECK(testSameBits(values, single));
+}
+
+int main()
+{
+	const SimdLevel levels[] = { SL_SCALAR, SL_SSE2, SL_AVX2, SL_AVX512 };
+
+	// Levels above what the processor supports fall back to the best it has
+	for( unsigned l = 0; l < sizeof(levels) / sizeof(levels[0]); l++ ) {
+		SimdSetLevel(levels[l]);
+		gSeed = l + 1;
+
+		checkLinear<float>();
+		checkLinear<double>();
+	}
+
+	return testResult("batch_linear");
+}
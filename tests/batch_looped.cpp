@@ -0,0 +1,83 @@
+/**
+ *	OverRated Tests: UpdateMethodLooped::updateBatch at each SimdLevel
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that the vectorized looped batches, shortest way, forced direction and constant
+ *	direction, give bit for bit the same results as the scalar templates at every instruction
+ *	set level.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+// An odd count, so every vector width leaves a remainder for the scalar loop
+static const unsigned COUNT = 37;
+static const unsigned TICKS = 40;
+static const double TICK = 1.0 / 60.0;
+
+template <typename T>
+static T randomValue( unsigned range, T divisor )
+{
+	return T(testRandom(range)) / divisor;
+}
+
+template <typename T>
+static void checkLooped()
+{
+	const T min = T(0), max = T(360);
+	std::vector<T> values(COUNT), targets(COUNT), rates(COUNT);
+
+	for( unsigned i = 0; i < COUNT; i++ ) {
+		values[i] = randomValue<T>(360, T(1));
+		targets[i] = (i % 5) ? randomValue<T>(360, T(1)) : values[i];
+		rates[i] = T(1) + randomValue<T>(500, T(3));
+	}
+
+	std::vector<T> shortest = values, forced = values, constant = values;
+	std::vector<T> shortestScalar = values, forcedScalar = values, constantScalar = values;
+
+	for( unsigned tick = 0; tick < TICKS; tick++ ) {
+		UpdateMethodLooped<T>::updateBatch(&shortest[0], &targets[0], &rates[0], COUNT, TICK,
+				min, max);
+		BatchLoopedToValue<T>(&shortestScalar[0], &targets[0], &rates[0], COUNT, TICK,
+				min, max);
+
+		UpdateMethodLooped<T>::updateBatch(&forced[0], &targets[0], &rates[0], COUNT, TICK,
+				CD_DECREASING, min, max);
+		BatchLoopedToValue<T>(&forcedScalar[0], &targets[0], &rates[0], COUNT, TICK,
+				CD_DECREASING, min, max);
+
+		UpdateMethodLooped<T>::updateBatch(&constant[0], &rates[0], COUNT, TICK,
+				CD_INCREASING, min, max);
+		BatchLoopedInDirection<T>(&constantScalar[0], &rates[0], COUNT, TICK,
+				CD_INCREASING, min, max);
+	}
+
+	OVERRATED_CHECK(testSameBits(shortest, shortestScalar));
+	OVERRATED_CHECK(testSameBits(forced, forcedScalar));
+	OVERRATED_CHECK(testSameBits(constant, constantScalar));
+}
+
+int main()
+{
+	const SimdLevel levels[] = { SL_SCALAR, SL_SSE2, SL_AVX2, SL_AVX512 };
+
+	// Levels above what the processor supports fall back to the best it has
+	for( unsigned l = 0; l < sizeof(levels) / sizeof(levels[0]); l++ ) {
+		SimdSetLevel(levels[l]);
+		gSeed = l + 1;
+
+		checkLooped<float>();
+		checkLooped<double>();
+	}
+
+	return testResult("batch_looped");
+}
@@ -0,0 +1,95 @@
+/**
+ *	OverRated Tests: UpdateMethodVector::updateBatch at each SimdLevel
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that the vectorized vector batch gives bit for bit the same results as the scalar
+ *	template and as updating each value with its own method, at every instruction set level.
+ */
+
+#include <string.h>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+// An odd count, so every vector width leaves a remainder for the scalar loop
+static const unsigned COUNT = 37;
+static const unsigned TICKS = 40;
+static const double TICK = 1.0 / 60.0;
+
+template <typename T>
+static T randomValue( unsigned range, T divisor )
+{
+	return T(testRandom(range)) / divisor;
+}
+
+template <typename T, unsigned N>
+static void checkVector()
+{
+	typedef Vector<T, N> V;
+
+	std::vector<T> values(N * COUNT), targets(N * COUNT), speeds(COUNT);
+
+	for( unsigned i = 0; i < N * COUNT; i++ ) {
+		values[i] = randomValue<T>(1000, T(7));
+		targets[i] = randomValue<T>(1000, T(7));
+	}
+
+	for( unsigned i = 0; i < COUNT; i++ ) {
+		speeds[i] = T(1) + randomValue<T>(50, T(3));
+
+		if( !(i % 5) ) {
+			for( unsigned c = 0; c < N; c++ )
+				targets[c * COUNT + i] = values[c * COUNT + i];
+		}
+	}
+
+	std::vector<T> scalar = values;
+	std::vector<V> single(COUNT), singleTargets(COUNT);
+
+	for( unsigned i = 0; i < COUNT; i++ ) {
+		for( unsigned c = 0; c < N; c++ ) {
+			single[i][c] = values[c * COUNT + i];
+			singleTargets[i][c] = targets[c * COUNT + i];
+		}
+	}
+
+	for( unsigned tick = 0; tick < TICKS; tick++ ) {
+		UpdateMethodVector<T, N>::updateBatch(&values[0], &targets[0], &speeds[0], COUNT, TICK);
+		BatchVectorToValue<T>(&scalar[0], &targets[0], &speeds[0], N, COUNT, TICK);
+
+		for( unsigned i = 0; i < COUNT; i++ ) {
+			UpdateMethodVector<T, N> method(speeds[i], singleTargets[i]);
+			single[i] = method.updateValue(single[i], TICK);
+		}
+	}
+
+	OVERRATED_CHECK(testSameBits(values, scalar));
+
+	for( unsigned i = 0; i < COUNT; i++ ) {
+		for( unsigned c = 0; c < N; c++ )
+			OVERRATED_CHECK(!memcmp(&single[i][c], &values[c * COUNT + i], sizeof(T)));
+	}
+}
+
+int main()
+{
+	const SimdLevel levels[] = { SL_SCALAR, SL_SSE2, SL_AVX2, SL_AVX512 };
+
+	// Levels above what the processor supports fall back to the best it has
+	for( unsigned l = 0; l < sizeof(levels) / sizeof(levels[0]); l++ ) {
+		SimdSetLevel(levels[l]);
+		gSeed = l + 1;
+
+		checkVector<float, 3>();
+		checkVector<double, 4>();
+	}
+
+	return testResult("batch_vector");
+}
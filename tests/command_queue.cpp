@@ -0,0 +1,191 @@
+/**
+ *	OverRated Tests: CommandQueue ordering and capacity
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that commands are carried out at the start of the list's next update in the order
+ *	they were queued, that a full queue refuses commands without losing any already queued,
+ *	that a rate change moves values still on their way and leaves finished ones alone, that
+ *	commands queued from several threads at once each arrive once and in each thread's own
+ *	order, and that lists beneath a list updated in parallel have their commands carried out
+ *	before the update, even when they were idle.
+ */
+
+#include <thread>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<float> Value;
+typedef UpdatedObjectList<UpdatedObject> List;
+
+static void checkOrder()
+{
+	CommandQueue<UpdatedObject> queue(3);
+	List list;
+	Value a(0.0f), b(0.0f), c(0.0f);
+	UpdateMethodLinear<float> method(1.0f, 5.0f);
+
+	// Rounded up to a power of two
+	OVERRATED_CHECK(queue.getCapacity() == 4);
+
+	list.setCommandQueue(&queue);
+	OVERRATED_CHECK(queue.add(&a) && queue.add(&b) && queue.remove(&a) && queue.add(&a));
+	OVERRATED_CHECK(!queue.add(&c));
+
+	// Nothing happens until the list is updated
+	OVERRATED_CHECK(list.getSize() == 0);
+	list.addTime(0.0);
+	OVERRATED_CHECK(list.getSize() == 2 && list.contains(&a) && list.contains(&b));
+
+	// Room again, and later commands see the effects of earlier ones
+	OVERRATED_CHECK(queue.setMethod<float>(&a, &method) && queue.setTargetValue<float>(&a, 2.0f));
+	OVERRATED_CHECK(queue.setIsPaused(&b, true) && queue.remove(&b));
+	list.addTime(10.0);
+	OVERRATED_CHECK(a.getValue() == 2.0f && method.getTargetValue() == 2.0f);
+	OVERRATED_CHECK(b.getIsPaused() && !list.contains(&b) && list.getSize() == 1);
+	OVERRATED_CHECK(queue.apply(list) == 0);
+}
+
+static void checkRate()
+{
+	CommandQueue<UpdatedObject> queue;
+	List list;
+	UpdateMethodLinear<float> method(1.0f, 10.0f), done(1.0f, 1.0f);
+	Value moving(0.0f), finished(0.0f);
+
+	moving.setMethod(&method);
+	finished.setMethod(&done);
+	list.add(&moving);
+	list.add(&finished);
+	list.setCommandQueue(&queue);
+	list.addTime(2.0);
+	OVERRATED_CHECK(moving.getValue() == 2.0f && finished.getIsFinished());
+
+	OVERRATED_CHECK(queue.setRate<float>(&method, 4.0f) && queue.setRate<float>(&done, 4.0f));
+	list.addTime(1.0);
+	OVERRATED_CHECK(moving.getValue() == 6.0f && finished.getValue() == 1.0f);
+}
+
+static void checkThreads()
+{
+	const int THREADS = 4;
+	const int PER_THREAD = 400;
+
+	CommandQueue<UpdatedObject> queue(64);
+	List list;
+	std::vector<Value*> values;
+	std::vector<UpdateMethodLinear<float>*> methods;
+	std::vector<std::thread> threads;
+
+	for( int i = 0; i < THREADS * PER_THREAD; i++ ) {
+		values.push_back(new Value(0.0f));
+		methods.push_back(new UpdateMethodLinear<float>(1.0f, 0.0f));
+	}
+
+	list.setCommandQueue(&queue);
+
+	// Each value is added, given a method and retargeted, which only works in that order
+	for( int t = 0; t < THREADS; t++ ) {
+		threads.push_back(std::thread([&, t]() {
+			for( int i = t * PER_THREAD; i < (t + 1) * PER_THREAD; i++ ) {
+				while( !queue.add(values[i]) )
+					std::this_thread::yield();
+
+				while( !queue.setMethod<float>(values[i], methods[i]) )
+					std::this_thread::yield();
+
+				while( !queue.retarget<float>(values[i], 1000.0f, float(i % 7)) )
+					std::this_thread::yield();
+			}
+		}));
+	}
+
+	// Applying while the threads are still queuing
+	while( list.getSize() < unsigned(THREADS * PER_THREAD) )
+		list.addTime(0.0);
+
+	for( int t = 0; t < THREADS; t++ )
+		threads[t].join();
+
+	list.addTime(1.0);
+	OVERRATED_CHECK(list.getSize() == unsigned(THREADS * PER_THREAD));
+
+	int wrong = 0;
+
+	for( int i = 0; i < THREADS * PER_THREAD; i++ ) {
+		if( values[i]->getValue() != float(i % 7) || values[i]->getMethod() != methods[i] )
+			wrong++;
+
+		delete values[i];
+		delete methods[i];
+	}
+
+	OVERRATED_CHECK(wrong == 0);
+}
+
+static void checkParallel()
+{
+	const int LISTS = 16;
+
+	ThreadPool pool(3);
+	List outer;
+	std::vector<List*> inner;
+	std::vector<CommandQueue<UpdatedObject>*> queues;
+	std::vector<Value*> values;
+	UpdateMethodLinear<float> method(1.0f, 100.0f);
+
+	outer.setParallel(&pool, 1, 1);
+
+	for( int l = 0; l < LISTS; l++ ) {
+		inner.push_back(new List());
+		queues.push_back(new CommandQueue<UpdatedObject>());
+		values.push_back(new Value(0.0f));
+		values[l]->setMethod(&method);
+		inner[l]->setCommandQueue(queues[l]);
+		outer.add(inner[l]);
+	}
+
+	// The inner lists are idle, so only the outer list can get their commands carried out
+	outer.addTime(1.0);
+	OVERRATED_CHECK(outer.getIsIdle());
+
+	for( int l = 0; l < LISTS; l++ )
+		OVERRATED_CHECK(queues[l]->add(values[l]));
+
+	outer.addTime(1.0);
+
+	for( int l = 0; l < LISTS; l++ ) {
+		OVERRATED_CHECK(inner[l]->getSize() == 1 && values[l]->getValue() == 1.0f);
+
+		// Detaching the queue takes the list out of those the outer list applies
+		inner[l]->setCommandQueue(0);
+		OVERRATED_CHECK(queues[l]->add(values[l]));
+	}
+
+	outer.addTime(1.0);
+
+	for( int l = 0; l < LISTS; l++ ) {
+		OVERRATED_CHECK(queues[l]->apply(*inner[l]) == 1);
+		OVERRATED_CHECK(values[l]->getValue() == 2.0f);
+		delete values[l];
+		delete inner[l];
+		delete queues[l];
+	}
+}
+
+int main()
+{
+	checkOrder();
+	checkRate();
+	checkThreads();
+	checkParallel();
+
+	return testResult("command_queue");
+}
@@ -0,0 +1,194 @@
+/**
+ *	OverRated Tests: completion callbacks under retargets and pauses
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that UpdatedObjectList::addCompletion() calls back in exactly the update where
+ *	polling getIsFinished() would first see each value finish, while values are retargeted,
+ *	given new methods, paused, unpaused and removed along the way.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValue<float> Value;
+typedef UpdatedObjectList<Value> List;
+
+static const int COUNT = 2000;
+static const int TICKS = 3000;
+
+// Never fired, or removed from the list before it could be
+static const int NOT_FIRED = -1;
+static const int REMOVED = -2;
+
+static int gTick = 0;
+static std::vector<int> gFiredAt;
+static void onFinished( Value * value, void * userData )
+{
+	int index = int(reinterpret_cast<size_t>(userData));
+
+	OVERRATED_CHECK(gFiredAt[index] == NOT_FIRED);
+	gFiredAt[index] = gTick;
+}
+
+static void checkAgainstPolling()
+{
+	List list;
+	std::vector<UpdatedValueBasic<float>*> values(COUNT);
+	std::vector<UpdateMethod<float>*> methods(COUNT);
+	std::vector<int> polledAt(COUNT, NOT_FIRED);
+	std::vector<bool> wasFinished(COUNT);
+	UpdateMethodLinear<float> retarget(5.0f, 50.0f);
+
+	gSeed = 3;
+	gFiredAt.assign(COUNT, NOT_FIRED);
+	list.reserveCompletions(COUNT);
+
+	for( int i = 0; i < COUNT; i++ ) {
+		float rate = float(1 + testRandom(50)) / 3.0f;
+
+		values[i] = new UpdatedValueBasic<float>(float(testRandom(1000)) / 7.0f);
+
+		if( i % 3 == 0 )
+			methods[i] = new UpdateMethodLooped<float>(rate, float(testRandom(360)), 0.0f, 360.0f);
+		else
+			methods[i] = new UpdateMethodLinear<float>(rate, float(testRandom(1000)) / 7.0f);
+
+		values[i]->setMethod(methods[i]);
+		list.add(values[i]);
+		list.addCompletion(values[i], onFinished, reinterpret_cast<void*>(size_t(i)));
+		wasFinished[i] = values[i]->getIsFinished();
+	}
+
+	for( gTick = 0; gTick < TICKS; gTick++ ) {
+		if( gTick == 100 ) {
+			for( int i = 0; i < COUNT; i += 11 ) {
+				if( gFiredAt[i] == NOT_FIRED )
+					values[i]->setMethod(&retarget);
+			}
+		}
+		else if( gTick == 150 ) {
+			for( int i = 4; i < COUNT; i += 11 ) {
+				if( gFiredAt[i] == NOT_FIRED && i % 3 )
+					values[i]->setTargetValue(values[i]->getValue() + 20.0f);
+			}
+		}
+		else if( gTick == 200 ) {
+			for( int i = 1; i < COUNT; i += 13 )
+				values[i]->setIsPaused(true);
+		}
+		else if( gTick == 300 ) {
+			for( int i = 2; i < COUNT; i += 17 ) {
+				if( gFiredAt[i] == NOT_FIRED ) {
+					list.remove(values[i]);
+					gFiredAt[i] = REMOVED;
+				}
+			}
+		}
+		else if( gTick == 500 ) {
+			for( int i = 1; i < COUNT; i += 13 )
+				values[i]->setIsPaused(false);
+		}
+
+		list.addTime((gTick % 7) ? 1.0 / 60.0 : 0.05);
+
+		for( int i = 0; i < COUNT; i++ ) {
+			bool isFinished = values[i]->getIsFinished();
+
+			if( isFinished && !wasFinished[i] && polledAt[i] == NOT_FIRED )
+				polledAt[i] = gTick;
+
+			wasFinished[i] = isFinished;
+		}
+	}
+
+	int mismatches = 0;
+
+	for( int i = 0; i < COUNT; i++ ) {
+		if( gFiredAt[i] == REMOVED )
+			continue;
+
+		// Values which start out finished are reported on the first update
+		int expected = polledAt[i];
+
+		if( expected == NOT_FIRED && values[i]->getIsFinished() )
+			expected = 0;
+
+		if( gFiredAt[i] != expected )
+			mismatches++;
+	}
+
+	OVERRATED_CHECK(mismatches == 0);
+
+	list.clear();
+
+	for( int i = 0; i < COUNT; i++ ) {
+		delete values[i];
+		delete methods[i];
+	}
+}
+
+// Ticks by a quarter second, which adds up exactly, until the value's callback is made
+static int ticksToFire( List & list, UpdatedValueBasic<float> & value, int retargetAt,
+		float retargetTo, int pauseAt, int unpauseAt )
+{
+	gFiredAt.assign(1, NOT_FIRED);
+	list.add(&value);
+	list.addCompletion(&value, onFinished, 0);
+
+	for( gTick = 1; gTick <= 200 && gFiredAt[0] == NOT_FIRED; gTick++ ) {
+		if( gTick == retargetAt )
+			value.setTargetValue(retargetTo);
+
+		if( gTick == pauseAt )
+			value.setIsPaused(true);
+
+		if( gTick == unpauseAt )
+			value.setIsPaused(false);
+
+		list.addTime(0.25);
+	}
+
+	list.remove(&value);
+	return gFiredAt[0];
+}
+
+static void checkExactTimes()
+{
+	List list;
+	UpdateMethodLinear<float> method(1.0f, 10.0f);
+	UpdatedValueBasic<float> value(0.0f);
+
+	value.setMethod(&method);
+
+	// Ten seconds to go at one per second
+	OVERRATED_CHECK(ticksToFire(list, value, 0, 0.0f, 0, 0) == 40);
+
+	// Brought closer after two seconds, then sent further after two seconds
+	value.setValue(0.0f);
+	method.setTargetValue(10.0f);
+	OVERRATED_CHECK(ticksToFire(list, value, 9, 5.0f, 0, 0) == 20);
+	value.setValue(0.0f);
+	method.setTargetValue(10.0f);
+	OVERRATED_CHECK(ticksToFire(list, value, 9, 20.0f, 0, 0) == 80);
+
+	// Paused for three seconds on the way
+	value.setValue(0.0f);
+	method.setTargetValue(10.0f);
+	OVERRATED_CHECK(ticksToFire(list, value, 0, 0.0f, 9, 21) == 52);
+}
+
+int main()
+{
+	checkAgainstPolling();
+	checkExactTimes();
+
+	return testResult("completion_timing");
+}
@@ -0,0 +1,126 @@
+/**
+ *	OverRated Tests: UpdateMethodEased against its closed form
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that an eased value stepped with uneven time lands where evaluateAt() and the curve
+ *	formula say, that timeToFinish() counts down the transition, that a curve coming close to
+ *	its target only finishes at the end, and that updateBatch() follows the same curves.
+ */
+
+#include <cmath>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static const double DURATION = 1.5;
+static const double START = -4.0;
+static const double TARGET = 20.0;
+
+static bool near( double a, double b )
+{
+	return std::fabs(a - b) <= 1e-9;
+}
+
+static void checkCurve( EaseCurve curve, EaseMode mode )
+{
+	UpdateMethodEased<double> method(curve, DURATION, TARGET, mode);
+	UpdateMethodEased<double> reference(curve, DURATION, TARGET, mode);
+	double value = START, elapsed = 0.0;
+
+	OVERRATED_CHECK(near(method.timeToFinish(START), DURATION));
+
+	while( elapsed < 1.2 ) {
+		double step = double(1 + testRandom(40)) / 1000.0;
+
+		value = method.updateValue(value, step);
+		elapsed += step;
+	}
+
+	double progress = elapsed / DURATION;
+
+	OVERRATED_CHECK(near(value, reference.evaluateAt(START, elapsed)));
+	OVERRATED_CHECK(near(value, START + (TARGET - START) * EaseValue(curve, progress, mode)));
+	OVERRATED_CHECK(near(method.timeToFinish(value), DURATION - elapsed));
+
+	// Running out the rest of the transition lands on the target exactly
+	value = method.updateValue(value, DURATION - elapsed + 0.01);
+	OVERRATED_CHECK(value == TARGET && method.getIsFinished(value));
+	OVERRATED_CHECK(reference.evaluateAt(START, DURATION) == TARGET);
+}
+
+static void checkFinishing()
+{
+	// Bounce out comes close to its target in the first half, and bounces away again
+	UpdateMethodEased<double> method(EC_BOUNCE_OUT, 1.0, TARGET, EM_EXACT);
+	UpdatedValueBasic<double> value(START);
+	int close = 0, ticks = 0;
+
+	value.setMethod(&method);
+
+	while( value.getIsUpdating() && ticks < 4096 ) {
+		value.addTime(1.0 / 2048.0);
+		ticks++;
+
+		if( std::fabs(value.getValue() - TARGET) < 0.1 && ticks < 1024 )
+			close++;
+	}
+
+	OVERRATED_CHECK(close > 0);
+	OVERRATED_CHECK(ticks == 2048 && value.getValue() == TARGET);
+}
+
+// Float progress drifts from the method's double progress, so only double is compared closely
+template <typename T>
+static void checkBatch( EaseCurve curve, EaseMode mode, double tolerance )
+{
+	const unsigned count = 37;
+	std::vector<T> values(count), starts(count), targets(count), progress(count), rates(count);
+	std::vector<UpdateMethodEased<T>*> methods(count);
+	std::vector<T> single(count);
+
+	for( unsigned i = 0; i < count; i++ ) {
+		starts[i] = values[i] = single[i] = T(testRandom(200)) / T(4);
+		targets[i] = T(testRandom(200)) / T(4);
+		rates[i] = T(1) / T(1 + testRandom(3));
+		progress[i] = T(0);
+		methods[i] = new UpdateMethodEased<T>(curve, 1.0 / double(rates[i]), targets[i], mode);
+	}
+
+	for( int tick = 0; tick < 240; tick++ ) {
+		UpdateMethodEased<T>::updateBatch(&values[0], &starts[0], &targets[0], &progress[0],
+				&rates[0], count, 1.0 / 60.0, curve, mode);
+
+		for( unsigned i = 0; i < count; i++ ) {
+			single[i] = methods[i]->updateValue(single[i], 1.0 / 60.0);
+			OVERRATED_CHECK(std::fabs(double(values[i] - single[i])) <= tolerance);
+		}
+	}
+
+	for( unsigned i = 0; i < count; i++ ) {
+		OVERRATED_CHECK(values[i] == targets[i] && single[i] == targets[i]);
+		delete methods[i];
+	}
+}
+
+int main()
+{
+	for( int curve = 0; curve < EC_COUNT; curve++ ) {
+		checkCurve(EaseCurve(curve), EM_EXACT);
+		checkCurve(EaseCurve(curve), EM_TABLE);
+		checkBatch<double>(EaseCurve(curve), EM_EXACT, 1e-9);
+		checkBatch<double>(EaseCurve(curve), EM_TABLE, 1e-7);
+		checkBatch<float>(EaseCurve(curve), EM_EXACT, 0.05);
+		checkBatch<float>(EaseCurve(curve), EM_TABLE, 0.05);
+	}
+
+	checkFinishing();
+
+	return testResult("eased_closed_form");
+}
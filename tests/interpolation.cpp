@@ -0,0 +1,86 @@
+/**
+ *	OverRated Tests: interpolating between fixed steps
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that getInterpolatedValue() carries on along the transition in progress for methods
+ *	which keep one, eased and spring, rather than starting a new one from the stepped value,
+ *	and that a value sharing such a method without being the one it last moved starts afresh.
+ */
+
+#include <cmath>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<double> Value;
+
+static bool near( double a, double b )
+{
+	return std::fabs(a - b) <= 1e-9;
+}
+
+int main()
+{
+	// Quad in over 1 second from 0 to 100, stepped at 0.1: 0.55 seconds in is 100 * 0.55^2
+	UpdateMethodEased<double> eased(EC_QUAD_IN, 1.0, 100.0, EM_EXACT);
+	Value easedValue(0.0);
+
+	easedValue.setMethod(&eased);
+	easedValue.setFixedStep(0.1);
+	easedValue.addTime(0.55);
+	OVERRATED_CHECK(near(easedValue.getValue(), 25.0));
+	OVERRATED_CHECK(near(easedValue.getInterpolatedValue(), 30.25));
+	OVERRATED_CHECK(near(easedValue.getValueAhead(0.25), 56.25));
+	OVERRATED_CHECK(easedValue.getValueAhead(2.0) == 100.0);
+
+	// Looking ahead changes nothing
+	easedValue.addTime(0.05);
+	OVERRATED_CHECK(near(easedValue.getValue(), 36.0));
+
+	// The same through a list with the fixed step
+	UpdateMethodEased<double> listEased(EC_QUAD_IN, 1.0, 100.0, EM_EXACT);
+	UpdatedObjectList<Value> list;
+	Value listValue(0.0);
+
+	listValue.setMethod(&listEased);
+	list.add(&listValue);
+	list.setFixedStep(0.1);
+	list.addTime(0.55);
+	OVERRATED_CHECK(near(listValue.getValue(), 25.0));
+	OVERRATED_CHECK(near(listValue.getValueAhead(list.getPendingTime()), 30.25));
+	list.clear();
+
+	// Once the shared method has moved another value, this one starts a transition of its own
+	Value other(50.0);
+
+	OVERRATED_CHECK(near(easedValue.getValueAhead(0.1), 49.0));
+	other.setMethod(&eased);
+	OVERRATED_CHECK(near(other.getValueAhead(0.5), 50.0 + 50.0 * 0.25));
+	OVERRATED_CHECK(near(easedValue.getValueAhead(0.1), 36.0 + 64.0 * 0.01));
+
+	// An underdamped spring stepped at 0.1 interpolates onto its closed form
+	UpdateMethodSpring<double> spring(100.0, 4.0, 10.0, 1e-9), reference(100.0, 4.0, 10.0, 1e-9);
+	Value springValue(0.0);
+
+	springValue.setMethod(&spring);
+	springValue.setFixedStep(0.1);
+	springValue.addTime(0.55);
+	OVERRATED_CHECK(near(springValue.getValue(), reference.evaluateAt(0.0, 0.5)));
+	OVERRATED_CHECK(near(springValue.getInterpolatedValue(), reference.evaluateAt(0.0, 0.55)));
+	OVERRATED_CHECK(!near(springValue.getInterpolatedValue(),
+			reference.evaluateAt(springValue.getValue(), 0.05)));
+
+	// Another value on the spring starts from rest, as its next update would
+	Value resting(2.0);
+
+	resting.setMethod(&spring);
+	OVERRATED_CHECK(near(resting.getValueAhead(0.3), reference.evaluateAt(2.0, 0.3)));
+
+	return testResult("interpolation");
+}
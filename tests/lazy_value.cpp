@@ -0,0 +1,123 @@
+/**
+ *	OverRated Tests: UpdatedValueLazy against UpdatedValueBasic
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Reads lazy values off a shared clock alongside stepped values with the same methods, and
+ *	checks that they agree through changes of method and value, that a lazy value is never
+ *	updated by the list it's in, that rebase() keeps the path so far when the method changes,
+ *	and that pausing the clock holds every value reading it.
+ */
+
+#include <cmath>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static const int COUNT = 50;
+
+static bool near( double a, double b )
+{
+	return std::fabs(a - b) <= 1e-9;
+}
+
+static void checkEquivalence()
+{
+	UpdatedClock clock;
+	UpdatedObjectList<UpdatedObject> root;
+	UpdatedObjectList<UpdatedValue<double> > values;
+	std::vector<UpdatedValueLazy<double>*> lazy;
+	std::vector<UpdatedValueBasic<double>*> stepped;
+	UpdateMethodLinear<double> linear(2.0, 10.0), back(1.0, 0.0);
+	UpdateMethodLooped<double> looped(7.0, CD_INCREASING, 0.0, 10.0);
+	UpdateMethod<double> * methods[] = { &linear, &back, &looped };
+	int mismatches = 0;
+
+	root.add(&clock);
+	root.add(&values);
+
+	for( int i = 0; i < COUNT; i++ ) {
+		double start = double(testRandom(100)) / 10.0;
+
+		lazy.push_back(new UpdatedValueLazy<double>(clock, start));
+		stepped.push_back(new UpdatedValueBasic<double>(start));
+		lazy[i]->setMethod(methods[i % 3]);
+		stepped[i]->setMethod(methods[i % 3]);
+		values.add(lazy[i]);
+		values.add(stepped[i]);
+	}
+
+	for( int tick = 0; tick < 100; tick++ ) {
+		root.addTime(double(1 + testRandom(100)) / 1000.0);
+
+		// Only the stepped values are ever updated
+		OVERRATED_CHECK(values.getActiveCount() <= unsigned(COUNT));
+
+		int i = testRandom(COUNT);
+
+		if( tick % 7 == 0 ) {
+			lazy[i]->setMethod(methods[tick % 3]);
+			stepped[i]->setMethod(methods[tick % 3]);
+		}
+		else if( tick % 11 == 0 ) {
+			lazy[i]->setValue(5.0);
+			stepped[i]->setValue(5.0);
+		}
+
+		for( int v = 0; v < COUNT; v++ ) {
+			if( !near(lazy[v]->getValue(), stepped[v]->getValue()) )
+				mismatches++;
+		}
+	}
+
+	OVERRATED_CHECK(mismatches == 0);
+
+	// Pausing the clock holds every lazy value
+	double held = lazy[2]->getValue();
+
+	clock.setIsPaused(true);
+	root.addTime(5.0);
+	OVERRATED_CHECK(lazy[2]->getValue() == held);
+
+	for( int i = 0; i < COUNT; i++ ) {
+		delete lazy[i];
+		delete stepped[i];
+	}
+}
+
+static void checkRebase()
+{
+	UpdatedClock clock;
+	UpdateMethodLinear<double> method(1.0, 10.0);
+	UpdatedValueLazy<double> value(clock, 0.0), kept(clock, 0.0);
+
+	value.setMethod(&method);
+	kept.setMethod(&method);
+	OVERRATED_CHECK(value.getIsIdle() && &value.getClock() == &clock);
+
+	clock.addTime(2.0);
+	OVERRATED_CHECK(value.getValue() == 2.0);
+
+	// A faster rate changes the whole path, unless the value rebases first
+	kept.rebase();
+	method.setRate(3.0);
+	OVERRATED_CHECK(value.getValue() == 6.0 && kept.getValue() == 2.0);
+	clock.addTime(1.0);
+	OVERRATED_CHECK(value.getValue() == 9.0 && kept.getValue() == 5.0);
+	clock.addTime(10.0);
+	OVERRATED_CHECK(value.getValue() == 10.0 && kept.getValue() == 10.0);
+}
+
+int main()
+{
+	checkEquivalence();
+	checkRebase();
+
+	return testResult("lazy_value");
+}
@@ -0,0 +1,98 @@
+/**
+ *	OverRated Tests: UpdateMethodLinear and UpdateMethodLooped against their closed forms
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that linear and looped values stepped with many small steps land where evaluateAt()
+ *	says, from starts inside and outside the range and over any number of laps, that
+ *	evaluateAt() at timeToFinish() is the target, that directional targets and no rate never
+ *	finish, and that UpdatedValue asks its method the same.
+ */
+
+#include <cmath>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static bool near( double a, double b )
+{
+	return std::fabs(a - b) <= 1e-6;
+}
+
+template <typename M>
+static void checkSteps( M & method, double start, double time )
+{
+	const int steps = 1000;
+	double value = start;
+
+	for( int i = 0; i < steps && !method.getIsFinished(value); i++ )
+		value = method.updateValue(value, time / steps);
+
+	OVERRATED_CHECK(method.getIsPredictable());
+	OVERRATED_CHECK(near(value, method.evaluateAt(start, time)));
+}
+
+template <typename M>
+static void checkFinish( M & method, double start, double expected )
+{
+	double time = method.timeToFinish(start);
+
+	OVERRATED_CHECK(near(time, expected));
+	OVERRATED_CHECK(method.evaluateAt(start, time) == method.getTargetValue());
+	OVERRATED_CHECK(method.getIsFinished(method.evaluateAt(start, time + 1.0)));
+}
+
+int main()
+{
+	// Looped starts go past the top of the range, and times up to several laps
+	for( int i = 0; i < 40; i++ ) {
+		double start = double(testRandom(1200)) / 100.0 - 1.0;
+		double time = double(1 + testRandom(900)) / 100.0;
+
+		UpdateMethodLinear<double> linear(2.0, 5.0);
+		UpdateMethodLinear<double> linearDir(2.0, CD_DECREASING);
+		UpdateMethodLooped<double> looped(3.0, 7.0, 0.0, 10.0);
+		UpdateMethodLooped<double> loopedDown(3.0, 7.0, CD_DECREASING, 0.0, 10.0);
+		UpdateMethodLooped<double> loopedDir(3.0, CD_INCREASING, 0.0, 10.0);
+
+		checkSteps(linear, start, time);
+		checkSteps(linearDir, start, time);
+		checkSteps(looped, start, time);
+		checkSteps(loopedDown, start, time);
+		checkSteps(loopedDir, start, time);
+	}
+
+	UpdateMethodLinear<double> linear(2.0, 5.0);
+	UpdateMethodLooped<double> looped(2.0, 1.0, 0.0, 10.0);
+	UpdateMethodLooped<double> loopedDown(2.0, 1.0, CD_DECREASING, 0.0, 10.0);
+
+	checkFinish(linear, 1.0, 2.0);
+	checkFinish(linear, 9.0, 2.0);
+	checkFinish(looped, 9.0, 1.0);				// Up through the top of the range
+	checkFinish(loopedDown, 9.0, 4.0);
+	OVERRATED_CHECK(linear.timeToFinish(5.0) == 0.0);
+
+	// Neither a direction nor no rate ever gets there
+	UpdateMethodLinear<double> directional(2.0, CD_INCREASING);
+	UpdateMethodLinear<double> still(0.0, 5.0);
+
+	OVERRATED_CHECK(directional.timeToFinish(1.0) < 0.0 && still.timeToFinish(1.0) < 0.0);
+
+	// A value asks its method, and looks ahead the same way
+	UpdatedValueBasic<double> value(9.0);
+
+	value.setMethod(&looped);
+	OVERRATED_CHECK(near(value.getTimeToFinish(), 1.0));
+	OVERRATED_CHECK(near(value.getValueAhead(0.25), 9.5));
+	value.addTime(0.5);
+	OVERRATED_CHECK(near(value.getTimeToFinish(), 0.5));
+	value.setMethod(&directional);
+	OVERRATED_CHECK(value.getTimeToFinish() < 0.0);
+
+	return testResult("linear_closed_form");
+}
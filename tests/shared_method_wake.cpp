@@ -0,0 +1,172 @@
+/**
+ *	OverRated Tests: retargeting a method shared by many values
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Values which have finished sleep in their lists. Retargeting a method, whether through one
+ *	of its values or on the method itself, has to wake every value using it, in any kind of
+ *	list, values have to let go of a method that is destroyed before them, and assigning one
+ *	value to another has to wake it.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<float> Value;
+typedef UpdatedObjectList< UpdatedValue<float> > List;
+
+static void runFor( List & list, int seconds )
+{
+	for( int i = 0; i < seconds; i++ )
+		list.addTime(1.0);
+}
+
+static void checkWakes()
+{
+	UpdateMethodLinear<float> method(1.0f, 0.0f);
+	Value a(0.0f), b(0.0f), c(2.0f);
+	List list;
+	UpdatedValueList<Value> valueList;
+
+	a.setMethod(&method);
+	b.setMethod(&method);
+	list.add(&a);
+	list.add(&b);
+	list.addTime(1.0);
+	OVERRATED_CHECK(list.getIsIdle());
+
+	// Through one of the values
+	a.setTargetValue(5.0f);
+	runFor(list, 10);
+	OVERRATED_CHECK(a.getValue() == 5.0f && b.getValue() == 5.0f);
+
+	// On the method itself
+	method.setTargetValue(2.0f);
+	OVERRATED_CHECK(!list.getIsIdle());
+	runFor(list, 10);
+	OVERRATED_CHECK(a.getValue() == 2.0f && b.getValue() == 2.0f);
+
+	// Across both kinds of list
+	c.setMethod(&method);
+	valueList.add(&c);
+	valueList.addTime(1.0);
+	method.setTargetValue(4.0f);
+
+	for( int i = 0; i < 10; i++ ) {
+		valueList.addTime(1.0);
+		list.addTime(1.0);
+	}
+
+	OVERRATED_CHECK(c.getValue() == 4.0f && a.getValue() == 4.0f);
+}
+
+static void checkRemovedUsers()
+{
+	UpdateMethodLinear<float> method(1.0f, 10.0f);
+	std::vector<Value*> values;
+	List list;
+
+	for( int i = 0; i < 50; i++ ) {
+		values.push_back(new Value(10.0f));
+		values.back()->setMethod(&method);
+		list.add(values.back());
+	}
+
+	// Removing users from the middle must keep the rest registered
+	for( int i = 0; i < 50; i += 3 ) {
+		delete values[i];
+		values[i] = 0;
+	}
+
+	list.addTime(1.0);
+	OVERRATED_CHECK(list.getIsIdle());
+
+	method.setTargetValue(0.0f);
+	OVERRATED_CHECK(!list.getIsIdle());
+
+	for( size_t i = 0; i < values.size(); i++ )
+		delete values[i];
+}
+
+static void checkMethodDestroyedFirst()
+{
+	Value value(0.0f);
+	std::vector<Value> copies;
+
+	{
+		UpdateMethodLinear<float> method(1.0f, 3.0f);
+
+		value.setMethod(&method);
+		copies.assign(100, value);
+		copies.erase(copies.begin() + 5);
+
+		Value assigned(0.0f);
+		assigned = copies[3];
+
+		// Copying a method doesn't take its values with it
+		UpdateMethodLinear<float> copy(method);
+		UpdateMethodLinear<float> other(1.0f, 9.0f);
+		other = method;
+		OVERRATED_CHECK(method.getTargetValue() == 3.0f);
+	}
+
+	OVERRATED_CHECK(!value.getMethod() && !copies[50].getMethod());
+	value.addTime(1.0);
+}
+
+static void checkAssignmentWakes()
+{
+	UpdateMethodLinear<float> method(5.0f, 10.0f);
+	Value x(10.0f), y(0.0f);
+	List list;
+
+	x.setMethod(&method);
+	y.setMethod(&method);
+	list.add(&x);
+	list.addTime(1.0);
+	OVERRATED_CHECK(list.getIsIdle());
+
+	// The copied value is a long way from the target again
+	x = y;
+	OVERRATED_CHECK(!list.getIsIdle());
+	list.addTime(1.0);
+	OVERRATED_CHECK(x.getValue() == 5.0f && list.getActiveCount() == 1);
+
+	list.addTime(1.0);
+	list.addTime(0.0);
+	OVERRATED_CHECK(x.getValue() == 10.0f && list.getIsIdle());
+}
+
+static void checkLoopedOverride()
+{
+	// Heading for a direction drops the override, as StaticMethodLooped does
+	UpdateMethodLooped<float> method(1.0f, 5.0f, CD_DECREASING, 0.0f, 10.0f);
+
+	method.setTargetDirection(CD_INCREASING);
+	OVERRATED_CHECK(!method.getIsOverrideEnabled());
+
+	method.setTargetValue(6.0f);
+
+	Value value(4.0f);
+	value.setMethod(&method);
+	value.addTime(1.0);
+	OVERRATED_CHECK(value.getValue() == 5.0f);
+}
+
+int main()
+{
+	checkWakes();
+	checkRemovedUsers();
+	checkMethodDestroyedFirst();
+	checkAssignmentWakes();
+	checkLoopedOverride();
+
+	return testResult("shared_method_wake");
+}
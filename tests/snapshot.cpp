@@ -0,0 +1,127 @@
+/**
+ *	OverRated Tests: Snapshot frames read while being published
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Publishes frames as fast as possible while several threads read them, each frame's values
+ *	and size worked out from its number, and checks that every read is one whole frame and
+ *	that frames never go backwards for a reader. Then checks frames published from a source,
+ *	from a pool, of vectors, and read into too little room.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static const unsigned COUNT = 300;
+static const unsigned long long FRAMES = 20000;
+static const int READERS = 3;
+
+// Odd frames are a value short, so a read mixing two frames has the wrong size or values
+static unsigned frameSize( unsigned long long frame )
+{
+	return COUNT - unsigned(frame % 2);
+}
+
+static double frameValue( unsigned long long frame, unsigned index )
+{
+	return double(frame) + index * 0.5;
+}
+
+static void checkThreads()
+{
+	Snapshot<double> snapshot(COUNT);
+	std::atomic<bool> done(false);
+	std::atomic<int> torn(0), backwards(0);
+	std::vector<std::thread> readers;
+
+	OVERRATED_CHECK(snapshot.getCapacity() == COUNT && snapshot.getFrame() == 0);
+
+	for( int r = 0; r < READERS; r++ ) {
+		readers.push_back(std::thread([&]() {
+			std::vector<double> values(COUNT);
+			unsigned long long last = 0;
+
+			while( !done.load() ) {
+				unsigned long long frame;
+				unsigned count = snapshot.read(&values[0], COUNT, &frame);
+
+				if( frame < last )
+					backwards++;
+
+				last = frame;
+
+				if( frame == 0 ? count != 0 : count != frameSize(frame) ) {
+					torn++;
+					continue;
+				}
+
+				for( unsigned i = 0; i < count; i++ ) {
+					if( values[i] != frameValue(frame, i) ) {
+						torn++;
+						break;
+					}
+				}
+			}
+		}));
+	}
+
+	std::vector<double> values(COUNT);
+
+	for( unsigned long long frame = 1; frame <= FRAMES; frame++ ) {
+		for( unsigned i = 0; i < COUNT; i++ )
+			values[i] = frameValue(frame, i);
+
+		snapshot.publish(&values[0], frameSize(frame));
+	}
+
+	done = true;
+
+	for( int r = 0; r < READERS; r++ )
+		readers[r].join();
+
+	OVERRATED_CHECK(torn == 0 && backwards == 0);
+	OVERRATED_CHECK(snapshot.getFrame() == FRAMES);
+}
+
+static void checkSources()
+{
+	// From a pool
+	UpdatedValuePool<float> pool;
+	Snapshot<float> floats(8);
+	float out[8];
+
+	pool.add(1.0f);
+	pool.add(2.0f);
+	pool.publish(floats);
+	OVERRATED_CHECK(floats.read(out, 8) == 2 && out[0] == 1.0f && out[1] == 2.0f);
+
+	// Too little room takes the start of the frame
+	out[1] = 0.0f;
+	OVERRATED_CHECK(floats.read(out, 1) == 1 && out[0] == 1.0f && out[1] == 0.0f);
+
+	// Vectors, asked for one at a time
+	Snapshot<Vector<float,3> > vectors(4);
+	Vector<float,3> vectorsOut[4];
+	unsigned long long frame = 0;
+
+	vectors.publish(3, []( unsigned i ) { return Vector<float,3>(float(i), 1.0f, 2.0f); });
+	OVERRATED_CHECK(vectors.read(vectorsOut, 4, &frame) == 3 && frame == 1);
+	OVERRATED_CHECK(vectorsOut[2][0] == 2.0f && vectorsOut[2][2] == 2.0f);
+}
+
+int main()
+{
+	checkThreads();
+	checkSources();
+
+	return testResult("snapshot");
+}
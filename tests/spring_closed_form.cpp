@@ -0,0 +1,156 @@
+/**
+ *	OverRated Tests: UpdateMethodSpring against a numerical integration
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks the closed form steps of under, critically, over and undamped springs against a fine
+ *	Runge-Kutta integration, that stepping with any split of the time gives what evaluateAt()
+ *	says, that updateBatch() gives bit for bit what the method does, that retargeting keeps
+ *	the velocity, and that a spring comes to rest on its target without claiming to know when.
+ */
+
+#include <cmath>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static const double STIFFNESS = 100.0;
+static const double TARGET = 5.0;
+
+/**
+ *  Where a spring starting still at offset from its target is after some time, integrated
+ *  in many small steps
+ */
+static double integrate( double damping, double offset, double time )
+{
+	const int steps = 200000;
+	double h = time / steps, y = offset, v = 0.0;
+
+	for( int i = 0; i < steps; i++ ) {
+		double a1 = v, b1 = -STIFFNESS * y - damping * v;
+		double a2 = v + h / 2 * b1, b2 = -STIFFNESS * (y + h / 2 * a1) - damping * (v + h / 2 * b1);
+		double a3 = v + h / 2 * b2, b3 = -STIFFNESS * (y + h / 2 * a2) - damping * (v + h / 2 * b2);
+		double a4 = v + h * b3, b4 = -STIFFNESS * (y + h * a3) - damping * (v + h * b3);
+
+		y += h / 6 * (a1 + 2 * a2 + 2 * a3 + a4);
+		v += h / 6 * (b1 + 2 * b2 + 2 * b3 + b4);
+	}
+
+	return y;
+}
+
+static void checkDamping( double damping )
+{
+	UpdateMethodSpring<double> method(STIFFNESS, damping, TARGET, 1e-12);
+	UpdateMethodSpring<double> reference(STIFFNESS, damping, TARGET, 1e-12);
+	double value = 0.0, elapsed = 0.0;
+
+	for( int i = 0; i < 37; i++ ) {
+		double step = double(1 + testRandom(30)) / 1000.0;
+
+		value = method.updateValue(value, step);
+		elapsed += step;
+	}
+
+	OVERRATED_CHECK(std::fabs(value - (TARGET + integrate(damping, -TARGET, elapsed))) <= 1e-7);
+	OVERRATED_CHECK(std::fabs(value - reference.evaluateAt(0.0, elapsed)) <= 1e-9);
+
+	// Looking ahead carries on with the velocity, as stepping does
+	double ahead = method.evaluateAt(value, 0.5);
+
+	for( int i = 0; i < 50; i++ )
+		value = method.updateValue(value, 0.01);
+
+	OVERRATED_CHECK(std::fabs(ahead - value) <= 1e-9);
+}
+
+static void checkBatch()
+{
+	const unsigned count = 33;
+	std::vector<float> values(count), velocities(count, 0.0f), targets(count), single(count);
+	std::vector<UpdateMethodSpring<float>*> methods(count);
+
+	for( unsigned i = 0; i < count; i++ ) {
+		values[i] = single[i] = float(testRandom(100)) / 10.0f;
+		targets[i] = float(testRandom(100)) / 10.0f;
+		methods[i] = new UpdateMethodSpring<float>(50.0f, 6.0f, targets[i], 0.001f);
+	}
+
+	for( int tick = 0; tick < 200; tick++ ) {
+		UpdateMethodSpring<float>::updateBatch(&values[0], &velocities[0], &targets[0], count,
+				1.0 / 60.0, 50.0f, 6.0f, 0.001f);
+
+		for( unsigned i = 0; i < count; i++ )
+			single[i] = methods[i]->updateValue(single[i], 1.0 / 60.0);
+	}
+
+	OVERRATED_CHECK(testSameBits(values, single));
+
+	for( unsigned i = 0; i < count; i++ ) {
+		OVERRATED_CHECK(velocities[i] == methods[i]->getVelocity());
+		delete methods[i];
+	}
+}
+
+static void checkRest()
+{
+	UpdateMethodSpring<double> method(STIFFNESS, TARGET);
+	UpdatedValueBasic<double> value(0.0);
+	int ticks = 0;
+
+	OVERRATED_CHECK(!method.getIsPredictable());
+	OVERRATED_CHECK(method.timeToFinish(0.0) > 0.0);
+
+	value.setMethod(&method);
+
+	while( value.getIsUpdating() && ticks < 10000 ) {
+		value.addTime(1.0 / 60.0);
+		ticks++;
+	}
+
+	OVERRATED_CHECK(value.getValue() == TARGET && method.getVelocity() == 0.0);
+	OVERRATED_CHECK(ticks < 10000 && value.getTimeToFinish() == 0.0);
+
+	// An undamped spring never comes to rest
+	UpdateMethodSpring<double> undamped(STIFFNESS, 0.0, TARGET, 0.001);
+
+	OVERRATED_CHECK(undamped.timeToFinish(0.0) < 0.0);
+}
+
+static void checkRetarget()
+{
+	UpdateMethodSpring<double> method(STIFFNESS, TARGET);
+	double value = 0.0;
+
+	for( int i = 0; i < 10; i++ )
+		value = method.updateValue(value, 0.01);
+
+	double velocity = method.getVelocity();
+
+	OVERRATED_CHECK(velocity > 0.0);
+	method.setTargetValue(-3.0);
+	OVERRATED_CHECK(method.getVelocity() == velocity && method.getTargetValue() == -3.0);
+
+	// The velocity carries it on upwards for a moment
+	OVERRATED_CHECK(method.updateValue(value, 0.001) > value);
+}
+
+int main()
+{
+	const double dampings[] = { 2.0, 20.0, 40.0, 0.0 };	// Under, critical, over and none
+
+	for( unsigned i = 0; i < sizeof(dampings) / sizeof(dampings[0]); i++ )
+		checkDamping(dampings[i]);
+
+	checkBatch();
+	checkRest();
+	checkRetarget();
+
+	return testResult("spring_closed_form");
+}
@@ -0,0 +1,134 @@
+/**
+ *	OverRated Tests: Time scales on lists and values
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks that time scales multiply down through nested lists, that a negative scale stands
+ *	still, that a time scale eased by an UpdatedValueTimeScale slows a list down smoothly,
+ *	that a list with a scaled value still calls back in the update where it finishes, and that
+ *	a scaled value moves the same in an UpdatedValueList as in an UpdatedObjectList.
+ */
+
+#include <cmath>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<double> Value;
+typedef UpdatedObjectList<UpdatedObject> List;
+
+static void checkNested()
+{
+	List world, zone;
+	Value value(0.0);
+	UpdateMethodLinear<double> method(1.0, 100.0);
+
+	value.setMethod(&method);
+	zone.add(&value);
+	world.add(&zone);
+
+	zone.setTimeScale(0.5);
+	world.setTimeScale(0.5);
+	world.addTime(1.0);
+	OVERRATED_CHECK(value.getValue() == 0.25);
+
+	value.setTimeScale(2.0);
+	world.addTime(1.0);
+	OVERRATED_CHECK(value.getValue() == 0.75);
+
+	world.setTimeScale(-3.0);
+	OVERRATED_CHECK(world.getTimeScale() == 0.0);
+	world.addTime(1.0);
+	OVERRATED_CHECK(value.getValue() == 0.75);
+}
+
+static void checkTweened()
+{
+	List ui, world;
+	Value value(0.0);
+	UpdateMethodLinear<double> method(1.0, 100.0);
+	UpdatedValueTimeScale slowMotion(world);
+	UpdateMethodEased<double> ease(EC_LINEAR, 1.0, 0.0);
+
+	value.setMethod(&method);
+	world.add(&value);
+	slowMotion.setMethod(&ease);
+	ui.add(&slowMotion);
+
+	// The scale falls from 1 to 0 over a second, so the value moves half as far as it would
+	for( int i = 0; i < 20; i++ ) {
+		ui.addTime(0.1);
+		world.addTime(0.1);
+	}
+
+	OVERRATED_CHECK(world.getTimeScale() == 0.0 && slowMotion.getIsFinished());
+	OVERRATED_CHECK(std::fabs(value.getValue() - 0.5) < 0.1);
+
+	// Setting it directly takes effect at once
+	slowMotion.setValue(2.0);
+	world.addTime(0.5);
+	OVERRATED_CHECK(world.getTimeScale() == 2.0 && std::fabs(value.getValue() - 1.5) < 0.1);
+}
+
+static int gFinished = 0;
+static double gFinishedAt = 0.0;
+
+static void onFinished( UpdatedObject * item, void * userData )
+{
+	gFinished++;
+	gFinishedAt = static_cast<List*>(userData)->getElapsedTime();
+}
+
+static void checkCompletion()
+{
+	List list;
+	Value value(0.0);
+	UpdateMethodLinear<double> method(1.0, 1.0);
+
+	value.setMethod(&method);
+	value.setTimeScale(0.25);
+	list.add(&value);
+	list.addCompletion(&value, onFinished, &list);
+
+	for( int i = 0; i < 60; i++ )
+		list.addTime(0.1);
+
+	OVERRATED_CHECK(gFinished == 1 && std::fabs(gFinishedAt - 4.0) < 0.11);
+}
+
+static void checkValueList()
+{
+	UpdatedValueList<Value> values;
+	List objects;
+	Value a(0.0), b(0.0);
+	UpdateMethodLinear<double> method(1.0, 10.0);
+
+	a.setMethod(&method);
+	b.setMethod(&method);
+	a.setTimeScale(0.5);
+	b.setTimeScale(0.5);
+	values.add(&a);
+	objects.add(&b);
+
+	for( int i = 0; i < 5; i++ ) {
+		values.addTime(0.3);
+		objects.addTime(0.3);
+	}
+
+	OVERRATED_CHECK(a.getValue() == b.getValue() && std::fabs(a.getValue() - 0.75) < 1e-12);
+}
+
+int main()
+{
+	checkNested();
+	checkTweened();
+	checkCompletion();
+	checkValueList();
+
+	return testResult("time_scale");
+}
@@ -0,0 +1,137 @@
+/**
+ *	OverRated Tests: UpdateArena handles and reset
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Makes values and methods in an arena and updates them through a list, then checks that
+ *	objects of a type sit next to each other, that destroying one takes it out of its list and
+ *	leaves its handle stale even once the slot is reused, that reset() destroys everything and
+ *	makes every handle stale, and that destructors run exactly once whichever way an object
+ *	goes.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<float> Value;
+typedef UpdateMethodLinear<float> Method;
+
+static const int COUNT = 200;
+
+struct Point
+{
+	float x, y;
+};
+
+static int gDestroyed = 0;
+
+struct Counted
+{
+	Counted( int id ) : id(id) {}
+	~Counted() { gDestroyed++; }
+
+	int id;
+};
+
+static void checkValues()
+{
+	UpdateArena arena;
+	UpdatedObjectList<UpdatedObject> list;
+	std::vector<ArenaHandle<Value> > handles;
+
+	for( int i = 0; i < COUNT; i++ ) {
+		ArenaHandle<Method> method = arena.create<Method>(1.0f, float(i));
+		ArenaHandle<Value> value = arena.create<Value>(0.0f);
+
+		arena.get(value)->setMethod(arena.get(method));
+		list.add(arena.get(value));
+		handles.push_back(value);
+	}
+
+	// Made one after the other, so next to each other even with methods made in between
+	OVERRATED_CHECK(arena.get(handles[1]) + 1 == arena.get(handles[2]));
+	OVERRATED_CHECK(arena.getCount<Value>() == unsigned(COUNT));
+
+	list.addTime(1.0);
+	OVERRATED_CHECK(arena.get(handles[5])->getValue() == 1.0f);
+
+	// Destroyed, a value leaves its list and its handle goes stale
+	arena.destroy(handles[3]);
+	OVERRATED_CHECK(!arena.contains(handles[3]) && list.getSize() == unsigned(COUNT - 1));
+	arena.destroy(handles[3]);
+	OVERRATED_CHECK(arena.getCount<Value>() == unsigned(COUNT - 1));
+
+	// The slot is reused, but not by the old handle
+	ArenaHandle<Value> reused = arena.create<Value>(7.0f);
+
+	OVERRATED_CHECK(reused.slot == 3 && reused != handles[3]);
+	OVERRATED_CHECK(!arena.get(handles[3]) && arena.get(reused)->getValue() == 7.0f);
+
+	// Reset empties the list and leaves nothing reachable
+	arena.reset();
+	OVERRATED_CHECK(list.getSize() == 0 && arena.getCount<Value>() == 0);
+	OVERRATED_CHECK(arena.getCount<Method>() == 0);
+
+	for( int i = 0; i < COUNT; i++ )
+		OVERRATED_CHECK(!arena.contains(handles[i]));
+
+	OVERRATED_CHECK(!arena.contains(reused));
+
+	// Slots are handed out from the start again, with new generations
+	ArenaHandle<Value> fresh = arena.create<Value>(1.0f);
+
+	OVERRATED_CHECK(fresh.slot == 0 && arena.contains(fresh) && !arena.contains(handles[0]));
+	OVERRATED_CHECK(!arena.get(ArenaHandle<Value>()));
+}
+
+static void checkDestructors()
+{
+	{
+		UpdateArena arena;
+
+		for( int i = 0; i < 100; i++ )
+			arena.create<Counted>(i);
+
+		ArenaHandle<Counted> handle = arena.create<Counted>(100);
+
+		OVERRATED_CHECK(arena.get(handle)->id == 100);
+		arena.destroy(handle);
+		arena.destroy(handle);
+		OVERRATED_CHECK(gDestroyed == 1);
+
+		arena.reset();
+		OVERRATED_CHECK(gDestroyed == 101);
+
+		// Whatever's left goes with the arena
+		arena.create<Counted>(0);
+	}
+
+	OVERRATED_CHECK(gDestroyed == 102);
+
+	// Plain structs are simply forgotten
+	UpdateArena arena;
+
+	arena.reserve<Point>(1000);
+
+	ArenaHandle<Point> point = arena.create<Point>();
+
+	arena.get(point)->x = 3.0f;
+	arena.reset();
+	OVERRATED_CHECK(!arena.get(point) && arena.getCount<Point>() == 0);
+	OVERRATED_CHECK(arena.create<Point>().slot == 0);
+}
+
+int main()
+{
+	checkValues();
+	checkDestructors();
+
+	return testResult("update_arena");
+}
@@ -0,0 +1,224 @@
+/**
+ *	OverRated Tests: UpdateSchedule against updating the tree itself
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Builds two identical trees of lists, adds time to one through a schedule and to the other
+ *	directly, and checks that every value stays exactly the same while lists are paused and
+ *	rescaled, values move between lists or are deleted, and lists stop and start being
+ *	flattened. Pausing and rescaling mustn't need the tree worked out again, and values
+ *	moving between lists only need their lists brought up to date.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<double> Value;
+typedef UpdatedObjectList<UpdatedObject> List;
+
+static const int LISTS = 7;
+static const int VALUES = 300;
+static const int METHODS = 3;
+static const int TICKS = 400;
+
+// A root over three zones, the first zone holding three more lists
+struct Tree
+{
+	Tree()
+	{
+		for( int l = 0; l < LISTS; l++ )
+			lists.push_back(new List());
+
+		for( int m = 0; m < METHODS; m++ )
+			methods.push_back(new UpdateMethodLinear<double>(1.0 + m, 50.0 * m - 40.0));
+
+		root.add(lists[0]);
+		root.add(lists[1]);
+		root.add(lists[2]);
+		lists[0]->add(lists[3]);
+		lists[0]->add(lists[4]);
+		lists[4]->add(lists[5]);
+		lists[2]->add(lists[6]);
+
+		for( int v = 0; v < VALUES; v++ ) {
+			values.push_back(new Value(double(v % 17)));
+			values[v]->setMethod(methods[v % METHODS]);
+			lists[v % LISTS]->add(values[v]);
+		}
+	}
+
+	~Tree()
+	{
+		for( int v = 0; v < VALUES; v++ )
+			delete values[v];
+
+		for( int l = 0; l < LISTS; l++ )
+			delete lists[l];
+
+		for( int m = 0; m < METHODS; m++ )
+			delete methods[m];
+	}
+
+	List root;
+	std::vector<List*> lists;
+	std::vector<Value*> values;
+	std::vector<UpdateMethodLinear<double>*> methods;
+};
+
+/**
+ *  Makes the same random change to both trees
+ *
+ *  @return   Whether the change should have left the schedule's leaves as they are
+ */
+static bool change( Tree & scheduled, Tree & direct, int tick )
+{
+	int kind = testRandom(8), l = testRandom(LISTS), v = testRandom(VALUES);
+	double target = double(testRandom(200)) - 100.0;
+	Tree * trees[] = { &scheduled, &direct };
+	bool kept = true;
+
+	for( int t = 0; t < 2; t++ ) {
+		Tree & tree = *trees[t];
+		Value * value = tree.values[v];
+
+		switch( kind ) {
+			case 0:
+				tree.lists[l]->setIsPaused(!tree.lists[l]->getIsPaused());
+				break;
+			case 1:
+				tree.lists[l]->setTimeScale(0.5 * (tick % 4));
+				break;
+			case 2:
+				tree.methods[v % METHODS]->setTargetValue(target);
+				break;
+			case 3:
+				if( value ) {
+					for( int i = 0; i < LISTS; i++ )
+						tree.lists[i]->remove(value);
+
+					tree.lists[l]->add(value);
+					kept = false;
+				}
+				break;
+			case 4:
+				if( value && tick % 5 == 0 ) {
+					delete value;
+					tree.values[v] = 0;
+					kept = false;
+				}
+				break;
+			case 5:
+				if( value )
+					value->setIsPaused(!value->getIsPaused());
+				break;
+			case 6:
+				if( value )
+					value->setValue(value->getValue() - 3.0);
+				break;
+			default:
+				break;
+		}
+	}
+
+	return kept;
+}
+
+int main()
+{
+	Tree scheduled, direct;
+	UpdateSchedule schedule(&scheduled.root);
+	int mismatches = 0;
+
+	schedule.compile();
+	OVERRATED_CHECK(schedule.getNodeCount() == unsigned(LISTS + 1));
+	OVERRATED_CHECK(schedule.getLeafCount() == unsigned(VALUES));
+
+	for( int tick = 0; tick < TICKS; tick++ ) {
+		double timeElapsed = double(1 + testRandom(50)) / 1000.0;
+
+		if( change(scheduled, direct, tick) )
+			OVERRATED_CHECK(!schedule.getIsStale());
+
+		schedule.addTime(timeElapsed);
+		direct.root.addTime(timeElapsed);
+
+		// Nothing above ever needs compiling, only bringing lists up to date
+		OVERRATED_CHECK(schedule.getNodeCount() == unsigned(LISTS + 1));
+		OVERRATED_CHECK(schedule.getActiveCount() <= schedule.getLeafCount());
+
+		for( int v = 0; v < VALUES; v++ ) {
+			if( scheduled.values[v] &&
+				scheduled.values[v]->getValue() != direct.values[v]->getValue() )
+				mismatches++;
+		}
+	}
+
+	OVERRATED_CHECK(mismatches == 0);
+
+	for( int l = 0; l < LISTS; l++ ) {
+		scheduled.lists[l]->setIsPaused(false);
+		scheduled.lists[l]->setTimeScale(1.0);
+	}
+
+	// A value in two lists is only updated once
+	Value shared(0.0);
+	UpdateMethodLinear<double> method(1.0, 10.0);
+
+	shared.setMethod(&method);
+	scheduled.lists[1]->add(&shared);
+	scheduled.lists[2]->add(&shared);
+	schedule.addTime(1.0);
+	OVERRATED_CHECK(shared.getValue() == 1.0);
+
+	// Taken out of both, it is left alone
+	scheduled.lists[1]->remove(&shared);
+	scheduled.lists[2]->remove(&shared);
+	schedule.addTime(1.0);
+	OVERRATED_CHECK(shared.getValue() == 1.0);
+
+	// A list given a fixed step stops being flattened, and is flattened again without it
+	scheduled.lists[6]->setFixedStep(0.1);
+	schedule.addTime(0.0);
+	OVERRATED_CHECK(schedule.getNodeCount() == unsigned(LISTS));
+	scheduled.lists[6]->setFixedStep(0.0);
+	OVERRATED_CHECK(schedule.getIsStale());
+	schedule.addTime(0.0);
+	OVERRATED_CHECK(schedule.getNodeCount() == unsigned(LISTS + 1));
+
+	// Waking a finished value puts it back in the loop
+	Value late(0.0);
+	UpdateMethodLinear<double> lateMethod(1.0, 1.0);
+
+	late.setMethod(&lateMethod);
+	scheduled.lists[5]->add(&late);
+
+	for( int i = 0; i < 10; i++ )
+		schedule.addTime(0.5);
+
+	OVERRATED_CHECK(late.getValue() == 1.0 && late.getIsIdle());
+	lateMethod.setTargetValue(2.0);
+	schedule.addTime(0.5);
+	OVERRATED_CHECK(late.getValue() == 1.5);
+
+	// Deleted while in a list, a value is simply forgotten
+	Value * doomed = new Value(0.0);
+
+	doomed->setMethod(&lateMethod);
+	scheduled.lists[3]->add(doomed);
+	schedule.addTime(0.1);
+	unsigned leaves = schedule.getLeafCount();
+	delete doomed;
+	schedule.addTime(0.1);
+	OVERRATED_CHECK(schedule.getLeafCount() == leaves - 1);
+
+	scheduled.lists[5]->remove(&late);
+
+	return testResult("update_schedule");
+}
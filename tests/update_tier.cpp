@@ -0,0 +1,193 @@
+/**
+ *	OverRated Tests: UpdatedObjectList update tiers
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Checks, with and without a thread pool, that a tiered list updates the same share of its
+ *	items every tick, that each item is given all the time since it was last updated, that
+ *	lowering the tier gives every item the time it is owed, that an item woken part way
+ *	through its turn gets the time since it was woken, and that values in a tiered list end up
+ *	where they do in an ordinary one.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static const int COUNT = 1000;
+
+// Adds up the time it's given
+class Counter : public UpdatedObject
+{
+public:
+	Counter() : total(0.0), calls(0), idle(false) {}
+
+	bool getIsIdle() const
+	{
+		return idle;
+	}
+
+	double total;
+	unsigned calls;
+	bool idle;
+
+private:
+	void _addTime( const double & timeElapsed )
+	{
+		total += timeElapsed;
+		calls++;
+	}
+};
+
+static unsigned countCalls( const std::vector<Counter> & counters )
+{
+	unsigned calls = 0;
+
+	for( unsigned i = 0; i < counters.size(); i++ )
+		calls += counters[i].calls;
+
+	return calls;
+}
+
+static double worstError( const std::vector<Counter> & counters, double elapsed )
+{
+	double worst = 0.0;
+
+	for( unsigned i = 0; i < counters.size(); i++ )
+		worst = std::max(worst, std::fabs(counters[i].total - elapsed));
+
+	return worst;
+}
+
+static void checkTurns( ThreadPool * pool )
+{
+	std::vector<Counter> counters(COUNT);
+	UpdatedObjectList<Counter> list;
+
+	if( pool )
+		list.setParallel(pool, 16, 8);
+
+	for( int i = 0; i < COUNT; i++ )
+		list.add(&counters[i]);
+
+	// A quarter of the items each tick, with uneven ticks
+	list.setUpdateTier(2);
+
+	for( int tick = 0; tick < 40; tick++ ) {
+		unsigned before = countCalls(counters);
+
+		list.addTime(0.01 * (1 + tick % 3));
+		OVERRATED_CHECK(countCalls(counters) - before == unsigned(COUNT / 4));
+	}
+
+	// Nobody is owed more than the three ticks since their last turn
+	for( int i = 0; i < COUNT; i++ )
+		OVERRATED_CHECK(counters[i].calls == 10);
+
+	OVERRATED_CHECK(worstError(counters, list.getElapsedTime()) < 0.09);
+
+	// Part way through a turn, dropping the tier catches everyone up at once
+	list.addTime(0.01);
+	list.addTime(0.02);
+	list.setUpdateTier(0);
+	list.addTime(0.005);
+	OVERRATED_CHECK(worstError(counters, list.getElapsedTime()) < 1e-12);
+
+	unsigned before = countCalls(counters);
+
+	list.addTime(0.03);
+	OVERRATED_CHECK(countCalls(counters) - before == unsigned(COUNT));
+
+	// An idle item gets nothing for the time it was idle
+	Counter & sleeper = counters[5];
+
+	list.setUpdateTier(3);
+	sleeper.idle = true;
+
+	for( int tick = 0; tick < 8; tick++ )
+		list.addTime(0.01);
+
+	double slept = sleeper.total;
+
+	OVERRATED_CHECK(list.getActiveCount() == unsigned(COUNT - 1));
+
+	for( int tick = 0; tick < 3; tick++ )
+		list.addTime(0.01);
+
+	sleeper.idle = false;
+	sleeper.wake();
+
+	for( int tick = 0; tick < 8; tick++ )
+		list.addTime(0.01);
+
+	list.setUpdateTier(0);
+	list.addTime(0.01);
+	OVERRATED_CHECK(std::fabs(sleeper.total - slept - 0.09) < 1e-12);
+}
+
+static void checkValues()
+{
+	typedef UpdatedValueBasic<float> Value;
+
+	UpdatedObjectList<Value> plain, tiered;
+	std::vector<Value*> plainValues, tieredValues;
+	UpdateMethodLinear<float> method(1.0f, 5.0f);
+
+	tiered.setUpdateTier(3);
+
+	for( int i = 0; i < 100; i++ ) {
+		plainValues.push_back(new Value(0.0f));
+		tieredValues.push_back(new Value(0.0f));
+		plainValues[i]->setMethod(&method);
+		tieredValues[i]->setMethod(&method);
+		plain.add(plainValues[i]);
+		tiered.add(tieredValues[i]);
+	}
+
+	for( int tick = 0; tick < 60; tick++ ) {
+		plain.addTime(0.05);
+		tiered.addTime(0.05);
+	}
+
+	tiered.setUpdateTier(0);
+	plain.addTime(0.05);
+	tiered.addTime(0.05);
+
+	for( int i = 0; i < 100; i++ ) {
+		float difference = plainValues[i]->getValue() - tieredValues[i]->getValue();
+
+		OVERRATED_CHECK(std::fabs(difference) < 1e-5f);
+	}
+
+	// Once everything arrives, a tiered list goes idle like any other
+	tiered.setUpdateTier(3);
+
+	for( int tick = 0; tick < 200; tick++ )
+		tiered.addTime(0.05);
+
+	OVERRATED_CHECK(tiered.getIsIdle());
+
+	for( int i = 0; i < 100; i++ ) {
+		delete plainValues[i];
+		delete tieredValues[i];
+	}
+}
+
+int main()
+{
+	ThreadPool pool(3);
+
+	checkTurns(0);
+	checkTurns(&pool);
+	checkValues();
+
+	return testResult("update_tier");
+}
@@ -0,0 +1,139 @@
+/**
+ *	OverRated Tests: UpdatedValueList against UpdatedObjectList
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Drives two identical sets of values, one through an UpdatedValueList and one through an
+ *	UpdatedObjectList, and checks that they stay exactly the same through method changes,
+ *	pauses, fixed steps, removals, deletions and retargets.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+typedef UpdatedValueBasic<float> Value;
+
+static const int COUNT = 500;
+static const int TICKS = 300;
+
+int main()
+{
+	gSeed = 3;
+
+	UpdateMethodLinear<float> linear(1.5f, 10.0f);
+	UpdateMethodLinear<float> falling(0.7f, CD_DECREASING);
+	UpdateMethodLooped<float> looped(2.0f, 1.0f, 0.0f, 6.0f);
+	UpdateMethodLooped<float> forced(1.0f, 5.0f, CD_INCREASING, 0.0f, 6.0f);
+	UpdateMethodLooped<float> spinning(3.0f, CD_INCREASING, 0.0f, 6.0f);
+	UpdateMethod<float> * methods[] = { &linear, &falling, &looped, &forced, &spinning, 0 };
+	const int methodCount = sizeof(methods) / sizeof(methods[0]);
+
+	std::vector<Value*> grouped, plain;
+	UpdatedValueList<Value> valueList;
+	UpdatedObjectList<UpdatedObject> objectList;
+
+	for( int i = 0; i < COUNT; i++ ) {
+		float start = float(testRandom(600)) / 100.0f;
+
+		grouped.push_back(new Value(start));
+		plain.push_back(new Value(start));
+		grouped[i]->setMethod(methods[i % methodCount]);
+		plain[i]->setMethod(methods[i % methodCount]);
+		valueList.add(grouped[i]);
+		objectList.add(plain[i]);
+
+		if( i % 17 == 0 ) {
+			grouped[i]->setIsPaused(true);
+			plain[i]->setIsPaused(true);
+		}
+
+		if( i % 23 == 0 ) {
+			grouped[i]->setFixedStep(0.05);
+			plain[i]->setFixedStep(0.05);
+		}
+	}
+
+	// Eased methods keep per value state, so each value gets its own
+	UpdateMethodEased<float> easedA(EC_QUAD_IN_OUT, 2.0, 3.0f), easedB(EC_QUAD_IN_OUT, 2.0, 3.0f);
+	Value easeGrouped(0.0f), easePlain(0.0f);
+
+	easeGrouped.setMethod(&easedA);
+	easePlain.setMethod(&easedB);
+	valueList.add(&easeGrouped);
+	objectList.add(&easePlain);
+
+	int mismatches = 0;
+
+	for( int tick = 0; tick < TICKS; tick++ ) {
+		double timeElapsed = double(testRandom(100)) / 3000.0;
+
+		valueList.addTime(timeElapsed);
+		objectList.addTime(timeElapsed);
+
+		if( tick == 50 ) {
+			for( int i = 0; i < COUNT; i += 7 ) {
+				grouped[i]->setMethod(methods[(i / 7) % methodCount]);
+				plain[i]->setMethod(methods[(i / 7) % methodCount]);
+			}
+		}
+		else if( tick == 80 ) {
+			delete grouped[3];
+			delete plain[3];
+			grouped[3] = plain[3] = 0;
+			valueList.remove(grouped[4]);
+			objectList.remove(plain[4]);
+		}
+		else if( tick == 120 ) {
+			for( int i = 0; i < COUNT; i += 17 ) {
+				if( grouped[i] ) {
+					grouped[i]->setIsPaused(false);
+					plain[i]->setIsPaused(false);
+				}
+			}
+
+			linear.setTargetValue(2.0f);
+		}
+
+		for( int i = 0; i < COUNT; i++ ) {
+			if( grouped[i] && grouped[i]->getValue() != plain[i]->getValue() )
+				mismatches++;
+		}
+
+		OVERRATED_CHECK(easeGrouped.getValue() == easePlain.getValue());
+	}
+
+	OVERRATED_CHECK(mismatches == 0);
+	OVERRATED_CHECK(valueList.getSize() == unsigned(COUNT - 1));
+
+	// Finished values let the list report idle, and a retarget wakes it again
+	UpdatedValueList<Value> idleList;
+	UpdateMethodLinear<float> method(1.0f, 1.0f);
+	Value value(0.0f);
+
+	value.setMethod(&method);
+	Handle handle = idleList.add(&value);
+	idleList.addTime(2.0);
+	idleList.addTime(0.0);
+	OVERRATED_CHECK(idleList.getIsIdle());
+
+	value.setTargetValue(3.0f);
+	OVERRATED_CHECK(!idleList.getIsIdle());
+	OVERRATED_CHECK(idleList.getItem(handle) == &value);
+
+	idleList.remove(handle);
+	OVERRATED_CHECK(!idleList.getItem(handle) && !idleList.getSize());
+
+	for( int i = 0; i < COUNT; i++ ) {
+		delete grouped[i];
+		delete plain[i];
+	}
+
+	return testResult("value_list_equivalence");
+}
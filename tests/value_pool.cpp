@@ -0,0 +1,166 @@
+/**
+ *	OverRated Tests: UpdatedValuePool against UpdatedValueBasic
+ *
+ *	@author  	Joseph Austin ( joseph.the.austin@gmail.com )
+ *
+ *	@license	The tests are released in the public domain, which shall not extend to the actual
+ *				OverRated library. OverRated is released under the liberal but more specific MIT
+ *				license, as is detailed in each of its headers.
+ *
+ *	Steps values in a pool alongside equivalent UpdatedValueBasic's, with every kind of linear
+ *	and looped target, and checks that they stay bit for bit the same through pauses and
+ *	removals; then checks that the pool goes idle once its values arrive and wakes again when
+ *	given something to do.
+ */
+
+#include <vector>
+#include <OverRated.h>
+#include "OVRTest.h"
+
+using namespace OverRated;
+
+static const int COUNT = 400;
+static const int TICKS = 60;
+
+template <typename T>
+static UpdateMethod<T> * randomMethod( UpdatedValuePool<T> & pool, unsigned index )
+{
+	T rate = T(testRandom(500)) / T(10);
+	T target = T(testRandom(3600)) / T(10);
+	ConstDirection dir = testRandom(2) ? CD_INCREASING : CD_DECREASING;
+
+	switch( testRandom(5) ) {
+		case 0: {
+			UpdateMethodLinear<T> * method = new UpdateMethodLinear<T>(rate, target);
+			pool.setMethod(index, *method);
+			return method;
+		}
+		case 1: {
+			UpdateMethodLinear<T> * method = new UpdateMethodLinear<T>(rate, dir);
+			pool.setMethod(index, *method);
+			return method;
+		}
+		case 2: {
+			UpdateMethodLooped<T> * method =
+					new UpdateMethodLooped<T>(rate, target, T(0), T(360));
+			pool.setMethod(index, *method);
+			return method;
+		}
+		case 3: {
+			UpdateMethodLooped<T> * method =
+					new UpdateMethodLooped<T>(rate, target, dir, T(0), T(360));
+			pool.setMethod(index, *method);
+			return method;
+		}
+		default: {
+			UpdateMethodLooped<T> * method = new UpdateMethodLooped<T>(rate, dir, T(0), T(360));
+			pool.setMethod(index, *method);
+			return method;
+		}
+	}
+}
+
+template <typename T>
+static void checkEquivalence()
+{
+	UpdatedValuePool<T> pool;
+	std::vector<UpdatedValueBasic<T>*> values;
+	std::vector<UpdateMethod<T>*> methods;
+
+	for( int i = 0; i < COUNT; i++ ) {
+		T start = T(testRandom(7200)) / T(10) - T(200);
+		unsigned index = pool.add(start);
+
+		values.push_back(new UpdatedValueBasic<T>(start));
+		methods.push_back(randomMethod(pool, index));
+		values[i]->setMethod(methods[i]);
+	}
+
+	for( int tick = 0; tick < TICKS; tick++ ) {
+		double timeElapsed = double(testRandom(1000)) / 300.0;
+
+		if( tick == 20 ) {
+			for( int i = 0; i < COUNT; i += 9 ) {
+				pool.setIsPaused(i, true);
+				values[i]->setIsPaused(true);
+			}
+		}
+		else if( tick == 40 ) {
+			// The last value takes the place of the one removed
+			pool.remove(3);
+			delete values[3];
+			delete methods[3];
+			values[3] = values.back();
+			methods[3] = methods.back();
+			values.pop_back();
+			methods.pop_back();
+		}
+
+		pool.addTime(timeElapsed);
+
+		for( unsigned i = 0; i < values.size(); i++ )
+			values[i]->addTime(timeElapsed);
+
+		std::vector<T> pooled(pool.getValues(), pool.getValues() + pool.getSize());
+		std::vector<T> single;
+
+		for( unsigned i = 0; i < values.size(); i++ )
+			single.push_back(values[i]->getValue());
+
+		OVERRATED_CHECK(testSameBits(pooled, single));
+	}
+
+	for( unsigned i = 0; i < values.size(); i++ ) {
+		OVERRATED_CHECK(pool.getIsPaused(i) == values[i]->getIsPaused());
+		delete values[i];
+		delete methods[i];
+	}
+}
+
+static void checkIdle()
+{
+	UpdatedValuePool<float> pool;
+	UpdatedObjectList<UpdatedObject> list;
+	UpdateMethodLinear<float> method(2.0f, 4.0f);
+
+	unsigned first = pool.add(0.0f);
+	unsigned second = pool.add(1.0f);
+
+	OVERRATED_CHECK(pool.getIsIdle());
+	pool.setMethod(first, method);
+	pool.setMethod(second, method);
+	OVERRATED_CHECK(!pool.getIsIdle() && pool.getIsUpdating(first));
+
+	list.add(&pool);
+	list.addTime(1.0);
+	OVERRATED_CHECK(pool.getValue(first) == 2.0f && pool.getValue(second) == 3.0f);
+	list.addTime(1.0);
+	OVERRATED_CHECK(pool.getIsIdle() && list.getIsIdle() && !pool.getIsUpdating(second));
+
+	// Moving a value away from its target wakes the pool and the list
+	pool.setValue(first, 1.0f);
+	OVERRATED_CHECK(!pool.getIsIdle() && !list.getIsIdle());
+	list.addTime(1.0);
+	OVERRATED_CHECK(pool.getValue(first) == 3.0f);
+
+	// Pausing the only moving value leaves nothing to do
+	pool.setIsPaused(first, true);
+	list.addTime(1.0);
+	OVERRATED_CHECK(pool.getValue(first) == 3.0f && pool.getIsIdle());
+	pool.setIsPaused(first, false);
+	list.addTime(1.0);
+	OVERRATED_CHECK(pool.getValue(first) == 4.0f);
+
+	pool.clear();
+	OVERRATED_CHECK(pool.getSize() == 0 && pool.getValues() == 0);
+}
+
+int main()
+{
+	checkEquivalence<float>();
+	checkEquivalence<double>();
+	checkEquivalence<int>();
+	checkIdle();
+
+	return testResult("value_pool");
+}